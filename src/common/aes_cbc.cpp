@@ -0,0 +1,284 @@
+// SPDX-FileCopyrightText: Copyright 2025 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <bit>
+#include <cstring>
+
+#include "common/aes.h"
+#include "common/aes_cbc.h"
+#include "common/arch.h"
+
+#ifdef ARCH_X86_64
+#include <immintrin.h>
+#include <xbyak/xbyak_util.h>
+#elif defined(ARCH_ARM64) && (defined(__ARM_FEATURE_AES) || defined(__ARM_FEATURE_CRYPTO))
+#define AES_CBC_USE_ARM_CRYPTO
+#include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#define AES_TARGET(features)
+#else
+#define AES_TARGET(features) __attribute__((target(features)))
+#endif
+
+namespace Common {
+
+namespace {
+
+constexpr size_t BlockSize = 16;
+constexpr u32 NumRounds = 10; // AES-128
+
+void DecryptSoftware(std::span<const u8, 16> key, std::span<const u8, 16> iv,
+                     std::span<const u8> data, std::span<u8> decrypted) {
+    aes::decrypt_cbc(data.data(), data.size(), key.data(), key.size(), iv.data(),
+                     decrypted.data(), decrypted.size(), nullptr);
+}
+
+#ifdef ARCH_X86_64
+
+struct DecryptKeys {
+    __m128i keys[NumRounds + 1];
+
+    const __m128i& operator[](u32 round) const {
+        return keys[round];
+    }
+    __m128i& operator[](u32 round) {
+        return keys[round];
+    }
+};
+
+template <int rcon>
+AES_TARGET("aes") __m128i ExpandKeyStep(__m128i key) {
+    __m128i assist = _mm_aeskeygenassist_si128(key, rcon);
+    assist = _mm_shuffle_epi32(assist, _MM_SHUFFLE(3, 3, 3, 3));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    return _mm_xor_si128(key, assist);
+}
+
+AES_TARGET("aes") DecryptKeys ExpandDecryptKeys(std::span<const u8, 16> key) {
+    __m128i ek[NumRounds + 1];
+    ek[0] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key.data()));
+    ek[1] = ExpandKeyStep<0x01>(ek[0]);
+    ek[2] = ExpandKeyStep<0x02>(ek[1]);
+    ek[3] = ExpandKeyStep<0x04>(ek[2]);
+    ek[4] = ExpandKeyStep<0x08>(ek[3]);
+    ek[5] = ExpandKeyStep<0x10>(ek[4]);
+    ek[6] = ExpandKeyStep<0x20>(ek[5]);
+    ek[7] = ExpandKeyStep<0x40>(ek[6]);
+    ek[8] = ExpandKeyStep<0x80>(ek[7]);
+    ek[9] = ExpandKeyStep<0x1B>(ek[8]);
+    ek[10] = ExpandKeyStep<0x36>(ek[9]);
+
+    // Equivalent inverse cipher: reversed schedule with InvMixColumns on the inner round keys
+    DecryptKeys dk;
+    dk[0] = ek[NumRounds];
+    for (u32 i = 1; i < NumRounds; i++) {
+        dk[i] = _mm_aesimc_si128(ek[NumRounds - i]);
+    }
+    dk[NumRounds] = ek[0];
+    return dk;
+}
+
+AES_TARGET("aes") __m128i DecryptBlock(__m128i block, const DecryptKeys& dk) {
+    block = _mm_xor_si128(block, dk[0]);
+    for (u32 r = 1; r < NumRounds; r++) {
+        block = _mm_aesdec_si128(block, dk[r]);
+    }
+    return _mm_aesdeclast_si128(block, dk[NumRounds]);
+}
+
+AES_TARGET("aes")
+void DecryptAesNi(std::span<const u8, 16> key, std::span<const u8, 16> iv,
+                  std::span<const u8> data, std::span<u8> decrypted) {
+    const DecryptKeys dk = ExpandDecryptKeys(key);
+    const size_t num_blocks = data.size() / BlockSize;
+    const auto* in = reinterpret_cast<const __m128i*>(data.data());
+    auto* out = reinterpret_cast<__m128i*>(decrypted.data());
+
+    // Blocks do not depend on each other when decrypting, so interleave four of them to hide
+    // the latency of aesdec.
+    __m128i prev = _mm_loadu_si128(reinterpret_cast<const __m128i*>(iv.data()));
+    size_t i = 0;
+    for (; i + 4 <= num_blocks; i += 4) {
+        __m128i cipher[4];
+        __m128i x[4];
+        for (u32 j = 0; j < 4; j++) {
+            cipher[j] = _mm_loadu_si128(in + i + j);
+            x[j] = _mm_xor_si128(cipher[j], dk[0]);
+        }
+        for (u32 r = 1; r < NumRounds; r++) {
+            for (u32 j = 0; j < 4; j++) {
+                x[j] = _mm_aesdec_si128(x[j], dk[r]);
+            }
+        }
+        for (u32 j = 0; j < 4; j++) {
+            x[j] = _mm_aesdeclast_si128(x[j], dk[NumRounds]);
+        }
+        _mm_storeu_si128(out + i, _mm_xor_si128(x[0], prev));
+        for (u32 j = 1; j < 4; j++) {
+            _mm_storeu_si128(out + i + j, _mm_xor_si128(x[j], cipher[j - 1]));
+        }
+        prev = cipher[3];
+    }
+    for (; i < num_blocks; i++) {
+        const __m128i cipher = _mm_loadu_si128(in + i);
+        _mm_storeu_si128(out + i, _mm_xor_si128(DecryptBlock(cipher, dk), prev));
+        prev = cipher;
+    }
+}
+
+AES_TARGET("aes,vaes,avx2")
+void DecryptVaes(std::span<const u8, 16> key, std::span<const u8, 16> iv,
+                 std::span<const u8> data, std::span<u8> decrypted) {
+    const DecryptKeys dk = ExpandDecryptKeys(key);
+    __m256i dk256[NumRounds + 1];
+    for (u32 r = 0; r <= NumRounds; r++) {
+        dk256[r] = _mm256_broadcastsi128_si256(dk[r]);
+    }
+    const size_t num_blocks = data.size() / BlockSize;
+    const u8* in = data.data();
+    u8* out = decrypted.data();
+    const auto load128 = [&](size_t block) {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + block * BlockSize));
+    };
+
+    // The first block chains with the IV. Every later block chains with the ciphertext right
+    // before it, so two block pairs can be loaded with a one block offset.
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out),
+                     _mm_xor_si128(DecryptBlock(load128(0), dk),
+                                   _mm_loadu_si128(reinterpret_cast<const __m128i*>(iv.data()))));
+    size_t i = 1;
+    for (; i + 8 <= num_blocks; i += 8) {
+        __m256i prev[4];
+        __m256i x[4];
+        for (u32 j = 0; j < 4; j++) {
+            const u8* src = in + (i + j * 2) * BlockSize;
+            prev[j] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src - BlockSize));
+            x[j] = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src)),
+                                    dk256[0]);
+        }
+        for (u32 r = 1; r < NumRounds; r++) {
+            for (u32 j = 0; j < 4; j++) {
+                x[j] = _mm256_aesdec_epi128(x[j], dk256[r]);
+            }
+        }
+        for (u32 j = 0; j < 4; j++) {
+            x[j] = _mm256_aesdeclast_epi128(x[j], dk256[NumRounds]);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + (i + j * 2) * BlockSize),
+                                _mm256_xor_si256(x[j], prev[j]));
+        }
+    }
+    for (; i < num_blocks; i++) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * BlockSize),
+                         _mm_xor_si128(DecryptBlock(load128(i), dk), load128(i - 1)));
+    }
+}
+
+#endif // ARCH_X86_64
+
+#ifdef AES_CBC_USE_ARM_CRYPTO
+
+using DecryptKeys = std::array<uint8x16_t, NumRounds + 1>;
+
+u32 SubWord(u32 word) {
+    // With the word repeated in every column ShiftRows is a no-op, leaving only SubBytes
+    const uint8x16_t state = vaeseq_u8(vreinterpretq_u8_u32(vdupq_n_u32(word)), vdupq_n_u8(0));
+    return vgetq_lane_u32(vreinterpretq_u32_u8(state), 0);
+}
+
+DecryptKeys ExpandDecryptKeys(std::span<const u8, 16> key) {
+    static constexpr std::array<u8, NumRounds> rcon{0x01, 0x02, 0x04, 0x08, 0x10,
+                                                    0x20, 0x40, 0x80, 0x1B, 0x36};
+    std::array<u32, (NumRounds + 1) * 4> w;
+    std::memcpy(w.data(), key.data(), key.size());
+    for (u32 i = 4; i < w.size(); i++) {
+        u32 temp = w[i - 1];
+        if (i % 4 == 0) {
+            temp = SubWord(std::rotr(temp, 8)) ^ rcon[i / 4 - 1];
+        }
+        w[i] = w[i - 4] ^ temp;
+    }
+
+    DecryptKeys dk;
+    const auto round_key = [&](u32 r) { return vld1q_u8(reinterpret_cast<const u8*>(&w[r * 4])); };
+    dk[0] = round_key(NumRounds);
+    for (u32 i = 1; i < NumRounds; i++) {
+        dk[i] = vaesimcq_u8(round_key(NumRounds - i));
+    }
+    dk[NumRounds] = round_key(0);
+    return dk;
+}
+
+void DecryptArmCrypto(std::span<const u8, 16> key, std::span<const u8, 16> iv,
+                      std::span<const u8> data, std::span<u8> decrypted) {
+    const DecryptKeys dk = ExpandDecryptKeys(key);
+    const size_t num_blocks = data.size() / BlockSize;
+    uint8x16_t prev = vld1q_u8(iv.data());
+    for (size_t i = 0; i < num_blocks; i++) {
+        const uint8x16_t cipher = vld1q_u8(data.data() + i * BlockSize);
+        uint8x16_t x = cipher;
+        for (u32 r = 0; r < NumRounds - 1; r++) {
+            x = vaesimcq_u8(vaesdq_u8(x, dk[r]));
+        }
+        x = veorq_u8(vaesdq_u8(x, dk[NumRounds - 1]), dk[NumRounds]);
+        vst1q_u8(decrypted.data() + i * BlockSize, veorq_u8(x, prev));
+        prev = cipher;
+    }
+}
+
+#endif // AES_CBC_USE_ARM_CRYPTO
+
+AesBackend DetectAesBackend() {
+#ifdef ARCH_X86_64
+    using Xbyak::util::Cpu;
+    const Cpu cpu;
+    if (cpu.has(Cpu::tVAES) && cpu.has(Cpu::tAVX2) && cpu.has(Cpu::tAESNI)) {
+        return AesBackend::Vaes;
+    }
+    if (cpu.has(Cpu::tAESNI)) {
+        return AesBackend::AesNi;
+    }
+#elif defined(AES_CBC_USE_ARM_CRYPTO)
+    return AesBackend::ArmCrypto;
+#endif
+    return AesBackend::Software;
+}
+
+} // Anonymous namespace
+
+AesBackend GetAesBackend() {
+    static const AesBackend backend = DetectAesBackend();
+    return backend;
+}
+
+void AesCbcDecrypt128(std::span<const u8, 16> key, std::span<const u8, 16> iv,
+                      std::span<const u8> data, std::span<u8> decrypted) {
+    if (data.empty() || data.size() % BlockSize != 0 || decrypted.size() != data.size()) {
+        DecryptSoftware(key, iv, data, decrypted);
+        return;
+    }
+    switch (GetAesBackend()) {
+#ifdef ARCH_X86_64
+    case AesBackend::Vaes:
+        DecryptVaes(key, iv, data, decrypted);
+        return;
+    case AesBackend::AesNi:
+        DecryptAesNi(key, iv, data, decrypted);
+        return;
+#endif
+#ifdef AES_CBC_USE_ARM_CRYPTO
+    case AesBackend::ArmCrypto:
+        DecryptArmCrypto(key, iv, data, decrypted);
+        return;
+#endif
+    default:
+        DecryptSoftware(key, iv, data, decrypted);
+        return;
+    }
+}
+
+} // namespace Common
@@ -0,0 +1,29 @@
+// SPDX-FileCopyrightText: Copyright 2025 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <span>
+
+#include "common/types.h"
+
+namespace Common {
+
+enum class AesBackend : u32 {
+    Software, ///< Table driven implementation in aes.h
+    AesNi,
+    Vaes,
+    ArmCrypto,
+};
+
+/// Returns the AES backend picked for this host. It is detected once on first use.
+AesBackend GetAesBackend();
+
+/// Decrypts AES-128-CBC data without touching padding, with the same output as
+/// aes::decrypt_cbc when no padded size is requested. The buffers must not overlap. Input that
+/// is not a non-zero multiple of the block size, or a decrypted buffer of a different size, is
+/// passed to the software implementation unchanged.
+void AesCbcDecrypt128(std::span<const u8, 16> key, std::span<const u8, 16> iv,
+                      std::span<const u8> data, std::span<u8> decrypted);
+
+} // namespace Common
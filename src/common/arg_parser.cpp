@@ -40,6 +40,8 @@ void ArgParser::PrintHelp() const {
               << "  --config-global               Run the emulator with the base config file "
               << "only, ignores game specific configs.\n"
               << "  --show-fps                    Enable FPS counter display at startup\n"
+              << "  --shader-service <socket>     Run as a shader cache service for other "
+              << "emulator instances instead of launching a game.\n"
               << "  -h, --help                    Display this help message\n";
 }
 
@@ -133,6 +135,11 @@ void ArgParser::RegisterArguments() {
         // Will be handled in Parse()
     };
 
+    // Shader service
+    arg_map["--shader-service"] = [this](int& i) {
+        // Will be handled in Parse()
+    };
+
     // Show FPS
     arg_map["--show-fps"] = [](int&) {
         Config::setShowFpsCounter(true);
@@ -260,6 +267,15 @@ ArgParser::ParsedArgs ArgParser::Parse(int argc, char* argv[]) {
             continue;
         }
 
+        if (cur_arg == "--shader-service") {
+            if (++i >= argc) {
+                std::cerr << "Error: Missing argument for --shader-service\n";
+                exit(1);
+            }
+            result.shader_service_socket = argv[i];
+            continue;
+        }
+
         // Handle arguments registered in the map
         auto it = arg_map.find(cur_arg);
         if (it != arg_map.end() && cur_arg != "-h" && cur_arg != "--help") {
@@ -32,6 +32,7 @@ public:
         std::optional<std::filesystem::path> game_folder;
         bool wait_for_debugger = false;
         std::optional<int> wait_pid;
+        std::optional<std::string> shader_service_socket;
     };
 
     ArgParser();
@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2025 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <fstream>
 #include <optional>
 #include <string>
@@ -142,6 +143,8 @@ static ConfigEntry<string> userName("shadPS4");
 static ConfigEntry<bool> isShowSplash(false);
 static ConfigEntry<string> isSideTrophy("right");
 static ConfigEntry<bool> isConnectedToNetwork(false);
+static ConfigEntry<u32> avPlayerReadAhead(16);
+static ConfigEntry<bool> hostLibcStrings(false);
 static bool enableDiscordRPC = false;
 static std::filesystem::path sys_modules_path = {};
 
@@ -159,6 +162,7 @@ static ConfigEntry<bool> backgroundControllerInput(false);
 static ConfigEntry<string> micDevice("Default Device");
 static ConfigEntry<string> mainOutputDevice("Default Device");
 static ConfigEntry<string> padSpkOutputDevice("Default Device");
+static ConfigEntry<string> audioBackend("SDL");
 
 // GPU
 static ConfigEntry<u32> windowWidth(1280);
@@ -167,6 +171,7 @@ static ConfigEntry<u32> internalScreenWidth(1280);
 static ConfigEntry<u32> internalScreenHeight(720);
 static ConfigEntry<bool> isNullGpu(false);
 static ConfigEntry<bool> shouldCopyGPUBuffers(false);
+static ConfigEntry<u32> gpuFramesInFlight(1);
 static ConfigEntry<bool> readbacksEnabled(false);
 static ConfigEntry<bool> readbackLinearImagesEnabled(false);
 static ConfigEntry<bool> directMemoryAccessEnabled(false);
@@ -193,10 +198,12 @@ static ConfigEntry<bool> vkGuestMarkers(false);
 static ConfigEntry<bool> rdocEnable(false);
 static ConfigEntry<bool> pipelineCacheEnable(false);
 static ConfigEntry<bool> pipelineCacheArchive(false);
+static ConfigEntry<string> shaderServiceSocket("");
 
 // Debug
 static ConfigEntry<bool> isDebugDump(false);
 static ConfigEntry<bool> isShaderDebug(false);
+static ConfigEntry<u32> guestProfilerFrequency(0);
 static ConfigEntry<bool> isSeparateLogFilesEnabled(false);
 static ConfigEntry<bool> showFpsCounter(false);
 static ConfigEntry<bool> logEnabled(true);
@@ -348,6 +355,10 @@ std::string getPadSpkOutputDevice() {
     return padSpkOutputDevice.get();
 }
 
+std::string getAudioBackend() {
+    return audioBackend.get();
+}
+
 double getTrophyNotificationDuration() {
     return trophyNotificationDuration.get();
 }
@@ -404,6 +415,10 @@ bool collectShadersForDebug() {
     return isShaderDebug.get();
 }
 
+u32 getGuestProfilerFrequency() {
+    return guestProfilerFrequency.get();
+}
+
 bool showSplash() {
     return isShowSplash.get();
 }
@@ -420,6 +435,10 @@ bool copyGPUCmdBuffers() {
     return shouldCopyGPUBuffers.get();
 }
 
+u32 getGpuFramesInFlight() {
+    return std::clamp(gpuFramesInFlight.get(), 1u, MaxGpuFramesInFlight);
+}
+
 bool readbacks() {
     return readbacksEnabled.get();
 }
@@ -452,6 +471,10 @@ bool isPipelineCacheArchived() {
     return pipelineCacheArchive.get();
 }
 
+std::string getShaderServiceSocket() {
+    return shaderServiceSocket.get();
+}
+
 bool getShowFpsCounter() {
     return showFpsCounter.get();
 }
@@ -519,6 +542,22 @@ void setConnectedToNetwork(bool enable, bool is_game_specific) {
     isConnectedToNetwork.set(enable, is_game_specific);
 }
 
+u32 getAvPlayerReadAhead() {
+    return avPlayerReadAhead.get();
+}
+
+void setAvPlayerReadAhead(u32 chunks, bool is_game_specific) {
+    avPlayerReadAhead.set(chunks, is_game_specific);
+}
+
+bool getHostLibcStrings() {
+    return hostLibcStrings.get();
+}
+
+void setHostLibcStrings(bool enable, bool is_game_specific) {
+    hostLibcStrings.set(enable, is_game_specific);
+}
+
 void setGpuId(s32 selectedGpuId, bool is_game_specific) {
     gpuId.set(selectedGpuId, is_game_specific);
 }
@@ -551,6 +590,10 @@ void setCollectShaderForDebug(bool enable, bool is_game_specific) {
     isShaderDebug.set(enable, is_game_specific);
 }
 
+void setGuestProfilerFrequency(u32 frequency, bool is_game_specific) {
+    guestProfilerFrequency.set(frequency, is_game_specific);
+}
+
 void setShowSplash(bool enable, bool is_game_specific) {
     isShowSplash.set(enable, is_game_specific);
 }
@@ -571,6 +614,10 @@ void setCopyGPUCmdBuffers(bool enable, bool is_game_specific) {
     shouldCopyGPUBuffers.set(enable, is_game_specific);
 }
 
+void setGpuFramesInFlight(u32 value, bool is_game_specific) {
+    gpuFramesInFlight.set(value, is_game_specific);
+}
+
 void setReadbacks(bool enable, bool is_game_specific) {
     readbacksEnabled.set(enable, is_game_specific);
 }
@@ -615,6 +662,10 @@ void setPipelineCacheArchived(bool enable, bool is_game_specific) {
     pipelineCacheArchive.set(enable, is_game_specific);
 }
 
+void setShaderServiceSocket(std::string path, bool is_game_specific) {
+    shaderServiceSocket.set(path, is_game_specific);
+}
+
 void setVblankFreq(u32 value, bool is_game_specific) {
     vblankFrequency.set(value, is_game_specific);
 }
@@ -659,6 +710,10 @@ void setPadSpkOutputDevice(std::string device, bool is_game_specific) {
     padSpkOutputDevice.set(device, is_game_specific);
 }
 
+void setAudioBackend(std::string backend, bool is_game_specific) {
+    audioBackend.set(backend, is_game_specific);
+}
+
 void setTrophyNotificationDuration(double newTrophyNotificationDuration, bool is_game_specific) {
     trophyNotificationDuration.set(newTrophyNotificationDuration, is_game_specific);
 }
@@ -883,6 +938,8 @@ void load(const std::filesystem::path& path, bool is_game_specific) {
         isSideTrophy.setFromToml(general, "sideTrophy", is_game_specific);
 
         isConnectedToNetwork.setFromToml(general, "isConnectedToNetwork", is_game_specific);
+        avPlayerReadAhead.setFromToml(general, "avPlayerReadAhead", is_game_specific);
+        hostLibcStrings.setFromToml(general, "hostLibcStrings", is_game_specific);
         defaultControllerID.setFromToml(general, "defaultControllerID", is_game_specific);
         sys_modules_path = toml::find_fs_path_or(general, "sysModulesPath", sys_modules_path);
     }
@@ -906,6 +963,7 @@ void load(const std::filesystem::path& path, bool is_game_specific) {
         micDevice.setFromToml(audio, "micDevice", is_game_specific);
         mainOutputDevice.setFromToml(audio, "mainOutputDevice", is_game_specific);
         padSpkOutputDevice.setFromToml(audio, "padSpkOutputDevice", is_game_specific);
+        audioBackend.setFromToml(audio, "backend", is_game_specific);
     }
 
     if (data.contains("GPU")) {
@@ -917,6 +975,7 @@ void load(const std::filesystem::path& path, bool is_game_specific) {
         internalScreenHeight.setFromToml(gpu, "internalScreenHeight", is_game_specific);
         isNullGpu.setFromToml(gpu, "nullGpu", is_game_specific);
         shouldCopyGPUBuffers.setFromToml(gpu, "copyGPUBuffers", is_game_specific);
+        gpuFramesInFlight.setFromToml(gpu, "framesInFlight", is_game_specific);
         readbacksEnabled.setFromToml(gpu, "readbacks", is_game_specific);
         readbackLinearImagesEnabled.setFromToml(gpu, "readbackLinearImages", is_game_specific);
         directMemoryAccessEnabled.setFromToml(gpu, "directMemoryAccess", is_game_specific);
@@ -946,6 +1005,7 @@ void load(const std::filesystem::path& path, bool is_game_specific) {
         rdocEnable.setFromToml(vk, "rdocEnable", is_game_specific);
         pipelineCacheEnable.setFromToml(vk, "pipelineCacheEnable", is_game_specific);
         pipelineCacheArchive.setFromToml(vk, "pipelineCacheArchive", is_game_specific);
+        shaderServiceSocket.setFromToml(vk, "shaderServiceSocket", is_game_specific);
     }
 
     string current_version = {};
@@ -955,6 +1015,7 @@ void load(const std::filesystem::path& path, bool is_game_specific) {
         isDebugDump.setFromToml(debug, "DebugDump", is_game_specific);
         isSeparateLogFilesEnabled.setFromToml(debug, "isSeparateLogFilesEnabled", is_game_specific);
         isShaderDebug.setFromToml(debug, "CollectShader", is_game_specific);
+        guestProfilerFrequency.setFromToml(debug, "guestProfilerFrequency", is_game_specific);
         showFpsCounter.setFromToml(debug, "showFpsCounter", is_game_specific);
         logEnabled.setFromToml(debug, "logEnabled", is_game_specific);
         current_version = toml::find_or<std::string>(debug, "ConfigVersion", current_version);
@@ -1075,6 +1136,8 @@ void save(const std::filesystem::path& path, bool is_game_specific) {
     }
     isPSNSignedIn.setTomlValue(data, "General", "isPSNSignedIn", is_game_specific);
     isConnectedToNetwork.setTomlValue(data, "General", "isConnectedToNetwork", is_game_specific);
+    avPlayerReadAhead.setTomlValue(data, "General", "avPlayerReadAhead", is_game_specific);
+    hostLibcStrings.setTomlValue(data, "General", "hostLibcStrings", is_game_specific);
 
     cursorState.setTomlValue(data, "Input", "cursorState", is_game_specific);
     cursorHideTimeout.setTomlValue(data, "Input", "cursorHideTimeout", is_game_specific);
@@ -1087,11 +1150,13 @@ void save(const std::filesystem::path& path, bool is_game_specific) {
     micDevice.setTomlValue(data, "Audio", "micDevice", is_game_specific);
     mainOutputDevice.setTomlValue(data, "Audio", "mainOutputDevice", is_game_specific);
     padSpkOutputDevice.setTomlValue(data, "Audio", "padSpkOutputDevice", is_game_specific);
+    audioBackend.setTomlValue(data, "Audio", "backend", is_game_specific);
 
     windowWidth.setTomlValue(data, "GPU", "screenWidth", is_game_specific);
     windowHeight.setTomlValue(data, "GPU", "screenHeight", is_game_specific);
     isNullGpu.setTomlValue(data, "GPU", "nullGpu", is_game_specific);
     shouldCopyGPUBuffers.setTomlValue(data, "GPU", "copyGPUBuffers", is_game_specific);
+    gpuFramesInFlight.setTomlValue(data, "GPU", "framesInFlight", is_game_specific);
     readbacksEnabled.setTomlValue(data, "GPU", "readbacks", is_game_specific);
     readbackLinearImagesEnabled.setTomlValue(data, "GPU", "readbackLinearImages", is_game_specific);
     shouldDumpShaders.setTomlValue(data, "GPU", "dumpShaders", is_game_specific);
@@ -1116,9 +1181,12 @@ void save(const std::filesystem::path& path, bool is_game_specific) {
     rdocEnable.setTomlValue(data, "Vulkan", "rdocEnable", is_game_specific);
     pipelineCacheEnable.setTomlValue(data, "Vulkan", "pipelineCacheEnable", is_game_specific);
     pipelineCacheArchive.setTomlValue(data, "Vulkan", "pipelineCacheArchive", is_game_specific);
+    shaderServiceSocket.setTomlValue(data, "Vulkan", "shaderServiceSocket", is_game_specific);
 
     isDebugDump.setTomlValue(data, "Debug", "DebugDump", is_game_specific);
     isShaderDebug.setTomlValue(data, "Debug", "CollectShader", is_game_specific);
+    guestProfilerFrequency.setTomlValue(data, "Debug", "guestProfilerFrequency",
+                                        is_game_specific);
     isSeparateLogFilesEnabled.setTomlValue(data, "Debug", "isSeparateLogFilesEnabled",
                                            is_game_specific);
     logEnabled.setTomlValue(data, "Debug", "logEnabled", is_game_specific);
@@ -1210,6 +1278,8 @@ void setDefaultValues(bool is_game_specific) {
     userName.set("shadPS4", is_game_specific);
     isShowSplash.set(false, is_game_specific);
     isSideTrophy.set("right", is_game_specific);
+    avPlayerReadAhead.set(16, is_game_specific);
+    hostLibcStrings.set(false, is_game_specific);
 
     // GS - Input
     cursorState.set(HideCursorState::Idle, is_game_specific);
@@ -1220,12 +1290,14 @@ void setDefaultValues(bool is_game_specific) {
 
     // GS - Audio
     micDevice.set("Default Device", is_game_specific);
+    audioBackend.set("SDL", is_game_specific);
 
     // GS - GPU
     windowWidth.set(1280, is_game_specific);
     windowHeight.set(720, is_game_specific);
     isNullGpu.set(false, is_game_specific);
     shouldCopyGPUBuffers.set(false, is_game_specific);
+    gpuFramesInFlight.set(1, is_game_specific);
     shouldDumpShaders.set(false, is_game_specific);
     vblankFrequency.set(60, is_game_specific);
     isFullscreen.set(false, is_game_specific);
@@ -1248,10 +1320,12 @@ void setDefaultValues(bool is_game_specific) {
     rdocEnable.set(false, is_game_specific);
     pipelineCacheEnable.set(false, is_game_specific);
     pipelineCacheArchive.set(false, is_game_specific);
+    shaderServiceSocket.set("", is_game_specific);
 
     // GS - Debug
     isDebugDump.set(false, is_game_specific);
     isShaderDebug.set(false, is_game_specific);
+    guestProfilerFrequency.set(0, is_game_specific);
     isSeparateLogFilesEnabled.set(false, is_game_specific);
     logEnabled.set(true, is_game_specific);
 
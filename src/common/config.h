@@ -55,6 +55,8 @@ bool allowHDR();
 void setAllowHDR(bool enable, bool is_game_specific = false);
 bool collectShadersForDebug();
 void setCollectShaderForDebug(bool enable, bool is_game_specific = false);
+u32 getGuestProfilerFrequency(); // Samples per second, 0 disables the guest profiler
+void setGuestProfilerFrequency(u32 frequency, bool is_game_specific = false);
 bool showSplash();
 void setShowSplash(bool enable, bool is_game_specific = false);
 std::string sideTrophy();
@@ -63,6 +65,9 @@ bool nullGpu();
 void setNullGpu(bool enable, bool is_game_specific = false);
 bool copyGPUCmdBuffers();
 void setCopyGPUCmdBuffers(bool enable, bool is_game_specific = false);
+constexpr u32 MaxGpuFramesInFlight = 4;
+u32 getGpuFramesInFlight();
+void setGpuFramesInFlight(u32 value, bool is_game_specific = false);
 bool readbacks();
 void setReadbacks(bool enable, bool is_game_specific = false);
 bool readbackLinearImages();
@@ -99,6 +104,8 @@ bool isPipelineCacheArchived();
 void setRdocEnabled(bool enable, bool is_game_specific = false);
 void setPipelineCacheEnabled(bool enable, bool is_game_specific = false);
 void setPipelineCacheArchived(bool enable, bool is_game_specific = false);
+std::string getShaderServiceSocket(); // Empty when the shader service is not used
+void setShaderServiceSocket(std::string path, bool is_game_specific = false);
 std::string getLogType();
 void setLogType(const std::string& type, bool is_game_specific = false);
 std::string getLogFilter();
@@ -111,6 +118,8 @@ std::string getMainOutputDevice();
 void setMainOutputDevice(std::string device, bool is_game_specific = false);
 std::string getPadSpkOutputDevice();
 void setPadSpkOutputDevice(std::string device, bool is_game_specific = false);
+std::string getAudioBackend(); // "SDL", "Null" or "Wav"
+void setAudioBackend(std::string backend, bool is_game_specific = false);
 std::string getMicDevice();
 void setCursorHideTimeout(int newcursorHideTimeout, bool is_game_specific = false);
 void setMicDevice(std::string device, bool is_game_specific = false);
@@ -150,6 +159,10 @@ int getRcasAttenuation();
 void setRcasAttenuation(int value, bool is_game_specific = false);
 bool getIsConnectedToNetwork();
 void setConnectedToNetwork(bool enable, bool is_game_specific = false);
+u32 getAvPlayerReadAhead(); // 64 KiB chunks buffered ahead of the AvPlayer demuxer, 0 disables
+void setAvPlayerReadAhead(u32 chunks, bool is_game_specific = false);
+bool getHostLibcStrings(); // Host string/memory routines replace the LLE libc ones
+void setHostLibcStrings(bool enable, bool is_game_specific = false);
 void setUserName(const std::string& name, bool is_game_specific = false);
 std::filesystem::path getSysModulesPath();
 void setSysModulesPath(const std::filesystem::path& path);
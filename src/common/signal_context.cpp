@@ -62,6 +62,26 @@ void* GetRip(void* ctx) {
 #endif
 }
 
+void* GetRsp(void* ctx) {
+#if defined(_WIN32)
+    return (void*)((EXCEPTION_POINTERS*)ctx)->ContextRecord->Rsp;
+#elif defined(__APPLE__)
+    return (void*)((ucontext_t*)ctx)->uc_mcontext->__ss.__rsp;
+#else
+    return (void*)((ucontext_t*)ctx)->uc_mcontext.gregs[REG_RSP];
+#endif
+}
+
+void* GetRbp(void* ctx) {
+#if defined(_WIN32)
+    return (void*)((EXCEPTION_POINTERS*)ctx)->ContextRecord->Rbp;
+#elif defined(__APPLE__)
+    return (void*)((ucontext_t*)ctx)->uc_mcontext->__ss.__rbp;
+#else
+    return (void*)((ucontext_t*)ctx)->uc_mcontext.gregs[REG_RBP];
+#endif
+}
+
 void IncrementRip(void* ctx, u64 length) {
 #if defined(_WIN32)
     ((EXCEPTION_POINTERS*)ctx)->ContextRecord->Rip += length;
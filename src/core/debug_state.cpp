@@ -5,6 +5,7 @@
 
 #include "common/assert.h"
 #include "common/native_clock.h"
+#include "common/path_util.h"
 #include "common/singleton.h"
 #include "debug_state.h"
 #include "devtools/widget/common.h"
@@ -13,6 +14,10 @@
 #include "video_core/amdgpu/pm4_cmds.h"
 #include "video_core/renderer_vulkan/vk_pipeline_cache.h"
 
+namespace Core::Devtools::Gcn {
+const char* GetOpCodeName(u32 op);
+}
+
 using namespace DebugStateType;
 
 DebugStateImpl& DebugState = *Common::Singleton<DebugStateImpl>::Instance();
@@ -100,6 +105,48 @@ void DebugStateImpl::ResumeGuestThreads() {
     is_guest_threads_paused = false;
 }
 
+void DebugStateImpl::PushCpFrameStats(const AmdGpu::CpFrameStats& stats) {
+    std::scoped_lock lock{cp_stats_mutex};
+    last_cp_stats = stats;
+    if (!cp_stats_csv_enabled) {
+        return;
+    }
+    std::string opcodes;
+    for (u32 op = 0; op < stats.packets.size(); ++op) {
+        if (stats.packets[op] != 0) {
+            opcodes += fmt::format("{}{}={}", opcodes.empty() ? "" : " ",
+                                   Core::Devtools::Gcn::GetOpCodeName(op), stats.packets[op]);
+        }
+    }
+    cp_stats_csv.WriteString(fmt::format(
+        "{},{},{},{},{},{},{},{},{},{},{},{},{},{}\n", stats.frame, stats.num_packets, stats.draws,
+        stats.dispatches, stats.dma_transfers, stats.yields, stats.wait_reg_mem_yields,
+        stats.resumes, stats.busy_ns / 1000, stats.rasterizer_ns / 1000, stats.ParseNs() / 1000,
+        stats.bindings_emitted, stats.bindings_skipped, opcodes));
+}
+
+void DebugStateImpl::SetCpStatsCsvEnabled(bool enable) {
+    std::scoped_lock lock{cp_stats_mutex};
+    if (enable == cp_stats_csv_enabled) {
+        return;
+    }
+    cp_stats_csv_enabled = false;
+    cp_stats_csv.Close();
+    if (!enable) {
+        return;
+    }
+    const auto path = Common::FS::GetUserPath(Common::FS::PathType::LogDir) / "cp_stats.csv";
+    cp_stats_csv.Open(path, Common::FS::FileAccessMode::Write, Common::FS::FileType::TextFile);
+    if (!cp_stats_csv.IsOpen()) {
+        LOG_ERROR(Core, "Failed to open {} for writing", path.string());
+        return;
+    }
+    cp_stats_csv.WriteString(std::string_view{
+        "frame,packets,draws,dispatches,dma_transfers,yields,wait_reg_mem_yields,resumes,"
+        "busy_us,rasterizer_us,parse_us,bindings_emitted,bindings_skipped,opcodes\n"});
+    cp_stats_csv_enabled = true;
+}
+
 void DebugStateImpl::RequestFrameDump(s32 count) {
     ASSERT(!DumpingCurrentFrame());
     gnm_frame_dump_request_count = count;
@@ -10,8 +10,10 @@
 #include <vector>
 #include <queue>
 
+#include "common/io_file.h"
 #include "common/types.h"
 #include "shader_recompiler/runtime_info.h"
+#include "video_core/amdgpu/cp_stats.h"
 #include "video_core/amdgpu/regs.h"
 #include "video_core/renderer_vulkan/vk_common.h"
 
@@ -145,6 +147,14 @@ class DebugStateImpl {
     std::atomic_int32_t flip_frame_count = 0;
     std::atomic_int32_t gnm_frame_count = 0;
 
+    std::atomic_uint64_t submit_wait_count = 0;
+    std::atomic_uint64_t submit_wait_time_us = 0;
+
+    mutable std::mutex cp_stats_mutex;
+    AmdGpu::CpFrameStats last_cp_stats{};
+    Common::FS::IOFile cp_stats_csv{};
+    bool cp_stats_csv_enabled = false;
+
     s32 gnm_frame_dump_request_count = -1;
     std::unordered_map<size_t, FrameDump*> waiting_reg_dumps;
     std::unordered_map<size_t, std::string> waiting_reg_dumps_dbg;
@@ -196,10 +206,32 @@ public:
         --gnm_frame_dump_request_count;
     }
 
+    void AddSubmitWait(u64 time_us) {
+        ++submit_wait_count;
+        submit_wait_time_us += time_us;
+    }
+
     u32 GetFrameNum() const {
         return flip_frame_count;
     }
 
+    /// Publishes the command processor counters of a GNM frame, called by the GPU thread.
+    void PushCpFrameStats(const AmdGpu::CpFrameStats& stats);
+
+    /// Returns the command processor counters of the last completed GNM frame.
+    AmdGpu::CpFrameStats GetCpFrameStats() const {
+        std::scoped_lock lock{cp_stats_mutex};
+        return last_cp_stats;
+    }
+
+    bool IsCpStatsCsvEnabled() const {
+        std::scoped_lock lock{cp_stats_mutex};
+        return cp_stats_csv_enabled;
+    }
+
+    /// Starts or stops appending one line per GNM frame to cp_stats.csv in the log directory.
+    void SetCpStatsCsvEnabled(bool enable);
+
     bool DumpingCurrentFrame() const {
         return gnm_frame_dump_request_count > 0;
     }
@@ -3,6 +3,9 @@
 
 #include "frame_graph.h"
 
+#include <algorithm>
+#include <numeric>
+
 #include "common/config.h"
 #include "common/singleton.h"
 #include "core/debug_state.h"
@@ -11,6 +14,10 @@
 
 using namespace ImGui;
 
+namespace Core::Devtools::Gcn {
+const char* GetOpCodeName(u32 op);
+}
+
 namespace Core::Devtools::Widget {
 
 constexpr float BAR_WIDTH_MULT = 1.4f;
@@ -96,13 +103,46 @@ void FrameGraph::Draw() {
         Text("Presenter time: %.3f ms (%.1f FPS)", io.DeltaTime * 1000.0f, 1.0f / io.DeltaTime);
         Text("Flip frame: %d Gnm submit frame: %d", DebugState.flip_frame_count.load(),
              DebugState.gnm_frame_count.load());
+        Text("Submit waits: %llu (%.3f ms blocked)",
+             static_cast<unsigned long long>(DebugState.submit_wait_count.load()),
+             DebugState.submit_wait_time_us.load() / 1000.0);
         Text("Game Res: %dx%d", DebugState.game_resolution.first,
              DebugState.game_resolution.second);
         Text("Output Res: %dx%d", DebugState.output_resolution.first,
              DebugState.output_resolution.second);
         Text("FSR: %s", DebugState.is_using_fsr ? "on" : "off");
+
+        SeparatorText("Command processor");
+        DrawCpStats();
     }
     End();
 }
 
+void FrameGraph::DrawCpStats() {
+    constexpr size_t NumTopOpcodes = 6;
+
+    const auto stats = DebugState.GetCpFrameStats();
+    Text("GNM frame: %llu", static_cast<unsigned long long>(stats.frame));
+    Text("Packets: %u Draws: %u Dispatches: %u DMA: %u", stats.num_packets, stats.draws,
+         stats.dispatches, stats.dma_transfers);
+    Text("Busy: %.3f ms (rasterizer %.3f ms, parsing %.3f ms)", stats.busy_ns / 1e6,
+         stats.rasterizer_ns / 1e6, stats.ParseNs() / 1e6);
+    Text("Resumes: %u Yields: %u (WaitRegMem: %u)", stats.resumes, stats.yields,
+         stats.wait_reg_mem_yields);
+    Text("Bindings: %u emitted, %u skipped", stats.bindings_emitted, stats.bindings_skipped);
+
+    std::array<u32, 256> ops;
+    std::iota(ops.begin(), ops.end(), 0);
+    std::partial_sort(ops.begin(), ops.begin() + NumTopOpcodes, ops.end(),
+                      [&](u32 a, u32 b) { return stats.packets[a] > stats.packets[b]; });
+    for (size_t i = 0; i < NumTopOpcodes && stats.packets[ops[i]] != 0; ++i) {
+        Text("  %-24s %u", Gcn::GetOpCodeName(ops[i]), stats.packets[ops[i]]);
+    }
+
+    bool csv_enabled = DebugState.IsCpStatsCsvEnabled();
+    if (Checkbox("Write cp_stats.csv", &csv_enabled)) {
+        DebugState.SetCpStatsCsvEnabled(csv_enabled);
+    }
+}
+
 } // namespace Core::Devtools::Widget
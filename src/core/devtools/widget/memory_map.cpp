@@ -1,10 +1,17 @@
 //  SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 //  SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <cinttypes>
+#include <cmath>
+#include <functional>
+#include <fmt/format.h>
 #include <imgui.h>
 #include <magic_enum/magic_enum.hpp>
 
+#include "common/div_ceil.h"
+#include "common/io_file.h"
+#include "common/path_util.h"
 #include "core/debug_state.h"
 #include "core/memory.h"
 #include "memory_map.h"
@@ -13,6 +20,30 @@ using namespace ImGui;
 
 namespace Core::Devtools::Widget {
 
+using VideoCore::PageHeatmap;
+
+constexpr u64 HEAT_PAGE_SIZE = 1ULL << PageHeatmap::PAGE_BITS;
+constexpr double HEAT_REFRESH_INTERVAL = 0.5;
+constexpr size_t HEAT_MAX_CELLS = 16384;
+constexpr float HEAT_CELL_SIZE = 6.0f;
+constexpr float HEAT_CELL_GAP = 1.0f;
+
+static ImU32 HeatColor(u64 value, u64 max_value) {
+    if (value == 0) {
+        return IM_COL32(0x33, 0x33, 0x33, 0xFF);
+    }
+    // Logarithmic scale, a handful of very hot pages would hide everything else otherwise
+    const float t = static_cast<float>(std::log1p(static_cast<double>(value)) /
+                                       std::log1p(static_cast<double>(max_value)));
+    if (t < 0.5f) { // BLUE <> YELLOW
+        const int c = static_cast<int>(0xFF * t * 2.0f);
+        return IM_COL32(c, c, 0xFF - c, 0xFF);
+    }
+    // YELLOW <> RED
+    const int g = static_cast<int>(0xFF * (1.0f - t) * 2.0f);
+    return IM_COL32(0xFF, g, 0, 0xFF);
+}
+
 bool MemoryMapViewer::Iterator::DrawLine() {
     if (is_vma) {
         if (vma.it == vma.end) {
@@ -72,29 +103,34 @@ void MemoryMapViewer::Draw() {
     std::scoped_lock lck{mem->mutex};
 
     {
-        bool next_showing_vma = showing_vma;
-        if (showing_vma) {
-            PushStyleColor(ImGuiCol_Button, ImVec4{1.0f, 0.7f, 0.7f, 1.0f});
-        }
-        if (Button("VMem")) {
-            next_showing_vma = true;
-        }
-        if (showing_vma) {
-            PopStyleColor();
-        }
+        View next_view = view;
+        const auto view_button = [&](const char* label, View button_view) {
+            const bool selected = view == button_view;
+            if (selected) {
+                PushStyleColor(ImGuiCol_Button, ImVec4{1.0f, 0.7f, 0.7f, 1.0f});
+            }
+            if (Button(label)) {
+                next_view = button_view;
+            }
+            if (selected) {
+                PopStyleColor();
+            }
+        };
+        view_button("VMem", View::Vma);
         SameLine();
-        if (!showing_vma) {
-            PushStyleColor(ImGuiCol_Button, ImVec4{1.0f, 0.7f, 0.7f, 1.0f});
-        }
-        if (Button("DMem")) {
-            next_showing_vma = false;
-        }
-        if (!showing_vma) {
-            PopStyleColor();
-        }
-        showing_vma = next_showing_vma;
+        view_button("DMem", View::Dmem);
+        SameLine();
+        view_button("Heatmap", View::Heatmap);
+        view = next_view;
     }
 
+    if (view == View::Heatmap) {
+        DrawHeatmap(*mem);
+        End();
+        return;
+    }
+    const bool showing_vma = view == View::Vma;
+
     Iterator it{};
     if (showing_vma) {
         it.is_vma = true;
@@ -132,4 +168,183 @@ void MemoryMapViewer::Draw() {
     End();
 }
 
-} // namespace Core::Devtools::Widget
\ No newline at end of file
+void MemoryMapViewer::DrawHeatmap(MemoryManager& mem) {
+    auto& heatmap = PageHeatmap::Instance();
+    if (heatmap.IsRunning()) {
+        if (Button("Stop sampling")) {
+            heatmap.Stop();
+        }
+    } else {
+        if (Button("Start sampling")) {
+            heatmap.Start(static_cast<u32>(sample_period));
+        }
+        SameLine();
+        SetNextItemWidth(120.0f);
+        SliderInt("Sample 1 in", &sample_period, 1, PageHeatmap::MaxSamplePeriod);
+    }
+    SameLine();
+    if (Button("Reset")) {
+        heatmap.Reset();
+        last_refresh = 0.0;
+    }
+    SameLine();
+    if (Button("Export CSV")) {
+        ExportHeatmap(mem);
+    }
+    if (const auto dropped = heatmap.GetDroppedSamples(); dropped != 0) {
+        SameLine();
+        TextColored({1.0f, 0.5f, 0.5f, 1.0f}, "%" PRIu64 " samples dropped", dropped);
+    }
+
+    // Aggregating per VMA walks every sampled page, no need to do it every frame
+    if (last_refresh == 0.0 || GetTime() - last_refresh >= HEAT_REFRESH_INTERVAL) {
+        last_refresh = GetTime();
+        heat_pages = heatmap.Snapshot();
+        heat_vmas.clear();
+        for (const auto& [page_addr, counts] : heat_pages) {
+            if (!heat_vmas.empty() && heat_vmas.back().base + heat_vmas.back().size > page_addr) {
+                heat_vmas.back().counts += counts;
+                ++heat_vmas.back().hot_pages;
+                continue;
+            }
+            if (page_addr < mem.vma_map.begin()->first) {
+                continue;
+            }
+            const auto& vma = mem.FindVMA(page_addr)->second;
+            heat_vmas.push_back({
+                .base = vma.base,
+                .size = vma.size,
+                .name = vma.IsFree() ? "<unmapped>" : vma.name,
+                .counts = counts,
+                .hot_pages = 1,
+            });
+        }
+        std::ranges::sort(heat_vmas, std::greater{},
+                          [](const VmaHeat& vma) { return vma.counts.Total(); });
+    }
+
+    const VmaHeat* selected = nullptr;
+    if (BeginTable("heatmap_vma_table", 8,
+                   ImGuiTableFlags_Resizable | ImGuiTableFlags_RowBg |
+                       ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_ScrollY,
+                   {0.0f, GetContentRegionAvail().y * 0.45f})) {
+        TableSetupScrollFreeze(0, 1);
+        TableSetupColumn("Address");
+        TableSetupColumn("Size");
+        TableSetupColumn("Name");
+        TableSetupColumn("Write faults");
+        TableSetupColumn("Read faults");
+        TableSetupColumn("Invalidations");
+        TableSetupColumn("Protects");
+        TableSetupColumn("Hot pages");
+        TableHeadersRow();
+        for (const auto& vma : heat_vmas) {
+            TableNextColumn();
+            const auto label = fmt::format("{:X}", vma.base);
+            if (Selectable(label.c_str(), selected_vma == vma.base,
+                           ImGuiSelectableFlags_SpanAllColumns)) {
+                selected_vma = vma.base;
+            }
+            if (selected_vma == vma.base) {
+                selected = &vma;
+            }
+            TableNextColumn();
+            Text("%" PRIX64, vma.size);
+            TableNextColumn();
+            Text("%s", vma.name.c_str());
+            TableNextColumn();
+            Text("%" PRIu64, vma.counts.write_faults);
+            TableNextColumn();
+            Text("%" PRIu64, vma.counts.read_faults);
+            TableNextColumn();
+            Text("%" PRIu64, vma.counts.invalidations);
+            TableNextColumn();
+            Text("%" PRIu64, vma.counts.protects);
+            TableNextColumn();
+            Text("%" PRIu64 "/%" PRIu64, vma.hot_pages, vma.size / HEAT_PAGE_SIZE);
+        }
+        EndTable();
+    }
+
+    if (selected) {
+        DrawPageGrid(*selected);
+    } else if (!heat_vmas.empty()) {
+        TextDisabled("Select a mapping to show its pages");
+    }
+}
+
+void MemoryMapViewer::DrawPageGrid(const VmaHeat& vma) {
+    const u64 num_pages = Common::DivCeil(vma.size, HEAT_PAGE_SIZE);
+    const u64 pages_per_cell = Common::DivCeil<u64>(num_pages, HEAT_MAX_CELLS);
+    const size_t num_cells = Common::DivCeil(num_pages, pages_per_cell);
+
+    std::vector<PageHeatmap::PageCounts> cells(num_cells);
+    u64 max_total = 0;
+    const auto end = heat_pages.lower_bound(vma.base + vma.size);
+    for (auto it = heat_pages.lower_bound(vma.base); it != end; ++it) {
+        auto& cell = cells[(it->first - vma.base) / HEAT_PAGE_SIZE / pages_per_cell];
+        cell += it->second;
+        max_total = std::max(max_total, cell.Total());
+    }
+
+    Text("%s: %" PRIu64 " page(s) per cell", vma.name.c_str(), pages_per_cell);
+    BeginChild("heatmap_grid");
+    const float stride = HEAT_CELL_SIZE + HEAT_CELL_GAP;
+    const size_t columns =
+        std::max<size_t>(1, static_cast<size_t>(GetContentRegionAvail().x / stride));
+    const size_t rows = Common::DivCeil(num_cells, columns);
+    const auto origin = GetCursorScreenPos();
+    Dummy({columns * stride, rows * stride});
+
+    auto& draw_list = *GetWindowDrawList();
+    for (size_t i = 0; i < num_cells; ++i) {
+        const ImVec2 min{origin.x + (i % columns) * stride, origin.y + (i / columns) * stride};
+        draw_list.AddRectFilled(min, {min.x + HEAT_CELL_SIZE, min.y + HEAT_CELL_SIZE},
+                                HeatColor(cells[i].Total(), max_total));
+    }
+
+    if (IsItemHovered()) {
+        const auto mouse = GetMousePos();
+        const size_t column = static_cast<size_t>((mouse.x - origin.x) / stride);
+        const size_t cell = static_cast<size_t>((mouse.y - origin.y) / stride) * columns + column;
+        if (column < columns && cell < num_cells) {
+            const auto& counts = cells[cell];
+            const VAddr addr = vma.base + cell * pages_per_cell * HEAT_PAGE_SIZE;
+            BeginTooltip();
+            Text("%" PRIXPTR " - %" PRIXPTR, addr, addr + pages_per_cell * HEAT_PAGE_SIZE);
+            Text("Write faults: %" PRIu64, counts.write_faults);
+            Text("Read faults: %" PRIu64, counts.read_faults);
+            Text("Invalidations: %" PRIu64, counts.invalidations);
+            Text("Protects: %" PRIu64, counts.protects);
+            EndTooltip();
+        }
+    }
+    EndChild();
+}
+
+void MemoryMapViewer::ExportHeatmap(MemoryManager& mem) const {
+    const auto path = Common::FS::GetUserPath(Common::FS::PathType::LogDir) / "page_heatmap.csv";
+    Common::FS::IOFile file{path, Common::FS::FileAccessMode::Write,
+                            Common::FS::FileType::TextFile};
+    if (!file.IsOpen()) {
+        DebugState.ShowDebugMessage(fmt::format("Failed to open {}", path.string()));
+        return;
+    }
+    std::string csv = "page,vma_base,vma_name,write_faults,read_faults,invalidations,protects\n";
+    for (const auto& [page_addr, counts] : PageHeatmap::Instance().Snapshot()) {
+        VAddr vma_base = 0;
+        std::string_view vma_name;
+        if (page_addr >= mem.vma_map.begin()->first) {
+            const auto& vma = mem.FindVMA(page_addr)->second;
+            vma_base = vma.base;
+            vma_name = vma.name;
+        }
+        csv += fmt::format("{:#x},{:#x},\"{}\",{},{},{},{}\n", page_addr, vma_base, vma_name,
+                           counts.write_faults, counts.read_faults, counts.invalidations,
+                           counts.protects);
+    }
+    file.WriteString(csv);
+    DebugState.ShowDebugMessage(fmt::format("Page heatmap exported to {}", path.string()));
+}
+
+} // namespace Core::Devtools::Widget
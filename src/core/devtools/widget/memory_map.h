@@ -4,6 +4,7 @@
 #pragma once
 
 #include "core/memory.h"
+#include "video_core/page_heatmap.h"
 
 namespace Core::Devtools::Widget {
 
@@ -22,7 +23,30 @@ class MemoryMapViewer {
         bool DrawLine();
     };
 
-    bool showing_vma = true;
+    enum class View {
+        Vma,
+        Dmem,
+        Heatmap,
+    };
+
+    struct VmaHeat {
+        VAddr base;
+        u64 size;
+        std::string name;
+        VideoCore::PageHeatmap::PageCounts counts;
+        u64 hot_pages;
+    };
+
+    void DrawHeatmap(MemoryManager& mem);
+    void DrawPageGrid(const VmaHeat& vma);
+    void ExportHeatmap(MemoryManager& mem) const;
+
+    View view = View::Vma;
+    int sample_period = 1;
+    double last_refresh = 0.0;
+    VideoCore::PageHeatmap::PageMap heat_pages;
+    std::vector<VmaHeat> heat_vmas;
+    VAddr selected_vma = 0;
 
 public:
     bool open = false;
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "common/aes.h"
+#include "common/aes_cbc.h"
 #include "common/config.h"
 #include "common/logging/log.h"
 #include "common/path_util.h"
@@ -17,8 +18,7 @@ static void DecryptEFSM(std::span<u8, 16> trophyKey, std::span<u8, 16> NPcommID,
                      trophyIv.data(), trpKey.data(), trpKey.size(), false);
 
     // Step 2: Decrypt EFSM
-    aes::decrypt_cbc(ciphertext.data(), ciphertext.size(), trpKey.data(), trpKey.size(),
-                     efsmIv.data(), decrypted.data(), decrypted.size(), nullptr);
+    Common::AesCbcDecrypt128(trpKey, efsmIv, ciphertext, decrypted);
 }
 
 TRP::TRP() = default;
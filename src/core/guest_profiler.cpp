@@ -0,0 +1,409 @@
+// SPDX-FileCopyrightText: Copyright 2025 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <thread>
+
+#include "common/assert.h"
+#include "common/io_file.h"
+#include "common/logging/log.h"
+#include "common/signal_context.h"
+#include "common/thread.h"
+#include "core/guest_profiler.h"
+#include "core/linker.h"
+#include "core/module.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <csignal>
+#include <ctime>
+#endif
+
+namespace Core {
+
+namespace {
+
+/// Follows the saved frame pointers as long as they stay on the thread stack and move towards
+/// its base. Guest code without frame pointers ends the chain early instead of faulting.
+u32 WalkFrames(u64 rip, u64 rsp, u64 rbp, VAddr stack_low, VAddr stack_high, u64* frames) {
+    u32 num_frames = 0;
+    frames[num_frames++] = rip;
+    if (rsp < stack_low || rsp >= stack_high) {
+        return num_frames;
+    }
+    u64 frame = rbp;
+    while (num_frames < GuestProfiler::MaxFrames && frame >= rsp && frame % 8 == 0 &&
+           frame + 16 <= stack_high) {
+        const auto* record = reinterpret_cast<const u64*>(frame);
+        const u64 return_address = record[1];
+        if (return_address == 0) {
+            break;
+        }
+        frames[num_frames++] = return_address;
+        const u64 next = record[0];
+        if (next <= frame) {
+            break;
+        }
+        frame = next;
+    }
+    return num_frames;
+}
+
+#ifndef _WIN32
+
+constexpr int SampleSignal = SIGPROF;
+constexpr auto CaptureTimeout = std::chrono::milliseconds{10};
+
+/// Mailbox between the sampler and the signal handler of the interrupted thread. Whoever clears
+/// pending first owns the request, so a late signal never writes into the next one.
+struct CaptureRequest {
+    pthread_t target;
+    VAddr stack_low;
+    VAddr stack_high;
+    GuestProfiler::Sample sample;
+    std::atomic<bool> pending;
+    std::atomic<bool> done;
+};
+
+CaptureRequest g_request{};
+struct sigaction g_old_action{};
+
+void SampleSignalHandler(int sig, siginfo_t* info, void* raw_context) {
+    if (!pthread_equal(pthread_self(), g_request.target) ||
+        !g_request.pending.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+    g_request.sample.num_frames =
+        WalkFrames(reinterpret_cast<u64>(Common::GetRip(raw_context)),
+                   reinterpret_cast<u64>(Common::GetRsp(raw_context)),
+                   reinterpret_cast<u64>(Common::GetRbp(raw_context)), g_request.stack_low,
+                   g_request.stack_high, g_request.sample.frames.data());
+    g_request.done.store(true, std::memory_order_release);
+}
+
+#endif
+
+std::pair<VAddr, VAddr> GetCurrentStackRange() {
+#if defined(_WIN32)
+    ULONG_PTR low{};
+    ULONG_PTR high{};
+    GetCurrentThreadStackLimits(&low, &high);
+    return {low, high};
+#elif defined(__APPLE__)
+    const pthread_t self = pthread_self();
+    const auto high = reinterpret_cast<VAddr>(pthread_get_stackaddr_np(self));
+    return {high - pthread_get_stacksize_np(self), high};
+#else
+    pthread_attr_t attr;
+    if (pthread_getattr_np(pthread_self(), &attr) != 0) {
+        return {0, 0};
+    }
+    void* addr{};
+    size_t size{};
+    pthread_attr_getstack(&attr, &addr, &size);
+    pthread_attr_destroy(&attr);
+    return {reinterpret_cast<VAddr>(addr), reinterpret_cast<VAddr>(addr) + size};
+#endif
+}
+
+std::string SymbolName(const Loader::SymbolRecord& record) {
+    if (record.nid_name != "UNK") {
+        return record.nid_name;
+    }
+    // Unknown names keep the NID, the first component of the record name.
+    return record.name.substr(0, record.name.find('#'));
+}
+
+} // Anonymous namespace
+
+GuestProfiler::GuestProfiler() = default;
+
+GuestProfiler::~GuestProfiler() = default;
+
+void GuestProfiler::Start(u32 frequency) {
+    if (frequency == 0 || IsRunning()) {
+        return;
+    }
+#ifndef _WIN32
+    struct sigaction action{};
+    action.sa_flags = SA_SIGINFO | SA_ONSTACK | SA_RESTART;
+    action.sa_sigaction = SampleSignalHandler;
+    sigemptyset(&action.sa_mask);
+    ASSERT_MSG(sigaction(SampleSignal, &action, &g_old_action) == 0,
+               "Failed to install guest profiler signal handler: {}", strerror(errno));
+#endif
+    LOG_INFO(Core, "Guest profiler sampling at {} Hz", frequency);
+    sampler_thread = std::jthread([this, frequency](std::stop_token stop) {
+        SamplerLoop(stop, frequency);
+    });
+    running = true;
+}
+
+void GuestProfiler::Stop(const std::filesystem::path& path) {
+    if (!IsRunning()) {
+        return;
+    }
+    running = false;
+    sampler_thread.request_stop();
+    sampler_thread.join();
+#ifndef _WIN32
+    sigaction(SampleSignal, &g_old_action, nullptr);
+#endif
+    WriteReport(path);
+}
+
+void GuestProfiler::RegisterCurrentThread(std::string_view name) {
+    // Sampling starts before the guest does, threads created while it is off are never sampled.
+    if (!IsRunning()) {
+        return;
+    }
+    const auto [stack_low, stack_high] = GetCurrentStackRange();
+    ThreadEntry entry{
+        .stack_low = stack_low,
+        .stack_high = stack_high,
+    };
+#ifdef _WIN32
+    entry.handle = OpenThread(THREAD_SUSPEND_RESUME | THREAD_GET_CONTEXT |
+                                  THREAD_QUERY_LIMITED_INFORMATION,
+                              FALSE, GetCurrentThreadId());
+#else
+    entry.handle = pthread_self();
+#endif
+#ifdef __linux__
+    pthread_getcpuclockid(entry.handle, &entry.cpu_clock);
+#endif
+
+    std::scoped_lock lk{mutex};
+    const auto it = std::ranges::find(thread_names, name);
+    entry.name_index = static_cast<u32>(std::distance(thread_names.begin(), it));
+    if (it == thread_names.end()) {
+        thread_names.emplace_back(name);
+    }
+    threads.push_back(entry);
+}
+
+void GuestProfiler::UnregisterCurrentThread() {
+    std::scoped_lock lk{mutex};
+#ifdef _WIN32
+    const DWORD id = GetCurrentThreadId();
+    const auto it = std::ranges::find_if(
+        threads, [id](const ThreadEntry& entry) { return GetThreadId(entry.handle) == id; });
+    if (it != threads.end()) {
+        CloseHandle(it->handle);
+        threads.erase(it);
+    }
+#else
+    const pthread_t self = pthread_self();
+    std::erase_if(threads,
+                  [self](const ThreadEntry& entry) { return pthread_equal(entry.handle, self); });
+#endif
+}
+
+void GuestProfiler::SamplerLoop(std::stop_token stop, u32 frequency) {
+    Common::SetCurrentThreadName("shadPS4:GuestProfiler");
+    const auto period = std::chrono::nanoseconds{1'000'000'000 / frequency};
+    // A thread that ran for less than a tenth of the period is considered blocked.
+    const u64 idle_threshold_ns = static_cast<u64>(period.count()) / 10;
+    auto next = std::chrono::steady_clock::now();
+    while (!stop.stop_requested()) {
+        {
+            std::scoped_lock lk{mutex};
+            SampleThreads(idle_threshold_ns);
+        }
+        next += period;
+        const auto now = std::chrono::steady_clock::now();
+        if (next < now) {
+            // Drop the ticks we fell behind on instead of sampling in a burst.
+            next = now;
+        }
+        std::this_thread::sleep_until(next);
+    }
+}
+
+void GuestProfiler::SampleThreads(u64 idle_threshold_ns) {
+    Sample sample;
+    for (ThreadEntry& entry : threads) {
+        u64 cpu_time{};
+        bool has_cpu_time = false;
+#if defined(_WIN32)
+        FILETIME creation, exit, kernel, user;
+        if (GetThreadTimes(entry.handle, &creation, &exit, &kernel, &user)) {
+            const auto to_ns = [](const FILETIME& time) {
+                return ((u64{time.dwHighDateTime} << 32) | time.dwLowDateTime) * 100;
+            };
+            cpu_time = to_ns(kernel) + to_ns(user);
+            has_cpu_time = true;
+        }
+#elif defined(__linux__)
+        timespec ts;
+        if (clock_gettime(entry.cpu_clock, &ts) == 0) {
+            cpu_time = static_cast<u64>(ts.tv_sec) * 1'000'000'000 + ts.tv_nsec;
+            has_cpu_time = true;
+        }
+#endif
+        const bool idle = has_cpu_time && entry.has_cpu_time &&
+                          cpu_time - entry.last_cpu_time < idle_threshold_ns;
+        entry.last_cpu_time = cpu_time;
+        entry.has_cpu_time = has_cpu_time;
+        ++num_samples;
+        if (idle) {
+            AddSample(entry.name_index, nullptr, 0);
+            continue;
+        }
+        if (!CaptureThread(entry, sample)) {
+            ++num_failed;
+            continue;
+        }
+        AddSample(entry.name_index, sample.frames.data(), sample.num_frames);
+    }
+}
+
+bool GuestProfiler::CaptureThread(const ThreadEntry& entry, Sample& sample) {
+#ifdef _WIN32
+    if (SuspendThread(entry.handle) == static_cast<DWORD>(-1)) {
+        return false;
+    }
+    CONTEXT context{};
+    context.ContextFlags = CONTEXT_CONTROL | CONTEXT_INTEGER;
+    const bool captured = GetThreadContext(entry.handle, &context);
+    if (captured) {
+        sample.num_frames = WalkFrames(context.Rip, context.Rsp, context.Rbp, entry.stack_low,
+                                       entry.stack_high, sample.frames.data());
+    }
+    ResumeThread(entry.handle);
+    return captured;
+#else
+    g_request.target = entry.handle;
+    g_request.stack_low = entry.stack_low;
+    g_request.stack_high = entry.stack_high;
+    g_request.done.store(false, std::memory_order_relaxed);
+    g_request.pending.store(true, std::memory_order_release);
+    if (pthread_kill(entry.handle, SampleSignal) != 0) {
+        g_request.pending.store(false, std::memory_order_relaxed);
+        return false;
+    }
+    const auto deadline = std::chrono::steady_clock::now() + CaptureTimeout;
+    while (!g_request.done.load(std::memory_order_acquire)) {
+        if (std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::yield();
+            continue;
+        }
+        if (g_request.pending.exchange(false, std::memory_order_acq_rel)) {
+            // The signal was not delivered in time, the handler will ignore it.
+            return false;
+        }
+        // The handler already claimed the request, it is about to finish.
+    }
+    sample = g_request.sample;
+    return true;
+#endif
+}
+
+void GuestProfiler::AddSample(u32 name_index, const u64* frames, u32 num_frames) {
+    std::string key(sizeof(u32) + num_frames * sizeof(u64), '\0');
+    std::memcpy(key.data(), &name_index, sizeof(u32));
+    if (num_frames != 0) {
+        std::memcpy(key.data() + sizeof(u32), frames, num_frames * sizeof(u64));
+    }
+    ++stacks[std::move(key)];
+}
+
+void GuestProfiler::WriteReport(const std::filesystem::path& path) {
+    auto* linker = Common::Singleton<Linker>::Instance();
+    // Exported symbols of every sampled module sorted by address.
+    std::unordered_map<const Module*, std::map<VAddr, std::string>> symbol_tables;
+    const auto symbolize = [&](VAddr address, bool& is_guest) -> std::string {
+        Module* module = linker->FindByAddress(address);
+        is_guest = module != nullptr;
+        if (!module) {
+            return "[HLE]";
+        }
+        auto [it, inserted] = symbol_tables.try_emplace(module);
+        auto& symbols = it->second;
+        if (inserted) {
+            for (const auto& record : module->export_sym.GetSymbols()) {
+                symbols.emplace(record.virtual_address, SymbolName(record));
+            }
+        }
+        const auto symbol = symbols.upper_bound(address);
+        if (symbol == symbols.begin()) {
+            return fmt::format("{}+{:#x}", module->name, address - module->base_virtual_addr);
+        }
+        return fmt::format("{}!{}", module->name, std::prev(symbol)->second);
+    };
+
+    u64 guest_samples{};
+    u64 hle_samples{};
+    u64 idle_samples{};
+    std::unordered_map<std::string, u64> folded;
+    std::unordered_map<std::string, u64> self_samples;
+    std::vector<u64> frames;
+    std::vector<std::string> names;
+    for (const auto& [key, count] : stacks) {
+        u32 name_index;
+        std::memcpy(&name_index, key.data(), sizeof(u32));
+        frames.resize((key.size() - sizeof(u32)) / sizeof(u64));
+        std::memcpy(frames.data(), key.data() + sizeof(u32), frames.size() * sizeof(u64));
+
+        std::string line = thread_names[name_index];
+        if (frames.empty()) {
+            idle_samples += count;
+            folded[line + ";[idle]"] += count;
+            continue;
+        }
+        names.clear();
+        bool leaf_is_guest = false;
+        for (u32 i = 0; i < frames.size(); i++) {
+            // Return addresses point after the call, look up the call itself.
+            bool is_guest;
+            std::string name = symbolize(i == 0 ? frames[i] : frames[i] - 1, is_guest);
+            if (i == 0) {
+                leaf_is_guest = is_guest;
+            }
+            // Host frames without symbols are collapsed into a single one.
+            if (!is_guest && !names.empty() && names.back() == name) {
+                continue;
+            }
+            names.push_back(std::move(name));
+        }
+        (leaf_is_guest ? guest_samples : hle_samples) += count;
+        self_samples[names.front()] += count;
+        for (auto it = names.rbegin(); it != names.rend(); ++it) {
+            line += ';';
+            line += *it;
+        }
+        folded[line] += count;
+    }
+
+    const Common::FS::IOFile file(path, Common::FS::FileAccessMode::Write,
+                                  Common::FS::FileType::TextFile);
+    if (!file.IsOpen()) {
+        LOG_ERROR(Core, "Failed to open {} for the guest profile", path.string());
+    } else {
+        for (const auto& [line, count] : folded) {
+            file.WriteString(fmt::format("{} {}\n", line, count));
+        }
+    }
+
+    const u64 total = std::max<u64>(guest_samples + hle_samples + idle_samples, 1);
+    const auto percent = [total](u64 count) { return 100.0 * count / total; };
+    LOG_INFO(Core,
+             "Guest profile: {} samples ({} failed), guest {:.1f}%, HLE {:.1f}%, idle {:.1f}%, "
+             "written to {}",
+             num_samples, num_failed, percent(guest_samples), percent(hle_samples),
+             percent(idle_samples), path.string());
+    std::vector<std::pair<std::string, u64>> hottest(self_samples.begin(), self_samples.end());
+    const size_t num_hottest = std::min<size_t>(hottest.size(), 10);
+    std::ranges::partial_sort(hottest, hottest.begin() + num_hottest,
+                              [](const auto& a, const auto& b) { return a.second > b.second; });
+    for (size_t i = 0; i < num_hottest; i++) {
+        LOG_INFO(Core, "  {:5.1f}% {}", percent(hottest[i].second), hottest[i].first);
+    }
+}
+
+} // namespace Core
@@ -0,0 +1,101 @@
+// SPDX-FileCopyrightText: Copyright 2025 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "common/polyfill_thread.h"
+#include "common/singleton.h"
+#include "common/types.h"
+
+#ifdef _WIN32
+using ProfilerThreadHandle = void*;
+#else
+#include <ctime>
+#include <pthread.h>
+using ProfilerThreadHandle = pthread_t;
+#endif
+
+namespace Core {
+
+/**
+ * Sampling profiler for guest threads. A sampler thread interrupts every registered thread at a
+ * fixed rate and records its instruction pointer and frame pointer chain. Samples are attributed
+ * to guest modules and their exported symbols when profiling stops, and written as folded stacks
+ * that flame graph tools accept.
+ */
+class GuestProfiler {
+public:
+    static constexpr u32 MaxFrames = 64;
+
+    struct Sample {
+        std::array<u64, MaxFrames> frames;
+        u32 num_frames;
+    };
+
+    GuestProfiler();
+    ~GuestProfiler();
+
+    /// Starts sampling the registered threads the given number of times per second.
+    void Start(u32 frequency);
+
+    /// Stops sampling and writes the collected stacks to the given path.
+    void Stop(const std::filesystem::path& path);
+
+    [[nodiscard]] bool IsRunning() const noexcept {
+        return running.load(std::memory_order_relaxed);
+    }
+
+    /// Makes the calling thread visible to the sampler. Does nothing when sampling is off.
+    void RegisterCurrentThread(std::string_view name);
+
+    /// Removes the calling thread, must be called before it exits.
+    void UnregisterCurrentThread();
+
+private:
+    struct ThreadEntry {
+        ProfilerThreadHandle handle;
+        u32 name_index;
+        VAddr stack_low;
+        VAddr stack_high;
+#ifdef __linux__
+        clockid_t cpu_clock;
+#endif
+        u64 last_cpu_time;
+        bool has_cpu_time;
+    };
+
+    void SamplerLoop(std::stop_token stop, u32 frequency);
+
+    /// Samples every registered thread once. Requires mutex.
+    void SampleThreads(u64 idle_threshold_ns);
+
+    /// Interrupts the thread and copies its stack into sample.
+    bool CaptureThread(const ThreadEntry& entry, Sample& sample);
+
+    void AddSample(u32 name_index, const u64* frames, u32 num_frames);
+
+    void WriteReport(const std::filesystem::path& path);
+
+    std::mutex mutex;
+    std::vector<ThreadEntry> threads;
+    std::vector<std::string> thread_names;
+    /// Thread name index followed by the raw frames, leaf first. Idle samples have no frames.
+    std::unordered_map<std::string, u64> stacks;
+    u64 num_samples{};
+    u64 num_failed{};
+    std::jthread sampler_thread;
+    std::atomic<bool> running{}; ///< Read by guest threads while they register
+};
+
+using Profiler = Common::Singleton<GuestProfiler>;
+
+} // namespace Core
@@ -0,0 +1,453 @@
+// SPDX-FileCopyrightText: Copyright 2025 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "shader_service.h"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+
+#include <fmt/format.h>
+
+#include "common/io_file.h"
+#include "common/logging/log.h"
+#include "common/path_util.h"
+#include "common/thread.h"
+
+#ifndef _WIN32
+#include <cerrno>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace ShaderService {
+
+namespace {
+
+constexpr u32 Magic = 0x43535053; // "SPSC"
+constexpr u16 Version = 1;
+
+enum class Op : u16 {
+    Get = 1,
+    Put = 2,
+};
+
+struct RequestHeader {
+    u32 magic;
+    u16 version;
+    Op op;
+    u64 key;
+    u32 size;
+    u32 reserved;
+};
+static_assert(sizeof(RequestHeader) == 24);
+
+struct ResponseHeader {
+    u32 found;
+    u32 size;
+};
+static_assert(sizeof(ResponseHeader) == 8);
+
+constexpr u32 MaxBlobSize = 64_MB;
+
+/// Upper bound of a lookup stall on the GPU thread when the service hangs. A timeout drops the
+/// connection like any other error, so the stall happens at most once per instance.
+constexpr auto ClientTimeout = std::chrono::milliseconds{50};
+
+constexpr auto StatsInterval = std::chrono::minutes{1};
+
+#ifndef _WIN32
+#ifdef MSG_NOSIGNAL
+constexpr int SendFlags = MSG_NOSIGNAL;
+#else
+constexpr int SendFlags = 0;
+#endif
+
+bool SendAll(int fd, const void* data, size_t size) {
+    const auto* ptr = static_cast<const u8*>(data);
+    while (size != 0) {
+        const ssize_t sent = send(fd, ptr, size, SendFlags);
+        if (sent < 0 && errno == EINTR) {
+            continue;
+        }
+        if (sent <= 0) {
+            return false;
+        }
+        ptr += sent;
+        size -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+bool RecvAll(int fd, void* data, size_t size) {
+    auto* ptr = static_cast<u8*>(data);
+    while (size != 0) {
+        const ssize_t received = recv(fd, ptr, size, 0);
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (received <= 0) {
+            return false;
+        }
+        ptr += received;
+        size -= static_cast<size_t>(received);
+    }
+    return true;
+}
+
+void SetupSocket(int fd, bool timeouts) {
+#ifdef SO_NOSIGPIPE
+    const int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+    if (timeouts) {
+        const auto usec = std::chrono::duration_cast<std::chrono::microseconds>(ClientTimeout);
+        const timeval tv{.tv_sec = static_cast<time_t>(usec.count() / 1000000),
+                         .tv_usec = static_cast<suseconds_t>(usec.count() % 1000000)};
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+    }
+}
+
+bool MakeAddress(const std::string& socket_path, sockaddr_un& addr) {
+    addr = {};
+    addr.sun_family = AF_UNIX;
+    if (socket_path.empty() || socket_path.size() >= sizeof(addr.sun_path)) {
+        return false;
+    }
+    std::memcpy(addr.sun_path, socket_path.c_str(), socket_path.size() + 1);
+    return true;
+}
+
+/// Blobs keyed by a hash of the inputs that produced them, one file per key, fanned out over
+/// 256 directories.
+class BlobStore {
+public:
+    explicit BlobStore(std::filesystem::path root_) : root{std::move(root_)} {
+        std::error_code ec;
+        std::filesystem::create_directories(root, ec);
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(root, ec)) {
+            const auto& path = entry.path();
+            if (!entry.is_regular_file() || path.extension() != ".bin") {
+                continue;
+            }
+            const auto stem = path.stem().string();
+            char* end{};
+            const u64 key = std::strtoull(stem.c_str(), &end, 16);
+            if (*end == '\0') {
+                keys.insert(key);
+            }
+        }
+        LOG_INFO(Render, "Shader service store at {} holds {} entries", root.string(),
+                 keys.size());
+    }
+
+    std::optional<std::vector<u8>> Load(u64 key) {
+        {
+            std::scoped_lock lk{mutex};
+            if (!keys.contains(key)) {
+                return std::nullopt;
+            }
+        }
+        Common::FS::IOFile file{PathOf(key), Common::FS::FileAccessMode::Read};
+        if (!file.IsOpen()) {
+            return std::nullopt;
+        }
+        std::vector<u8> data(file.GetSize());
+        if (file.ReadSpan(std::span{data}) != data.size()) {
+            return std::nullopt;
+        }
+        return data;
+    }
+
+    void Store(u64 key, std::span<const u8> data) {
+        {
+            std::scoped_lock lk{mutex};
+            if (!keys.insert(key).second) {
+                // Translation is deterministic, so an existing entry already holds the output
+                // of the same inputs.
+                return;
+            }
+        }
+        const auto path = PathOf(key);
+        std::error_code ec;
+        std::filesystem::create_directories(path.parent_path(), ec);
+
+        // Write to a private file first so readers never observe a partial blob.
+        auto tmp_path = path;
+        const auto thread_id = std::hash<std::thread::id>{}(std::this_thread::get_id());
+        tmp_path += fmt::format(".{}.tmp", thread_id);
+        {
+            Common::FS::IOFile file{tmp_path, Common::FS::FileAccessMode::Write};
+            if (!file.IsOpen() || file.WriteSpan(data) != data.size()) {
+                LOG_ERROR(Render, "Failed to write shader service entry {:016x}", key);
+                std::scoped_lock lk{mutex};
+                keys.erase(key);
+                return;
+            }
+        }
+        std::filesystem::rename(tmp_path, path, ec);
+        if (ec) {
+            LOG_ERROR(Render, "Failed to commit shader service entry {:016x}: {}", key,
+                      ec.message());
+            std::scoped_lock lk{mutex};
+            keys.erase(key);
+        }
+    }
+
+private:
+    std::filesystem::path PathOf(u64 key) const {
+        return root / fmt::format("{:02x}", key >> 56) / fmt::format("{:016x}.bin", key);
+    }
+
+    std::filesystem::path root;
+    std::mutex mutex;
+    std::unordered_set<u64> keys;
+};
+
+class Server {
+public:
+    explicit Server(int listen_fd_)
+        : listen_fd{listen_fd_},
+          store{Common::FS::GetUserPath(Common::FS::PathType::CacheDir) / "shader_service"} {}
+
+    ~Server() {
+        close(listen_fd);
+    }
+
+    void Run() {
+        auto last_stats = std::chrono::steady_clock::now();
+        while (true) {
+            pollfd pfd{.fd = listen_fd, .events = POLLIN, .revents = 0};
+            if (poll(&pfd, 1, 1000) > 0 && (pfd.revents & POLLIN)) {
+                const int fd = accept(listen_fd, nullptr, nullptr);
+                if (fd >= 0) {
+                    SetupSocket(fd, false);
+                    auto& connection = connections.emplace_back();
+                    connection.thread = std::jthread([this, fd, &connection] {
+                        Common::SetCurrentThreadName("shadPS4:ShaderServiceConn");
+                        Serve(fd);
+                        close(fd);
+                        connection.done = true;
+                    });
+                }
+            }
+            connections.remove_if([](const Connection& c) { return c.done.load(); });
+
+            const auto now = std::chrono::steady_clock::now();
+            if (now - last_stats >= StatsInterval) {
+                last_stats = now;
+                LogStats();
+            }
+        }
+    }
+
+private:
+    struct Connection {
+        std::jthread thread;
+        std::atomic<bool> done{};
+    };
+
+    void Serve(int fd) {
+        num_connections.fetch_add(1, std::memory_order_relaxed);
+        RequestHeader request{};
+        std::vector<u8> payload;
+        while (RecvAll(fd, &request, sizeof(request))) {
+            if (request.magic != Magic || request.version != Version ||
+                request.size > MaxBlobSize) {
+                LOG_ERROR(Render, "Dropping shader service client sending a bad request");
+                return;
+            }
+            switch (request.op) {
+            case Op::Get: {
+                num_lookups.fetch_add(1, std::memory_order_relaxed);
+                const auto blob = store.Load(request.key);
+                const ResponseHeader response{
+                    .found = blob ? 1U : 0U,
+                    .size = blob ? static_cast<u32>(blob->size()) : 0U,
+                };
+                if (!SendAll(fd, &response, sizeof(response)) ||
+                    (blob && !SendAll(fd, blob->data(), blob->size()))) {
+                    return;
+                }
+                if (blob) {
+                    num_hits.fetch_add(1, std::memory_order_relaxed);
+                }
+                break;
+            }
+            case Op::Put:
+                payload.resize(request.size);
+                if (!RecvAll(fd, payload.data(), payload.size())) {
+                    return;
+                }
+                store.Store(request.key, payload);
+                num_stores.fetch_add(1, std::memory_order_relaxed);
+                break;
+            default:
+                LOG_ERROR(Render, "Unknown shader service op {}", static_cast<u32>(request.op));
+                return;
+            }
+        }
+    }
+
+    void LogStats() const {
+        const u64 lookups = num_lookups.load(std::memory_order_relaxed);
+        const u64 hits = num_hits.load(std::memory_order_relaxed);
+        LOG_INFO(Render,
+                 "Shader service: {} connections, {} lookups, {} hits ({:.1f}%), {} stores",
+                 num_connections.load(std::memory_order_relaxed), lookups, hits,
+                 lookups ? 100.0 * static_cast<double>(hits) / static_cast<double>(lookups) : 0.0,
+                 num_stores.load(std::memory_order_relaxed));
+    }
+
+    int listen_fd;
+    BlobStore store;
+    std::list<Connection> connections;
+    std::atomic<u64> num_connections{};
+    std::atomic<u64> num_lookups{};
+    std::atomic<u64> num_hits{};
+    std::atomic<u64> num_stores{};
+};
+#endif
+
+} // Anonymous namespace
+
+#ifndef _WIN32
+
+std::unique_ptr<Client> Client::Connect(const std::string& socket_path) {
+    sockaddr_un addr;
+    if (!MakeAddress(socket_path, addr)) {
+        LOG_ERROR(Render, "Invalid shader service socket path '{}'", socket_path);
+        return nullptr;
+    }
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return nullptr;
+    }
+    if (connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0) {
+        LOG_WARNING(Render, "Shader service is not running at {}, compiling in process",
+                    socket_path);
+        close(fd);
+        return nullptr;
+    }
+    SetupSocket(fd, true);
+    LOG_INFO(Render, "Connected to shader service at {}", socket_path);
+    return std::unique_ptr<Client>(new Client(fd));
+}
+
+Client::~Client() {
+    Disconnect();
+}
+
+void Client::Disconnect() {
+    if (fd >= 0) {
+        close(fd);
+        fd = -1;
+    }
+}
+
+std::optional<std::vector<u8>> Client::Get(u64 key) {
+    if (fd < 0) {
+        return std::nullopt;
+    }
+    ++stats.lookups;
+    const RequestHeader request{
+        .magic = Magic, .version = Version, .op = Op::Get, .key = key, .size = 0, .reserved = 0};
+    ResponseHeader response{};
+    if (!SendAll(fd, &request, sizeof(request)) ||
+        !RecvAll(fd, &response, sizeof(response)) || response.size > MaxBlobSize) {
+        LOG_ERROR(Render, "Lost connection to the shader service, compiling in process");
+        ++stats.errors;
+        Disconnect();
+        return std::nullopt;
+    }
+    if (!response.found) {
+        return std::nullopt;
+    }
+    std::vector<u8> data(response.size);
+    if (!RecvAll(fd, data.data(), data.size())) {
+        LOG_ERROR(Render, "Lost connection to the shader service, compiling in process");
+        ++stats.errors;
+        Disconnect();
+        return std::nullopt;
+    }
+    ++stats.hits;
+    return data;
+}
+
+void Client::Put(u64 key, std::span<const u8> data) {
+    if (fd < 0 || data.size() > MaxBlobSize) {
+        return;
+    }
+    const RequestHeader request{.magic = Magic,
+                                .version = Version,
+                                .op = Op::Put,
+                                .key = key,
+                                .size = static_cast<u32>(data.size()),
+                                .reserved = 0};
+    if (!SendAll(fd, &request, sizeof(request)) || !SendAll(fd, data.data(), data.size())) {
+        LOG_ERROR(Render, "Lost connection to the shader service, compiling in process");
+        ++stats.errors;
+        Disconnect();
+        return;
+    }
+    ++stats.published;
+}
+
+int RunServer(const std::string& socket_path) {
+    sockaddr_un addr;
+    if (!MakeAddress(socket_path, addr)) {
+        LOG_CRITICAL(Render, "Invalid shader service socket path '{}'", socket_path);
+        return 1;
+    }
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        LOG_CRITICAL(Render, "Failed to create shader service socket: {}", errno);
+        return 1;
+    }
+    // A stale socket file from a previous run would make bind fail.
+    unlink(socket_path.c_str());
+    if (bind(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        listen(fd, SOMAXCONN) != 0) {
+        LOG_CRITICAL(Render, "Failed to listen on {}: {}", socket_path, errno);
+        close(fd);
+        return 1;
+    }
+    LOG_INFO(Render, "Shader service listening on {}", socket_path);
+
+    Server server{fd};
+    server.Run();
+    return 0;
+}
+
+#else
+
+std::unique_ptr<Client> Client::Connect(const std::string& socket_path) {
+    LOG_WARNING(Render, "Shader service is not supported on this platform");
+    return nullptr;
+}
+
+Client::~Client() = default;
+
+void Client::Disconnect() {}
+
+std::optional<std::vector<u8>> Client::Get(u64 key) {
+    return std::nullopt;
+}
+
+void Client::Put(u64 key, std::span<const u8> data) {}
+
+int RunServer(const std::string& socket_path) {
+    LOG_CRITICAL(Render, "Shader service is not supported on this platform");
+    return 1;
+}
+
+#endif
+
+} // namespace ShaderService
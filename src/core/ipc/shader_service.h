@@ -0,0 +1,74 @@
+// SPDX-FileCopyrightText: Copyright 2025 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "common/types.h"
+
+/**
+ * Local shader cache service shared by several emulator instances.
+ *
+ * The service is the shadPS4 binary started with --shader-service <socket>. It listens on a Unix
+ * domain socket and keeps a blob store on disk, keyed by a hash of the translation inputs.
+ * Emulator instances look up recompiled shaders by key before recompiling them, and publish the
+ * result of every miss so the other instances can reuse it.
+ *
+ * Protocol summary (native byte order, one request at a time per connection):
+ * - Request: RequestHeader followed by `size` payload bytes (PUT only)
+ * - GET(key): the service answers with a ResponseHeader, then `size` payload bytes on a hit
+ * - PUT(key, payload): stores the payload, no answer is sent
+ **/
+
+namespace ShaderService {
+
+struct ClientStats {
+    u64 lookups;
+    u64 hits;
+    u64 published;
+    u64 errors;
+};
+
+class Client {
+public:
+    /// Connects to the service listening at `socket_path`. Returns nullptr when it is not running.
+    static std::unique_ptr<Client> Connect(const std::string& socket_path);
+
+    ~Client();
+
+    Client(const Client&) = delete;
+    Client& operator=(const Client&) = delete;
+
+    /// Looks up a blob. Any transport error drops the connection, after which every lookup
+    /// misses and callers keep compiling in process.
+    std::optional<std::vector<u8>> Get(u64 key);
+
+    void Put(u64 key, std::span<const u8> data);
+
+    [[nodiscard]] bool IsConnected() const {
+        return fd >= 0;
+    }
+
+    [[nodiscard]] ClientStats GetStats() const {
+        return stats;
+    }
+
+private:
+    explicit Client(int fd_) : fd{fd_} {}
+
+    void Disconnect();
+
+    int fd;
+    ClientStats stats{};
+};
+
+/// Runs the service in the foreground until the process is terminated.
+/// Returns the process exit code when the socket cannot be set up.
+int RunServer(const std::string& socket_path);
+
+} // namespace ShaderService
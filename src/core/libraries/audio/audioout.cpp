@@ -3,17 +3,15 @@
 
 #include <memory>
 #include <mutex>
-#include <stop_token>
-#include <thread>
 #include <magic_enum/magic_enum.hpp>
 
 #include "common/assert.h"
 #include "common/config.h"
 #include "common/logging/log.h"
-#include "common/thread.h"
 #include "core/libraries/audio/audioout.h"
 #include "core/libraries/audio/audioout_backend.h"
 #include "core/libraries/audio/audioout_error.h"
+#include "core/libraries/audio/audioout_mixer.h"
 #include "core/libraries/kernel/time.h"
 #include "core/libraries/libs.h"
 
@@ -22,7 +20,7 @@ namespace Libraries::AudioOut {
 std::mutex port_open_mutex{};
 std::array<PortOut, SCE_AUDIO_OUT_NUM_PORTS> ports_out{};
 
-static std::unique_ptr<AudioOutBackend> audio;
+static std::unique_ptr<AudioMixer> mixer;
 
 static AudioFormatInfo GetFormatInfo(const OrbisAudioOutParamFormat format) {
     static constexpr std::array<AudioFormatInfo, 8> format_infos = {{
@@ -90,7 +88,7 @@ int PS4_SYSV_ABI sceAudioOutChangeAppModuleState() {
 
 int PS4_SYSV_ABI sceAudioOutClose(s32 handle) {
     LOG_INFO(Lib_AudioOut, "handle = {}", handle);
-    if (audio == nullptr) {
+    if (mixer == nullptr) {
         return ORBIS_AUDIO_OUT_ERROR_NOT_INIT;
     }
     if (handle < 1 || handle > SCE_AUDIO_OUT_NUM_PORTS) {
@@ -107,10 +105,10 @@ int PS4_SYSV_ABI sceAudioOutClose(s32 handle) {
         std::free(port.output_buffer);
         port.output_buffer = nullptr;
         port.output_ready = false;
-        port.impl = nullptr;
+        port.is_open = false;
     }
-    // Stop outside of port lock scope to prevent deadlocks.
-    port.output_thread.Stop();
+    port.output_cv.notify_all();
+    mixer->OnPortClosed();
     return ORBIS_OK;
 }
 
@@ -186,7 +184,7 @@ int PS4_SYSV_ABI sceAudioOutGetLastOutputTime(s32 handle, u64* output_time) {
 }
 
 int PS4_SYSV_ABI sceAudioOutGetPortState(s32 handle, OrbisAudioOutPortState* state) {
-    if (audio == nullptr) {
+    if (mixer == nullptr) {
         return ORBIS_AUDIO_OUT_ERROR_NOT_INIT;
     }
     if (handle < 1 || handle > SCE_AUDIO_OUT_NUM_PORTS) {
@@ -252,10 +250,20 @@ int PS4_SYSV_ABI sceAudioOutGetSystemState() {
 
 int PS4_SYSV_ABI sceAudioOutInit() {
     LOG_TRACE(Lib_AudioOut, "called");
-    if (audio != nullptr) {
+    if (mixer != nullptr) {
         return ORBIS_AUDIO_OUT_ERROR_ALREADY_INIT;
     }
-    audio = std::make_unique<SDLAudioOut>();
+    std::unique_ptr<AudioOutBackend> backend;
+    const auto backend_name = Config::getAudioBackend();
+    if (backend_name == "Null") {
+        backend = std::make_unique<NullAudioOut>(false);
+    } else if (backend_name == "Wav") {
+        backend = std::make_unique<NullAudioOut>(true);
+    } else {
+        backend = std::make_unique<SDLAudioOut>();
+    }
+    mixer = std::make_unique<AudioMixer>(std::move(backend), ports_out);
+    AdjustVol();
     return ORBIS_OK;
 }
 
@@ -289,31 +297,6 @@ int PS4_SYSV_ABI sceAudioOutMbusInit() {
     return ORBIS_OK;
 }
 
-static void AudioOutputThread(PortOut* port, const std::stop_token& stop) {
-    {
-        const auto thread_name = fmt::format("shadPS4:AudioOutputThread:{}", fmt::ptr(port));
-        Common::SetCurrentThreadName(thread_name.c_str());
-    }
-
-    Common::AccurateTimer timer(
-        std::chrono::nanoseconds(1000000000ULL * port->buffer_frames / port->sample_rate));
-    while (true) {
-        timer.Start();
-        {
-            std::unique_lock lock{port->mutex};
-            if (port->output_ready) {
-                port->impl->Output(port->output_buffer);
-                port->output_ready = false;
-            }
-        }
-        port->output_cv.notify_one();
-        if (stop.stop_requested()) {
-            break;
-        }
-        timer.End();
-    }
-}
-
 s32 PS4_SYSV_ABI sceAudioOutOpen(UserService::OrbisUserServiceUserId user_id,
                                  OrbisAudioOutPort port_type, s32 index, u32 length,
                                  u32 sample_rate,
@@ -324,7 +307,7 @@ s32 PS4_SYSV_ABI sceAudioOutOpen(UserService::OrbisUserServiceUserId user_id,
              user_id, magic_enum::enum_name(port_type), index, length, sample_rate,
              magic_enum::enum_name(param_type.data_format.Value()),
              magic_enum::enum_name(param_type.attributes.Value()));
-    if (audio == nullptr) {
+    if (mixer == nullptr) {
         LOG_ERROR(Lib_AudioOut, "Audio out not initialized");
         return ORBIS_AUDIO_OUT_ERROR_NOT_INIT;
     }
@@ -374,14 +357,15 @@ s32 PS4_SYSV_ABI sceAudioOutOpen(UserService::OrbisUserServiceUserId user_id,
         port->sample_rate = sample_rate;
         port->buffer_frames = length;
         port->volume.fill(SCE_AUDIO_OUT_VOLUME_0DB);
-
-        port->impl = audio->Open(*port);
+        port->device = port_type == OrbisAudioOutPort::PadSpk ? AudioOutDevice::PadSpk
+                                                               : AudioOutDevice::Main;
 
         port->output_buffer = std::malloc(port->BufferSize());
         port->output_ready = false;
-        port->output_thread.Run(
-            [port](const std::stop_token& stop) { AudioOutputThread(&*port, stop); });
+        port->mixed_frames = 0;
+        port->is_open = true;
     }
+    mixer->OnPortOpened(port->device);
     return std::distance(ports_out.begin(), port) + 1;
 }
 
@@ -391,7 +375,7 @@ int PS4_SYSV_ABI sceAudioOutOpenEx() {
 }
 
 s32 PS4_SYSV_ABI sceAudioOutOutput(s32 handle, void* ptr) {
-    if (audio == nullptr) {
+    if (mixer == nullptr) {
         return ORBIS_AUDIO_OUT_ERROR_NOT_INIT;
     }
     if (handle < 1 || handle > SCE_AUDIO_OUT_NUM_PORTS) {
@@ -518,7 +502,7 @@ int PS4_SYSV_ABI sceAudioOutSetUsbVolume() {
 }
 
 s32 PS4_SYSV_ABI sceAudioOutSetVolume(s32 handle, s32 flag, s32* vol) {
-    if (audio == nullptr) {
+    if (mixer == nullptr) {
         return ORBIS_AUDIO_OUT_ERROR_NOT_INIT;
     }
     if (handle < 1 || handle > SCE_AUDIO_OUT_NUM_PORTS) {
@@ -536,24 +520,16 @@ s32 PS4_SYSV_ABI sceAudioOutSetVolume(s32 handle, s32 flag, s32* vol) {
                 port.volume[i] = vol[i];
             }
         }
-        port.impl->SetVolume(port.volume);
     }
-    AdjustVol();
     return ORBIS_OK;
 }
 
 void AdjustVol() {
-    if (audio == nullptr) {
+    if (mixer == nullptr) {
         return;
     }
-
-    for (int i = 0; i < ports_out.size(); i++) {
-        std::unique_lock lock{ports_out[i].mutex};
-        if (!ports_out[i].IsOpen()) {
-            continue;
-        }
-        ports_out[i].impl->SetVolume(ports_out[i].volume);
-    }
+    // Per-port volumes are applied by the mixer, only the global slider needs to be pushed.
+    mixer->SetMasterVolume(Config::getVolumeSlider() / 100.0f);
 }
 
 int PS4_SYSV_ABI sceAudioOutSetVolumeDown() {
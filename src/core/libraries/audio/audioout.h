@@ -8,13 +8,12 @@
 #include <mutex>
 
 #include "common/bit_field.h"
+#include "core/libraries/audio/audioout_backend.h"
 #include "core/libraries/kernel/threads.h"
 #include "core/libraries/system/userservice.h"
 
 namespace Libraries::AudioOut {
 
-class PortBackend;
-
 // Main up to 8 ports, BGM 1 port, voice up to 4 ports,
 // personal up to 4 ports, padspk up to 5 ports, aux 1 port
 constexpr s32 SCE_AUDIO_OUT_NUM_PORTS = 22;
@@ -85,12 +84,13 @@ struct AudioFormatInfo {
 
 struct PortOut {
     std::mutex mutex;
-    std::unique_ptr<PortBackend> impl{};
+    bool is_open;
+    AudioOutDevice device;
 
     void* output_buffer;
     std::condition_variable_any output_cv;
     bool output_ready;
-    Kernel::Thread output_thread{};
+    u32 mixed_frames; ///< Frames of the ready buffer the mixer has already consumed.
 
     OrbisAudioOutPort type;
     AudioFormatInfo format_info;
@@ -100,7 +100,7 @@ struct PortOut {
     std::array<s32, 8> volume;
 
     [[nodiscard]] bool IsOpen() const {
-        return impl != nullptr;
+        return is_open;
     }
 
     [[nodiscard]] u32 BufferSize() const {
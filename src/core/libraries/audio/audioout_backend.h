@@ -3,19 +3,28 @@
 
 #pragma once
 
+#include <memory>
+
+#include "common/types.h"
+
 namespace Libraries::AudioOut {
 
-struct PortOut;
+/// Host output devices the mixer feeds. Pad speaker ports are routed separately
+/// from everything else so they can target a different host device.
+enum class AudioOutDevice : u32 {
+    Main = 0,
+    PadSpk = 1,
+    Count,
+};
 
-class PortBackend {
+class DeviceBackend {
 public:
-    virtual ~PortBackend() = default;
+    virtual ~DeviceBackend() = default;
 
-    /// Guaranteed to be called in intervals of at least port buffer time,
-    /// with size equal to port buffer size.
-    virtual void Output(void* ptr) = 0;
-
-    virtual void SetVolume(const std::array<int, 8>& ch_volumes) = 0;
+    /// Called once per mixer period with interleaved float frames of MixChannels channels,
+    /// ordered FL, FR, FC, LFE, BL, BR, SL, SR. Only the first num_channels of each frame
+    /// carry sound, either 2 when every playing port is mono or stereo, or MixChannels.
+    virtual void Output(const float* samples, u32 num_frames, u32 num_channels) = 0;
 };
 
 class AudioOutBackend {
@@ -23,12 +32,27 @@ public:
     AudioOutBackend() = default;
     virtual ~AudioOutBackend() = default;
 
-    virtual std::unique_ptr<PortBackend> Open(PortOut& port) = 0;
+    virtual std::unique_ptr<DeviceBackend> Open(AudioOutDevice device, u32 sample_rate,
+                                                u32 period_frames) = 0;
 };
 
 class SDLAudioOut final : public AudioOutBackend {
 public:
-    std::unique_ptr<PortBackend> Open(PortOut& port) override;
+    std::unique_ptr<DeviceBackend> Open(AudioOutDevice device, u32 sample_rate,
+                                        u32 period_frames) override;
+};
+
+/// Headless backend that discards the mix, or writes it to a WAV file per device when
+/// `dump_wav` is set. Used to measure mixing cost without an audio device.
+class NullAudioOut final : public AudioOutBackend {
+public:
+    explicit NullAudioOut(bool dump_wav) : dump_wav{dump_wav} {}
+
+    std::unique_ptr<DeviceBackend> Open(AudioOutDevice device, u32 sample_rate,
+                                        u32 period_frames) override;
+
+private:
+    bool dump_wav;
 };
 
 } // namespace Libraries::AudioOut
@@ -0,0 +1,248 @@
+// SPDX-FileCopyrightText: Copyright 2025 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+
+#include "common/logging/log.h"
+#include "common/thread.h"
+#include "core/libraries/audio/audioout.h"
+#include "core/libraries/audio/audioout_mixer.h"
+
+#ifdef __AVX2__
+#define AUDIO_MIXER_USE_AVX
+#include <immintrin.h>
+#endif
+
+namespace Libraries::AudioOut {
+
+namespace {
+
+template <typename T>
+inline float ToFloat(T sample) {
+    return static_cast<float>(sample);
+}
+
+template <typename T>
+void MixMono(const T* src, float* dst, u32 num_frames, float gain) {
+    // Mono ports are played back on both front channels, like SDL upmixes them.
+    for (u32 f = 0; f < num_frames; ++f, dst += MixChannels) {
+        const float sample = ToFloat(src[f]) * gain;
+        dst[0] += sample;
+        dst[1] += sample;
+    }
+}
+
+#ifdef AUDIO_MIXER_USE_AVX
+template <typename T>
+inline __m256 Load8(const T* src) {
+    if constexpr (std::is_same_v<T, s16>) {
+        const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+        return _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(s));
+    } else {
+        return _mm256_loadu_ps(src);
+    }
+}
+
+inline void AddPair(float* dst, __m128 pair) {
+    const __m128 acc = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(dst)));
+    _mm_store_sd(reinterpret_cast<double*>(dst), _mm_castps_pd(_mm_add_ps(acc, pair)));
+}
+#endif
+
+template <typename T>
+void MixStereo(const T* src, float* dst, u32 num_frames, float gain_l, float gain_r) {
+    u32 f = 0;
+#ifdef AUDIO_MIXER_USE_AVX
+    const __m256 gains = _mm256_setr_ps(gain_l, gain_r, gain_l, gain_r, gain_l, gain_r, gain_l,
+                                        gain_r);
+    for (; f + 4 <= num_frames; f += 4) {
+        const __m256 v = _mm256_mul_ps(Load8(src + f * 2), gains);
+        const __m128 lo = _mm256_castps256_ps128(v);
+        const __m128 hi = _mm256_extractf128_ps(v, 1);
+        AddPair(dst + (f + 0) * MixChannels, lo);
+        AddPair(dst + (f + 1) * MixChannels, _mm_movehl_ps(lo, lo));
+        AddPair(dst + (f + 2) * MixChannels, hi);
+        AddPair(dst + (f + 3) * MixChannels, _mm_movehl_ps(hi, hi));
+    }
+#endif
+    for (; f < num_frames; ++f) {
+        dst[f * MixChannels + 0] += ToFloat(src[f * 2 + 0]) * gain_l;
+        dst[f * MixChannels + 1] += ToFloat(src[f * 2 + 1]) * gain_r;
+    }
+}
+
+template <typename T>
+void Mix8Ch(const T* src, float* dst, u32 num_frames, const std::array<int, 8>& layout,
+            const std::array<float, MixChannels>& gains) {
+#ifdef AUDIO_MIXER_USE_AVX
+    // Gains are applied in source channel order, then the frame is permuted into bus order.
+    alignas(32) std::array<int, 8> gather{};
+    for (u32 c = 0; c < MixChannels; ++c) {
+        gather[layout[c]] = static_cast<int>(c);
+    }
+    const __m256i perm = _mm256_load_si256(reinterpret_cast<const __m256i*>(gather.data()));
+    const __m256 gain = _mm256_loadu_ps(gains.data());
+    for (u32 f = 0; f < num_frames; ++f, src += MixChannels, dst += MixChannels) {
+        const __m256 v = _mm256_permutevar8x32_ps(_mm256_mul_ps(Load8(src), gain), perm);
+        _mm256_storeu_ps(dst, _mm256_add_ps(_mm256_loadu_ps(dst), v));
+    }
+#else
+    for (u32 f = 0; f < num_frames; ++f, src += MixChannels, dst += MixChannels) {
+        for (u32 c = 0; c < MixChannels; ++c) {
+            dst[layout[c]] += ToFloat(src[c]) * gains[c];
+        }
+    }
+#endif
+}
+
+template <typename T>
+void MixFrames(const AudioFormatInfo& format, const T* src, float* dst, u32 num_frames,
+               const std::array<float, MixChannels>& gains) {
+    switch (format.num_channels) {
+    case 1:
+        MixMono(src, dst, num_frames, gains[0]);
+        break;
+    case 2:
+        MixStereo(src, dst, num_frames, gains[0], gains[1]);
+        break;
+    case 8:
+        Mix8Ch(src, dst, num_frames, format.channel_layout, gains);
+        break;
+    default:
+        UNREACHABLE_MSG("Unsupported audio channel count {}", format.num_channels);
+    }
+}
+
+} // Anonymous namespace
+
+void MixPortFrames(const AudioFormatInfo& format, const void* src, float* dst, u32 num_frames,
+                   const std::array<float, MixChannels>& gains) {
+    if (format.is_float) {
+        MixFrames(format, static_cast<const float*>(src), dst, num_frames, gains);
+    } else {
+        MixFrames(format, static_cast<const s16*>(src), dst, num_frames, gains);
+    }
+}
+
+AudioMixer::AudioMixer(std::unique_ptr<AudioOutBackend> backend_, std::span<PortOut> ports_)
+    : backend{std::move(backend_)}, ports{ports_} {
+    thread.Run([this](const std::stop_token& stop) { MixerThread(stop); });
+}
+
+AudioMixer::~AudioMixer() {
+    thread.Stop();
+    const auto stats = GetStats();
+    if (stats.periods != 0) {
+        LOG_INFO(Lib_AudioOut, "Mixed {} periods, average {} us, worst {} us", stats.periods,
+                 stats.mix_time_ns / stats.periods / 1000, stats.max_mix_time_ns / 1000);
+    }
+}
+
+void AudioMixer::OnPortOpened(AudioOutDevice device) {
+    std::scoped_lock lk{mutex};
+    auto& device_backend = devices[static_cast<u32>(device)];
+    if (!device_backend) {
+        device_backend = backend->Open(device, MixSampleRate, MixPeriodFrames);
+    }
+    ++num_open_ports;
+    cv.notify_one();
+}
+
+void AudioMixer::OnPortClosed() {
+    std::scoped_lock lk{mutex};
+    --num_open_ports;
+}
+
+AudioMixer::Stats AudioMixer::GetStats() const {
+    return Stats{
+        .periods = num_periods.load(std::memory_order_relaxed),
+        .mix_time_ns = mix_time_ns.load(std::memory_order_relaxed),
+        .max_mix_time_ns = max_mix_time_ns.load(std::memory_order_relaxed),
+    };
+}
+
+void AudioMixer::MixerThread(const std::stop_token& stop) {
+    Common::SetCurrentThreadName("shadPS4:AudioMixer");
+
+    Common::AccurateTimer timer(
+        std::chrono::nanoseconds(1000000000ULL * MixPeriodFrames / MixSampleRate));
+    while (!stop.stop_requested()) {
+        {
+            // Do not tick while no port is open.
+            std::unique_lock lk{mutex};
+            if (!cv.wait(lk, stop, [this] { return num_open_ports != 0; })) {
+                break;
+            }
+        }
+        timer.Start();
+        MixPeriod();
+        timer.End();
+    }
+}
+
+void AudioMixer::MixPeriod() {
+    const auto start = std::chrono::steady_clock::now();
+    const float master = master_volume.load(std::memory_order_relaxed);
+
+    // Channels used on each bus, zero while no port of the device played this period.
+    std::array<u32, static_cast<u32>(AudioOutDevice::Count)> bus_channels{};
+    for (auto& bus : buses) {
+        bus.fill(0.0f);
+    }
+
+    for (auto& port : ports) {
+        bool consumed = false;
+        {
+            std::unique_lock lock{port.mutex};
+            if (!port.IsOpen() || !port.output_ready) {
+                continue;
+            }
+            const auto& format = port.format_info;
+            const float scale = master / SCE_AUDIO_OUT_VOLUME_0DB / (format.is_float ? 1 : 32768);
+            std::array<float, MixChannels> gains{};
+            for (u32 c = 0; c < format.num_channels; ++c) {
+                gains[c] = static_cast<float>(port.volume[c]) * scale;
+            }
+
+            const u32 device = static_cast<u32>(port.device);
+            const auto* src = static_cast<const u8*>(port.output_buffer) +
+                              port.mixed_frames * format.FrameSize();
+            MixPortFrames(format, src, buses[device].data(), MixPeriodFrames, gains);
+            // Mono ports are mixed into both front channels.
+            bus_channels[device] =
+                std::max(bus_channels[device], format.num_channels > 2 ? MixChannels : 2u);
+
+            port.mixed_frames += MixPeriodFrames;
+            if (port.mixed_frames == port.buffer_frames) {
+                port.mixed_frames = 0;
+                port.output_ready = false;
+                consumed = true;
+            }
+        }
+        if (consumed) {
+            port.output_cv.notify_one();
+        }
+    }
+
+    {
+        std::scoped_lock lk{mutex};
+        for (u32 device = 0; device < devices.size(); ++device) {
+            if (bus_channels[device] != 0 && devices[device]) {
+                devices[device]->Output(buses[device].data(), MixPeriodFrames,
+                                        bus_channels[device]);
+            }
+        }
+    }
+
+    const u64 elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now() - start)
+                            .count();
+    num_periods.fetch_add(1, std::memory_order_relaxed);
+    mix_time_ns.fetch_add(elapsed, std::memory_order_relaxed);
+    if (elapsed > max_mix_time_ns.load(std::memory_order_relaxed)) {
+        max_mix_time_ns.store(elapsed, std::memory_order_relaxed);
+    }
+}
+
+} // namespace Libraries::AudioOut
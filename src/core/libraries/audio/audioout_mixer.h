@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: Copyright 2025 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <span>
+
+#include "core/libraries/audio/audioout_backend.h"
+#include "core/libraries/kernel/threads.h"
+
+namespace Libraries::AudioOut {
+
+struct PortOut;
+struct AudioFormatInfo;
+
+/// Number of interleaved channels in a mix bus.
+constexpr u32 MixChannels = 8;
+
+/// Frames mixed per period. Every valid port length is a multiple of this.
+constexpr u32 MixPeriodFrames = 256;
+
+constexpr u32 MixSampleRate = 48000;
+
+/// Converts `num_frames` frames of a port buffer to float, applies per-channel gains and
+/// accumulates them into an interleaved MixChannels bus.
+void MixPortFrames(const AudioFormatInfo& format, const void* src, float* dst, u32 num_frames,
+                   const std::array<float, MixChannels>& gains);
+
+/// Single thread that consumes the buffers of every open port, period by period, and feeds
+/// one host stream per device.
+class AudioMixer {
+public:
+    struct Stats {
+        u64 periods;
+        u64 mix_time_ns;
+        u64 max_mix_time_ns;
+    };
+
+    explicit AudioMixer(std::unique_ptr<AudioOutBackend> backend, std::span<PortOut> ports);
+    ~AudioMixer();
+
+    /// Makes sure the device of a port is open and wakes the mixer up.
+    void OnPortOpened(AudioOutDevice device);
+
+    void OnPortClosed();
+
+    void SetMasterVolume(float volume) {
+        master_volume.store(volume, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] Stats GetStats() const;
+
+private:
+    void MixerThread(const std::stop_token& stop);
+    void MixPeriod();
+
+    std::unique_ptr<AudioOutBackend> backend;
+    std::span<PortOut> ports;
+    std::array<std::unique_ptr<DeviceBackend>, static_cast<u32>(AudioOutDevice::Count)> devices{};
+    std::array<std::array<float, MixPeriodFrames * MixChannels>,
+               static_cast<u32>(AudioOutDevice::Count)>
+        buses{};
+    std::atomic<float> master_volume{1.0f};
+
+    std::mutex mutex;
+    std::condition_variable_any cv;
+    u32 num_open_ports{};
+    Kernel::Thread thread{};
+
+    std::atomic<u64> num_periods{};
+    std::atomic<u64> mix_time_ns{};
+    std::atomic<u64> max_mix_time_ns{};
+};
+
+} // namespace Libraries::AudioOut
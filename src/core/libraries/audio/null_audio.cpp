@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: Copyright 2025 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <fmt/format.h>
+
+#include "common/io_file.h"
+#include "common/logging/log.h"
+#include "common/path_util.h"
+#include "core/libraries/audio/audioout_backend.h"
+#include "core/libraries/audio/audioout_mixer.h"
+
+namespace Libraries::AudioOut {
+
+namespace {
+
+#pragma pack(push, 1)
+struct WavHeader {
+    char riff_id[4]{'R', 'I', 'F', 'F'};
+    u32 riff_size{};
+    char wave_id[4]{'W', 'A', 'V', 'E'};
+    char fmt_id[4]{'f', 'm', 't', ' '};
+    u32 fmt_size{16};
+    u16 format{3}; // WAVE_FORMAT_IEEE_FLOAT
+    u16 channels{};
+    u32 sample_rate{};
+    u32 byte_rate{};
+    u16 block_align{};
+    u16 bits_per_sample{32};
+    char data_id[4]{'d', 'a', 't', 'a'};
+    u32 data_size{};
+};
+#pragma pack(pop)
+static_assert(sizeof(WavHeader) == 44);
+
+class NullDeviceBackend final : public DeviceBackend {
+public:
+    void Output(const float* samples, u32 num_frames, u32 num_channels) override {}
+};
+
+class WavDeviceBackend final : public DeviceBackend {
+public:
+    explicit WavDeviceBackend(AudioOutDevice device, u32 sample_rate) {
+        const auto path = Common::FS::GetUserPath(Common::FS::PathType::LogDir) /
+                          fmt::format("audio_{}.wav", device == AudioOutDevice::PadSpk ? "padspk"
+                                                                                         : "main");
+        file.Open(path, Common::FS::FileAccessMode::Write);
+        if (!file.IsOpen()) {
+            LOG_ERROR(Lib_AudioOut, "Failed to open audio dump {}", path.string());
+            return;
+        }
+        LOG_INFO(Lib_AudioOut, "Writing audio output to {}", path.string());
+
+        header.channels = MixChannels;
+        header.sample_rate = sample_rate;
+        header.block_align = MixChannels * sizeof(float);
+        header.byte_rate = sample_rate * header.block_align;
+        file.WriteObject(header);
+    }
+
+    ~WavDeviceBackend() override {
+        if (!file.IsOpen()) {
+            return;
+        }
+        // Patch the chunk sizes now that the amount of data is known.
+        header.riff_size = sizeof(WavHeader) - 8 + header.data_size;
+        file.Seek(0);
+        file.WriteObject(header);
+    }
+
+    void Output(const float* samples, u32 num_frames, u32 num_channels) override {
+        if (!file.IsOpen()) {
+            return;
+        }
+        const std::span<const float> data{samples, num_frames * MixChannels};
+        header.data_size += static_cast<u32>(file.WriteSpan(data) * sizeof(float));
+    }
+
+private:
+    Common::FS::IOFile file;
+    WavHeader header{};
+};
+
+} // Anonymous namespace
+
+std::unique_ptr<DeviceBackend> NullAudioOut::Open(AudioOutDevice device, u32 sample_rate,
+                                                  u32 period_frames) {
+    if (dump_wav) {
+        return std::make_unique<WavDeviceBackend>(device, sample_rate);
+    }
+    return std::make_unique<NullDeviceBackend>();
+}
+
+} // namespace Libraries::AudioOut
@@ -3,6 +3,7 @@
 
 #include <algorithm>
 #include <thread>
+#include <vector>
 #include <SDL3/SDL_audio.h>
 #include <SDL3/SDL_hints.h>
 
@@ -10,22 +11,22 @@
 #include "common/logging/log.h"
 #include "core/libraries/audio/audioout.h"
 #include "core/libraries/audio/audioout_backend.h"
+#include "core/libraries/audio/audioout_mixer.h"
 
 #define SDL_INVALID_AUDIODEVICEID 0 // Defined in SDL_audio.h but not made a macro
 namespace Libraries::AudioOut {
 
-class SDLPortBackend : public PortBackend {
+class SDLDeviceBackend : public DeviceBackend {
 public:
-    explicit SDLPortBackend(const PortOut& port)
-        : frame_size(port.format_info.FrameSize()), guest_buffer_size(port.BufferSize()) {
-        const SDL_AudioSpec fmt = {
-            .format = port.format_info.is_float ? SDL_AUDIO_F32LE : SDL_AUDIO_S16LE,
-            .channels = port.format_info.num_channels,
-            .freq = static_cast<int>(port.sample_rate),
-        };
+    explicit SDLDeviceBackend(AudioOutDevice device, u32 sample_rate_, u32 period_frames_)
+        : sample_rate{sample_rate_}, period_frames{period_frames_} {
+        // Start with a stereo bus, most games never open a wider port. The stream is switched to
+        // 7.1 while a surround port is playing, SDL converts either to the device layout.
+        SetBusChannels(2);
+        const SDL_AudioSpec fmt = GetBusSpec();
 
-        // Determine port type
-        std::string port_name = port.type == OrbisAudioOutPort::PadSpk
+        // Determine device type
+        std::string port_name = device == AudioOutDevice::PadSpk
                                     ? Config::getPadSpkOutputDevice()
                                     : Config::getMainOutputDevice();
         SDL_AudioDeviceID dev_id = SDL_INVALID_AUDIODEVICEID;
@@ -64,24 +65,15 @@ public:
             return;
         }
         CalculateQueueThreshold();
-        if (!SDL_SetAudioStreamInputChannelMap(stream, port.format_info.channel_layout.data(),
-                                               port.format_info.num_channels)) {
-            LOG_ERROR(Lib_AudioOut, "Failed to configure SDL audio stream channel map: {}",
-                      SDL_GetError());
-            SDL_DestroyAudioStream(stream);
-            stream = nullptr;
-            return;
-        }
         if (!SDL_ResumeAudioStreamDevice(stream)) {
             LOG_ERROR(Lib_AudioOut, "Failed to resume SDL audio stream: {}", SDL_GetError());
             SDL_DestroyAudioStream(stream);
             stream = nullptr;
             return;
         }
-        SDL_SetAudioStreamGain(stream, Config::getVolumeSlider() / 100.0f);
     }
 
-    ~SDLPortBackend() override {
+    ~SDLDeviceBackend() override {
         if (!stream) {
             return;
         }
@@ -89,10 +81,19 @@ public:
         stream = nullptr;
     }
 
-    void Output(void* ptr) override {
+    void Output(const float* samples, u32 num_frames, u32 num_channels) override {
         if (!stream) {
             return;
         }
+        if (num_channels != bus_channels) {
+            SetBusChannels(num_channels);
+            const SDL_AudioSpec fmt = GetBusSpec();
+            if (!SDL_SetAudioStreamFormat(stream, &fmt, nullptr)) {
+                LOG_ERROR(Lib_AudioOut, "Failed to change SDL audio stream format: {}",
+                          SDL_GetError());
+            }
+            CalculateQueueThreshold();
+        }
         // AudioOut library manages timing, but we still need to guard against the SDL
         // audio queue stalling, which may happen during device changes, for example.
         // Otherwise, latency may grow over time unbounded.
@@ -103,25 +104,36 @@ public:
             // Recalculate the threshold in case this happened because of a device change.
             CalculateQueueThreshold();
         }
-        if (!SDL_PutAudioStreamData(stream, ptr, static_cast<int>(guest_buffer_size))) {
+        if (num_channels < MixChannels) {
+            // Only the leading channels of the bus carry sound, pass just those to SDL so it
+            // does not treat the frames as 7.1 and scale the front channels down.
+            packed.resize(num_frames * num_channels);
+            for (u32 f = 0; f < num_frames; ++f) {
+                std::copy_n(samples + f * MixChannels, num_channels,
+                            packed.data() + f * num_channels);
+            }
+            samples = packed.data();
+        }
+        if (!SDL_PutAudioStreamData(stream, samples, static_cast<int>(num_frames * frame_size))) {
             LOG_ERROR(Lib_AudioOut, "Failed to output to SDL audio stream: {}", SDL_GetError());
         }
     }
 
-    void SetVolume(const std::array<int, 8>& ch_volumes) override {
-        if (!stream) {
-            return;
-        }
-        // SDL does not have per-channel volumes, for now just take the maximum of the channels.
-        const auto vol = *std::ranges::max_element(ch_volumes);
-        if (!SDL_SetAudioStreamGain(stream, static_cast<float>(vol) / SCE_AUDIO_OUT_VOLUME_0DB *
-                                                Config::getVolumeSlider() / 100.0f)) {
-            LOG_WARNING(Lib_AudioOut, "Failed to change SDL audio stream volume: {}",
-                        SDL_GetError());
-        }
+private:
+    void SetBusChannels(u32 num_channels) {
+        bus_channels = num_channels;
+        frame_size = num_channels * sizeof(float);
+        mix_buffer_size = period_frames * frame_size;
+    }
+
+    [[nodiscard]] SDL_AudioSpec GetBusSpec() const {
+        return SDL_AudioSpec{
+            .format = SDL_AUDIO_F32LE,
+            .channels = static_cast<int>(bus_channels),
+            .freq = static_cast<int>(sample_rate),
+        };
     }
 
-private:
     void CalculateQueueThreshold() {
         SDL_AudioSpec discard;
         int sdl_buffer_frames;
@@ -132,25 +144,30 @@ private:
             sdl_buffer_frames = 0;
         }
         const auto sdl_buffer_size = sdl_buffer_frames * frame_size;
-        const auto new_threshold = std::max(guest_buffer_size, sdl_buffer_size) * 4;
+        const auto new_threshold = std::max(mix_buffer_size, sdl_buffer_size) * 4;
         if (host_buffer_size != sdl_buffer_size || queue_threshold != new_threshold) {
             host_buffer_size = sdl_buffer_size;
             queue_threshold = new_threshold;
             LOG_INFO(Lib_AudioOut,
-                     "SDL audio buffers: guest = {} bytes, host = {} bytes, threshold = {} bytes",
-                     guest_buffer_size, host_buffer_size, queue_threshold);
+                     "SDL audio buffers: mix = {} bytes, host = {} bytes, threshold = {} bytes",
+                     mix_buffer_size, host_buffer_size, queue_threshold);
         }
     }
 
-    u32 frame_size;
-    u32 guest_buffer_size;
+    u32 sample_rate;
+    u32 period_frames;
+    u32 bus_channels{};
+    u32 frame_size{};
+    u32 mix_buffer_size{};
     u32 host_buffer_size{};
     u32 queue_threshold{};
     SDL_AudioStream* stream{};
+    std::vector<float> packed;
 };
 
-std::unique_ptr<PortBackend> SDLAudioOut::Open(PortOut& port) {
-    return std::make_unique<SDLPortBackend>(port);
+std::unique_ptr<DeviceBackend> SDLAudioOut::Open(AudioOutDevice device, u32 sample_rate,
+                                                 u32 period_frames) {
+    return std::make_unique<SDLDeviceBackend>(device, sample_rate, period_frames);
 }
 
 } // namespace Libraries::AudioOut
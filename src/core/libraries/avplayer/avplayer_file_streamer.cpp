@@ -2,7 +2,12 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm> // std::max, std::min
+#include <chrono>
+#include <cstring>
 #include <magic_enum/magic_enum.hpp>
+#include "common/config.h"
+#include "common/logging/log.h"
+#include "common/thread.h"
 #include "core/libraries/avplayer/avplayer_file_streamer.h"
 
 extern "C" {
@@ -18,6 +23,12 @@ AvPlayerFileStreamer::AvPlayerFileStreamer(const AvPlayerFileReplacement& file_r
     : m_file_replacement(file_replacement) {}
 
 AvPlayerFileStreamer::~AvPlayerFileStreamer() {
+    // The reader thread calls into the guest file callbacks, stop it before closing the file.
+    m_reader_thread.Stop();
+    if (!m_chunks.empty()) {
+        LOG_INFO(Lib_AvPlayer, "Read-ahead: {} reads, {} stalled for {} ms, {} restarts", m_reads,
+                 m_stalls, m_stall_us / 1000, m_restarts);
+    }
     if (m_avio_context != nullptr) {
         avio_context_free(&m_avio_context);
     }
@@ -40,10 +51,20 @@ bool AvPlayerFileStreamer::Init(std::string_view path) {
     m_avio_context =
         avio_alloc_context(avio_buffer, AVPLAYER_AVIO_BUFFER_SIZE, 0, this,
                            &AvPlayerFileStreamer::ReadPacket, nullptr, &AvPlayerFileStreamer::Seek);
+
+    const u32 num_chunks = std::min(Config::getAvPlayerReadAhead(), MaxReadAheadChunks);
+    if (num_chunks != 0) {
+        m_chunks.resize(num_chunks);
+        for (auto& chunk : m_chunks) {
+            chunk.data.resize(ReadAheadChunkSize);
+        }
+        m_reader_thread.Run([this](std::stop_token stop) { this->ReaderThread(stop); });
+    }
     return true;
 }
 
 void AvPlayerFileStreamer::Reset() {
+    // The ring is restarted lazily by the next read, as it no longer matches the position.
     m_position = 0;
 }
 
@@ -55,9 +76,8 @@ s32 AvPlayerFileStreamer::ReadPacket(void* opaque, u8* buffer, s32 size) {
     if (self->m_position + size > self->m_file_size) {
         size = self->m_file_size - self->m_position;
     }
-    const auto read_offset = self->m_file_replacement.read_offset;
-    const auto ptr = self->m_file_replacement.object_ptr;
-    const auto bytes_read = read_offset(ptr, buffer, self->m_position, size);
+    const auto bytes_read =
+        self->m_chunks.empty() ? self->ReadDirect(buffer, size) : self->ReadBuffered(buffer, size);
     if (bytes_read == 0 && size != 0) {
         return AVERROR_EOF;
     }
@@ -65,6 +85,105 @@ s32 AvPlayerFileStreamer::ReadPacket(void* opaque, u8* buffer, s32 size) {
     return bytes_read;
 }
 
+s32 AvPlayerFileStreamer::ReadDirect(u8* buffer, s32 size) {
+    const auto read_offset = m_file_replacement.read_offset;
+    const auto ptr = m_file_replacement.object_ptr;
+    return read_offset(ptr, buffer, m_position, size);
+}
+
+s32 AvPlayerFileStreamer::ReadBuffered(u8* buffer, s32 size) {
+    std::unique_lock lock{m_mutex};
+    ++m_reads;
+
+    // Drop the chunks the demuxer has moved past.
+    while (m_count != 0) {
+        const Chunk& chunk = m_chunks[m_head];
+        if (m_position < chunk.offset + chunk.size) {
+            break;
+        }
+        m_head = (m_head + 1) % m_chunks.size();
+        --m_count;
+        m_reader_cv.notify_one();
+    }
+    const u64 buffered_begin = m_count != 0 ? m_chunks[m_head].offset : m_fetch_offset;
+    if (m_position < buffered_begin || m_position > m_fetch_offset) {
+        RestartReadAhead(m_position);
+    }
+
+    if (m_count == 0 && !m_reader_eof) {
+        ++m_stalls;
+        const auto start = std::chrono::steady_clock::now();
+        m_data_cv.wait(lock, [this] { return m_count != 0 || m_reader_eof; });
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        m_stall_us += std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    }
+
+    // Copy whatever is contiguous from the position, the demuxer asks again for the rest.
+    s32 bytes_read = 0;
+    u32 index = m_head;
+    for (u32 i = 0; i < m_count && bytes_read < size; i++) {
+        const Chunk& chunk = m_chunks[index];
+        const u64 position = m_position + bytes_read;
+        const u64 chunk_offset = position - chunk.offset;
+        const u32 copy_size = static_cast<u32>(
+            std::min<u64>(chunk.size - chunk_offset, static_cast<u64>(size - bytes_read)));
+        std::memcpy(buffer + bytes_read, chunk.data.data() + chunk_offset, copy_size);
+        bytes_read += copy_size;
+        index = (index + 1) % m_chunks.size();
+    }
+    return bytes_read;
+}
+
+void AvPlayerFileStreamer::RestartReadAhead(u64 offset) {
+    m_head = 0;
+    m_count = 0;
+    m_fetch_offset = offset;
+    m_reader_eof = false;
+    ++m_generation;
+    ++m_restarts;
+    m_reader_cv.notify_one();
+}
+
+void AvPlayerFileStreamer::ReaderThread(std::stop_token stop) {
+    Common::SetCurrentThreadName("shadPS4:AvFileReader");
+
+    const auto read_offset = m_file_replacement.read_offset;
+    const auto ptr = m_file_replacement.object_ptr;
+    std::unique_lock lock{m_mutex};
+    while (true) {
+        // Backpressure: only fetch while the ring has a free slot.
+        const bool has_work = m_reader_cv.wait(lock, stop, [this] {
+            return m_count < m_chunks.size() && m_fetch_offset < m_file_size && !m_reader_eof;
+        });
+        if (!has_work) {
+            break;
+        }
+        const u64 generation = m_generation;
+        const u64 offset = m_fetch_offset;
+        Chunk& chunk = m_chunks[(m_head + m_count) % m_chunks.size()];
+        const u32 size = static_cast<u32>(std::min<u64>(ReadAheadChunkSize, m_file_size - offset));
+
+        // Only this thread writes to slots outside of the filled range, so the read can run
+        // without the lock while the demuxer consumes the filled chunks.
+        lock.unlock();
+        const s32 bytes_read = read_offset(ptr, chunk.data.data(), offset, size);
+        lock.lock();
+
+        if (generation != m_generation) {
+            continue;
+        }
+        if (bytes_read <= 0) {
+            m_reader_eof = true;
+        } else {
+            chunk.offset = offset;
+            chunk.size = static_cast<u32>(bytes_read);
+            m_fetch_offset += chunk.size;
+            ++m_count;
+        }
+        m_data_cv.notify_one();
+    }
+}
+
 s64 AvPlayerFileStreamer::Seek(void* opaque, s64 offset, int whence) {
     const auto self = reinterpret_cast<AvPlayerFileStreamer*>(opaque);
     if (whence & AVSEEK_SIZE) {
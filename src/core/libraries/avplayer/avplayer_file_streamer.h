@@ -3,9 +3,14 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <mutex>
 #include <string_view>
+#include <vector>
+
 #include "core/libraries/avplayer/avplayer.h"
 #include "core/libraries/avplayer/avplayer_data_streamer.h"
+#include "core/libraries/kernel/threads.h"
 
 struct AVIOContext;
 
@@ -24,15 +29,50 @@ public:
     }
 
 private:
+    static constexpr u32 ReadAheadChunkSize = 64_KB;
+    static constexpr u32 MaxReadAheadChunks = 256;
+
+    struct Chunk {
+        std::vector<u8> data;
+        u64 offset{};
+        u32 size{};
+    };
+
     static s32 ReadPacket(void* opaque, u8* buffer, s32 size);
     static s64 Seek(void* opaque, s64 buffer, int whence);
 
+    s32 ReadDirect(u8* buffer, s32 size);
+    s32 ReadBuffered(u8* buffer, s32 size);
+
+    /// Drops every buffered chunk and restarts fetching at the given offset. Requires m_mutex.
+    void RestartReadAhead(u64 offset);
+
+    /// Fills free ring slots with the guest file callbacks, ahead of the demuxer.
+    void ReaderThread(std::stop_token stop);
+
     AvPlayerFileReplacement m_file_replacement;
 
     int m_fd = -1;
     u64 m_position{};
     u64 m_file_size{};
     AVIOContext* m_avio_context{};
+
+    // Read-ahead ring, filled by the reader thread and drained by ReadPacket. Chunks in
+    // [m_head, m_head + m_count) hold consecutive file data starting at m_chunks[m_head].offset.
+    std::vector<Chunk> m_chunks;
+    u32 m_head{};
+    u32 m_count{};
+    u64 m_fetch_offset{};    ///< File offset of the next chunk to fetch
+    u64 m_generation{};      ///< Bumped on every restart to drop reads that are in flight
+    bool m_reader_eof{};     ///< The guest callback returned no data before the end of file
+    u64 m_reads{};           ///< ReadPacket calls served from the ring
+    u64 m_stalls{};          ///< Reads that had to wait for the reader thread
+    u64 m_stall_us{};        ///< Time spent waiting for the reader thread
+    u64 m_restarts{};        ///< Restarts caused by seeks outside of the buffered range
+    std::mutex m_mutex;
+    std::condition_variable_any m_reader_cv;
+    std::condition_variable m_data_cv;
+    Kernel::Thread m_reader_thread{};
 };
 
 } // namespace Libraries::AvPlayer
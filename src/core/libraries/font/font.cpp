@@ -1,21 +1,201 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <bit>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+
+#include "common/io_file.h"
 #include "common/logging/log.h"
+#include "common/singleton.h"
+#include "core/file_sys/fs.h"
 #include "core/libraries/error_codes.h"
 #include "core/libraries/font/font.h"
+#include "core/libraries/font/font_face.h"
+#include "core/libraries/font/glyph_cache.h"
 #include "core/libraries/libs.h"
 #include "font_error.h"
 
 namespace Libraries::Font {
 
-s32 PS4_SYSV_ABI sceFontAttachDeviceCacheBuffer() {
-    LOG_ERROR(Lib_Font, "(STUBBED) called");
+namespace {
+
+constexpr u32 LibraryMagic = 0x0F01;
+constexpr u32 RendererMagic = 0x0F02;
+constexpr u32 FontMagic = 0x0F03;
+constexpr u32 DefaultDpi = 72;
+
+struct FontInstance;
+
+/// Guards the links between libraries and the fonts opened from them.
+std::mutex g_open_fonts_mutex;
+
+struct FontLibrary {
+    u32 magic = LibraryMagic;
+    std::mutex mutex;
+    GlyphCache cache;
+    void* cache_buffer{};
+    u32 cache_buffer_size{};
+    u64 next_face_id = 1;
+    std::unordered_set<FontInstance*> open_fonts; ///< Guarded by g_open_fonts_mutex
+};
+
+struct FontRenderer {
+    u32 magic = RendererMagic;
+};
+
+struct FontInstance {
+    u32 magic = FontMagic;
+    FontLibrary* library; ///< Null once the library was destroyed
+    std::shared_ptr<FontFace> face;
+    u64 face_id;
+    FontRenderer* renderer{};
+    float scale_w{};
+    float scale_h{};
+    float render_scale_w{};
+    float render_scale_h{};
+    u32 dpi_h = DefaultDpi;
+    u32 dpi_v = DefaultDpi;
+};
+
+FontLibrary* ToLibrary(OrbisFontLib library) {
+    auto* lib = static_cast<FontLibrary*>(library);
+    return lib && lib->magic == LibraryMagic ? lib : nullptr;
+}
+
+FontRenderer* ToRenderer(OrbisFontRenderer renderer) {
+    auto* rend = static_cast<FontRenderer*>(renderer);
+    return rend && rend->magic == RendererMagic ? rend : nullptr;
+}
+
+FontInstance* ToFont(OrbisFontHandle fontHandle) {
+    auto* font = static_cast<FontInstance*>(fontHandle);
+    return font && font->magic == FontMagic ? font : nullptr;
+}
+
+s32 OpenFace(FontLibrary* lib, std::shared_ptr<FontFace> face, OrbisFontHandle* pFontHandle) {
+    if (!face) {
+        LOG_ERROR(Lib_Font, "Unsupported font data");
+        return ORBIS_FONT_ERROR_NO_SUPPORT_FORMAT;
+    }
+    auto* font = new FontInstance{
+        .library = lib,
+        .face = std::move(face),
+    };
+    {
+        std::scoped_lock lk{lib->mutex};
+        font->face_id = lib->next_face_id++;
+    }
+    {
+        std::scoped_lock lk{g_open_fonts_mutex};
+        lib->open_fonts.insert(font);
+    }
+    *pFontHandle = font;
     return ORBIS_OK;
 }
 
-s32 PS4_SYSV_ABI sceFontBindRenderer() {
-    LOG_ERROR(Lib_Font, "(STUBBED) called");
+/// Render scale of the font, falling back to its layout scale when none was set up.
+std::pair<float, float> GetRenderScale(const FontInstance* font) {
+    if (font->render_scale_w > 0.0f && font->render_scale_h > 0.0f) {
+        return {font->render_scale_w, font->render_scale_h};
+    }
+    return {font->scale_w, font->scale_h};
+}
+
+s32 GetGlyphMetrics(const FontInstance* font, u32 code, float scale_w, float scale_h,
+                    OrbisFontGlyphMetrics* metrics, u32& glyph) {
+    if (scale_w <= 0.0f || scale_h <= 0.0f) {
+        LOG_ERROR(Lib_Font, "Font scale is not set");
+        return ORBIS_FONT_ERROR_UNSET_PARAMETER;
+    }
+    glyph = font->face->FindGlyph(code);
+    if (glyph == 0) {
+        LOG_DEBUG(Lib_Font, "No glyph for code {:#x}", code);
+        return ORBIS_FONT_ERROR_NO_SUPPORT_GLYPH;
+    }
+    if (!metrics) {
+        return ORBIS_OK;
+    }
+    const GlyphLayout layout = font->face->GetGlyphLayout(glyph, scale_w, scale_h);
+    const LineLayout line = font->face->GetLineLayout(scale_h);
+    metrics->width = layout.width;
+    metrics->height = layout.height;
+    metrics->horizontal.bearingX = layout.bearing_x;
+    metrics->horizontal.bearingY = layout.bearing_y;
+    metrics->horizontal.advance = layout.advance;
+    // Vertical writing centers the glyph on the pen and advances by one line.
+    metrics->vertical.bearingX = -layout.width / 2.0f;
+    metrics->vertical.bearingY = 0.0f;
+    metrics->vertical.advance = line.line_height;
+    return ORBIS_OK;
+}
+
+void BlitGlyph(const GlyphBitmap& bitmap, OrbisFontRenderSurface* surf, s32 left, s32 top,
+               OrbisFontRenderOutput* result) {
+    const s32 x0 = std::max(left, static_cast<s32>(surf->sc_x0));
+    const s32 y0 = std::max(top, static_cast<s32>(surf->sc_y0));
+    const s32 x1 = std::min(left + bitmap.width, static_cast<s32>(surf->sc_x1));
+    const s32 y1 = std::min(top + bitmap.height, static_cast<s32>(surf->sc_y1));
+    if (x0 >= x1 || y0 >= y1) {
+        return;
+    }
+    const u32 pixel_size = static_cast<u32>(surf->pixelSizeByte);
+    auto* buffer = static_cast<u8*>(surf->buffer);
+    for (s32 y = y0; y < y1; y++) {
+        const u8* src = &bitmap.pixels[(y - top) * bitmap.width + (x0 - left)];
+        u8* dst = buffer + static_cast<size_t>(y) * surf->widthByte + x0 * pixel_size;
+        // Neighbouring glyph boxes may overlap, keep the coverage of both.
+        for (s32 x = x0; x < x1; x++, src++) {
+            for (u32 c = 0; c < pixel_size; c++, dst++) {
+                *dst = std::max(*dst, *src);
+            }
+        }
+    }
+    if (result) {
+        result->updateRect.x = static_cast<u32>(x0);
+        result->updateRect.y = static_cast<u32>(y0);
+        result->updateRect.w = static_cast<u32>(x1 - x0);
+        result->updateRect.h = static_cast<u32>(y1 - y0);
+    }
+}
+
+} // Anonymous namespace
+
+s32 PS4_SYSV_ABI sceFontAttachDeviceCacheBuffer(OrbisFontLib library, void* buffer, u32 size) {
+    auto* lib = ToLibrary(library);
+    if (!lib) {
+        return ORBIS_FONT_ERROR_INVALID_LIBRARY;
+    }
+    if (size == 0) {
+        return ORBIS_FONT_ERROR_INVALID_PARAMETER;
+    }
+    std::scoped_lock lk{lib->mutex};
+    if (lib->cache_buffer_size != 0) {
+        return ORBIS_FONT_ERROR_ALREADY_ATTACHED;
+    }
+    // Glyphs live in host memory, the guest buffer only sets how many of them are kept.
+    lib->cache_buffer = buffer;
+    lib->cache_buffer_size = size;
+    lib->cache.SetCapacity(size);
+    LOG_INFO(Lib_Font, "Attached {:#x} byte glyph cache", size);
+    return ORBIS_OK;
+}
+
+s32 PS4_SYSV_ABI sceFontBindRenderer(OrbisFontHandle fontHandle, OrbisFontRenderer renderer) {
+    auto* font = ToFont(fontHandle);
+    if (!font) {
+        return ORBIS_FONT_ERROR_INVALID_FONT_HANDLE;
+    }
+    auto* rend = ToRenderer(renderer);
+    if (!rend) {
+        return ORBIS_FONT_ERROR_INVALID_RENDERER;
+    }
+    if (font->renderer) {
+        return ORBIS_FONT_ERROR_ALREADY_BOUND_RENDERER;
+    }
+    font->renderer = rend;
     return ORBIS_OK;
 }
 
@@ -112,13 +292,33 @@ s32 PS4_SYSV_ABI sceFontCharactersRefersTextCodes() {
     return ORBIS_OK;
 }
 
-s32 PS4_SYSV_ABI sceFontClearDeviceCache() {
-    LOG_ERROR(Lib_Font, "(STUBBED) called");
+s32 PS4_SYSV_ABI sceFontClearDeviceCache(OrbisFontLib library) {
+    auto* lib = ToLibrary(library);
+    if (!lib) {
+        return ORBIS_FONT_ERROR_INVALID_LIBRARY;
+    }
+    std::scoped_lock lk{lib->mutex};
+    lib->cache.Clear();
     return ORBIS_OK;
 }
 
-s32 PS4_SYSV_ABI sceFontCloseFont() {
-    LOG_ERROR(Lib_Font, "(STUBBED) called");
+s32 PS4_SYSV_ABI sceFontCloseFont(OrbisFontHandle fontHandle) {
+    auto* font = ToFont(fontHandle);
+    if (!font) {
+        return ORBIS_FONT_ERROR_INVALID_FONT_HANDLE;
+    }
+    {
+        std::scoped_lock lk{g_open_fonts_mutex};
+        if (auto* lib = font->library) {
+            lib->open_fonts.erase(font);
+            std::scoped_lock lib_lk{lib->mutex};
+            if (font->face.use_count() == 1) {
+                lib->cache.EraseFace(font->face_id);
+            }
+        }
+    }
+    font->magic = 0;
+    delete font;
     return ORBIS_OK;
 }
 
@@ -142,23 +342,33 @@ s32 PS4_SYSV_ABI sceFontCreateGraphicsServiceWithEdition() {
     return ORBIS_OK;
 }
 
-s32 PS4_SYSV_ABI sceFontCreateLibrary() {
-    LOG_ERROR(Lib_Font, "(STUBBED) called");
-    return ORBIS_OK;
+s32 PS4_SYSV_ABI sceFontCreateLibrary(const void* memory, const void* selection,
+                                      OrbisFontLib* pLibrary) {
+    return sceFontCreateLibraryWithEdition(memory, selection, 0, pLibrary);
 }
 
-s32 PS4_SYSV_ABI sceFontCreateLibraryWithEdition() {
-    LOG_ERROR(Lib_Font, "(STUBBED) called");
+s32 PS4_SYSV_ABI sceFontCreateLibraryWithEdition(const void* memory, const void* selection,
+                                                 u64 edition, OrbisFontLib* pLibrary) {
+    LOG_INFO(Lib_Font, "edition = {:#x}", edition);
+    if (!pLibrary) {
+        return ORBIS_FONT_ERROR_INVALID_PARAMETER;
+    }
+    *pLibrary = new FontLibrary();
     return ORBIS_OK;
 }
 
-s32 PS4_SYSV_ABI sceFontCreateRenderer() {
-    LOG_ERROR(Lib_Font, "(STUBBED) called");
-    return ORBIS_OK;
+s32 PS4_SYSV_ABI sceFontCreateRenderer(const void* memory, const void* selection,
+                                       OrbisFontRenderer* pRenderer) {
+    return sceFontCreateRendererWithEdition(memory, selection, 0, pRenderer);
 }
 
-s32 PS4_SYSV_ABI sceFontCreateRendererWithEdition() {
-    LOG_ERROR(Lib_Font, "(STUBBED) called");
+s32 PS4_SYSV_ABI sceFontCreateRendererWithEdition(const void* memory, const void* selection,
+                                                  u64 edition, OrbisFontRenderer* pRenderer) {
+    LOG_INFO(Lib_Font, "edition = {:#x}", edition);
+    if (!pRenderer) {
+        return ORBIS_FONT_ERROR_INVALID_PARAMETER;
+    }
+    *pRenderer = new FontRenderer();
     return ORBIS_OK;
 }
 
@@ -197,13 +407,46 @@ s32 PS4_SYSV_ABI sceFontDestroyGraphicsService() {
     return ORBIS_OK;
 }
 
-s32 PS4_SYSV_ABI sceFontDestroyLibrary() {
-    LOG_ERROR(Lib_Font, "(STUBBED) called");
+s32 PS4_SYSV_ABI sceFontDestroyLibrary(OrbisFontLib* pLibrary) {
+    if (!pLibrary) {
+        return ORBIS_FONT_ERROR_INVALID_PARAMETER;
+    }
+    auto* lib = ToLibrary(*pLibrary);
+    if (!lib) {
+        return ORBIS_FONT_ERROR_INVALID_LIBRARY;
+    }
+    {
+        // Fonts left open keep their handles valid but can no longer render.
+        std::scoped_lock lk{g_open_fonts_mutex};
+        if (!lib->open_fonts.empty()) {
+            LOG_WARNING(Lib_Font, "Destroying library with {} open fonts", lib->open_fonts.size());
+        }
+        for (auto* font : lib->open_fonts) {
+            font->library = nullptr;
+        }
+        // Wait for renders that picked up the library before it was detached.
+        std::scoped_lock lib_lk{lib->mutex};
+    }
+    const auto stats = lib->cache.GetStats();
+    LOG_INFO(Lib_Font, "Glyph cache: {} hits, {} misses, {} evictions", stats.hits, stats.misses,
+             stats.evictions);
+    lib->magic = 0;
+    delete lib;
+    *pLibrary = nullptr;
     return ORBIS_OK;
 }
 
-s32 PS4_SYSV_ABI sceFontDestroyRenderer() {
-    LOG_ERROR(Lib_Font, "(STUBBED) called");
+s32 PS4_SYSV_ABI sceFontDestroyRenderer(OrbisFontRenderer* pRenderer) {
+    if (!pRenderer) {
+        return ORBIS_FONT_ERROR_INVALID_PARAMETER;
+    }
+    auto* rend = ToRenderer(*pRenderer);
+    if (!rend) {
+        return ORBIS_FONT_ERROR_INVALID_RENDERER;
+    }
+    rend->magic = 0;
+    delete rend;
+    *pRenderer = nullptr;
     return ORBIS_OK;
 }
 
@@ -222,8 +465,19 @@ s32 PS4_SYSV_ABI sceFontDestroyWritingLine() {
     return ORBIS_OK;
 }
 
-s32 PS4_SYSV_ABI sceFontDettachDeviceCacheBuffer() {
-    LOG_ERROR(Lib_Font, "(STUBBED) called");
+s32 PS4_SYSV_ABI sceFontDettachDeviceCacheBuffer(OrbisFontLib library) {
+    auto* lib = ToLibrary(library);
+    if (!lib) {
+        return ORBIS_FONT_ERROR_INVALID_LIBRARY;
+    }
+    std::scoped_lock lk{lib->mutex};
+    if (lib->cache_buffer_size == 0) {
+        return ORBIS_FONT_ERROR_NOT_ATTACHED_CACHE_BUFFER;
+    }
+    lib->cache_buffer = nullptr;
+    lib->cache_buffer_size = 0;
+    lib->cache.Clear();
+    lib->cache.SetCapacity(GlyphCache::DefaultCapacity);
     return ORBIS_OK;
 }
 
@@ -242,9 +496,17 @@ s32 PS4_SYSV_ABI sceFontGetCharGlyphCode() {
     return ORBIS_OK;
 }
 
-s32 PS4_SYSV_ABI sceFontGetCharGlyphMetrics() {
-    LOG_ERROR(Lib_Font, "(STUBBED) called");
-    return ORBIS_OK;
+s32 PS4_SYSV_ABI sceFontGetCharGlyphMetrics(OrbisFontHandle fontHandle, u32 code,
+                                            OrbisFontGlyphMetrics* metrics) {
+    auto* font = ToFont(fontHandle);
+    if (!font) {
+        return ORBIS_FONT_ERROR_INVALID_FONT_HANDLE;
+    }
+    if (!metrics) {
+        return ORBIS_FONT_ERROR_INVALID_PARAMETER;
+    }
+    u32 glyph{};
+    return GetGlyphMetrics(font, code, font->scale_w, font->scale_h, metrics, glyph);
 }
 
 s32 PS4_SYSV_ABI sceFontGetEffectSlant() {
@@ -257,8 +519,15 @@ s32 PS4_SYSV_ABI sceFontGetEffectWeight() {
     return ORBIS_OK;
 }
 
-s32 PS4_SYSV_ABI sceFontGetFontGlyphsCount() {
-    LOG_ERROR(Lib_Font, "(STUBBED) called");
+s32 PS4_SYSV_ABI sceFontGetFontGlyphsCount(OrbisFontHandle fontHandle, u32* count) {
+    auto* font = ToFont(fontHandle);
+    if (!font) {
+        return ORBIS_FONT_ERROR_INVALID_FONT_HANDLE;
+    }
+    if (!count) {
+        return ORBIS_FONT_ERROR_INVALID_PARAMETER;
+    }
+    *count = font->face->NumGlyphs();
     return ORBIS_OK;
 }
 
@@ -287,8 +556,22 @@ s32 PS4_SYSV_ABI sceFontGetGlyphExpandBufferState() {
     return ORBIS_OK;
 }
 
-s32 PS4_SYSV_ABI sceFontGetHorizontalLayout() {
-    LOG_ERROR(Lib_Font, "(STUBBED) called");
+s32 PS4_SYSV_ABI sceFontGetHorizontalLayout(OrbisFontHandle fontHandle,
+                                            OrbisFontHorizontalLayout* layout) {
+    auto* font = ToFont(fontHandle);
+    if (!font) {
+        return ORBIS_FONT_ERROR_INVALID_FONT_HANDLE;
+    }
+    if (!layout) {
+        return ORBIS_FONT_ERROR_INVALID_PARAMETER;
+    }
+    if (font->scale_h <= 0.0f) {
+        return ORBIS_FONT_ERROR_UNSET_PARAMETER;
+    }
+    const LineLayout line = font->face->GetLineLayout(font->scale_h);
+    layout->baseLineY = line.baseline_y;
+    layout->lineHeight = line.line_height;
+    layout->effectHeight = 0.0f;
     return ORBIS_OK;
 }
 
@@ -307,9 +590,18 @@ s32 PS4_SYSV_ABI sceFontGetPixelResolution() {
     return ORBIS_OK;
 }
 
-s32 PS4_SYSV_ABI sceFontGetRenderCharGlyphMetrics() {
-    LOG_ERROR(Lib_Font, "(STUBBED) called");
-    return ORBIS_OK;
+s32 PS4_SYSV_ABI sceFontGetRenderCharGlyphMetrics(OrbisFontHandle fontHandle, u32 code,
+                                                  OrbisFontGlyphMetrics* metrics) {
+    auto* font = ToFont(fontHandle);
+    if (!font) {
+        return ORBIS_FONT_ERROR_INVALID_FONT_HANDLE;
+    }
+    if (!metrics) {
+        return ORBIS_FONT_ERROR_INVALID_PARAMETER;
+    }
+    const auto [scale_w, scale_h] = GetRenderScale(font);
+    u32 glyph{};
+    return GetGlyphMetrics(font, code, scale_w, scale_h, metrics, glyph);
 }
 
 s32 PS4_SYSV_ABI sceFontGetRenderEffectSlant() {
@@ -327,8 +619,18 @@ s32 PS4_SYSV_ABI sceFontGetRenderScaledKerning() {
     return ORBIS_OK;
 }
 
-s32 PS4_SYSV_ABI sceFontGetRenderScalePixel() {
-    LOG_ERROR(Lib_Font, "(STUBBED) called");
+s32 PS4_SYSV_ABI sceFontGetRenderScalePixel(OrbisFontHandle fontHandle, float* w, float* h) {
+    auto* font = ToFont(fontHandle);
+    if (!font) {
+        return ORBIS_FONT_ERROR_INVALID_FONT_HANDLE;
+    }
+    const auto [scale_w, scale_h] = GetRenderScale(font);
+    if (w) {
+        *w = scale_w;
+    }
+    if (h) {
+        *h = scale_h;
+    }
     return ORBIS_OK;
 }
 
@@ -337,13 +639,31 @@ s32 PS4_SYSV_ABI sceFontGetRenderScalePoint() {
     return ORBIS_OK;
 }
 
-s32 PS4_SYSV_ABI sceFontGetResolutionDpi() {
-    LOG_ERROR(Lib_Font, "(STUBBED) called");
+s32 PS4_SYSV_ABI sceFontGetResolutionDpi(OrbisFontHandle fontHandle, u32* h, u32* v) {
+    auto* font = ToFont(fontHandle);
+    if (!font) {
+        return ORBIS_FONT_ERROR_INVALID_FONT_HANDLE;
+    }
+    if (h) {
+        *h = font->dpi_h;
+    }
+    if (v) {
+        *v = font->dpi_v;
+    }
     return ORBIS_OK;
 }
 
-s32 PS4_SYSV_ABI sceFontGetScalePixel() {
-    LOG_ERROR(Lib_Font, "(STUBBED) called");
+s32 PS4_SYSV_ABI sceFontGetScalePixel(OrbisFontHandle fontHandle, float* w, float* h) {
+    auto* font = ToFont(fontHandle);
+    if (!font) {
+        return ORBIS_FONT_ERROR_INVALID_FONT_HANDLE;
+    }
+    if (w) {
+        *w = font->scale_w;
+    }
+    if (h) {
+        *h = font->scale_h;
+    }
     return ORBIS_OK;
 }
 
@@ -692,19 +1012,69 @@ s32 PS4_SYSV_ABI sceFontMemoryTerm() {
     return ORBIS_OK;
 }
 
-s32 PS4_SYSV_ABI sceFontOpenFontFile() {
-    LOG_ERROR(Lib_Font, "(STUBBED) called");
-    return ORBIS_OK;
+s32 PS4_SYSV_ABI sceFontOpenFontFile(OrbisFontLib library, const char* guestPath, u32 openMode,
+                                     const void* openDetail, OrbisFontHandle* pFontHandle) {
+    auto* lib = ToLibrary(library);
+    if (!lib) {
+        return ORBIS_FONT_ERROR_INVALID_LIBRARY;
+    }
+    if (!guestPath || !pFontHandle) {
+        return ORBIS_FONT_ERROR_INVALID_PARAMETER;
+    }
+    LOG_INFO(Lib_Font, "path = {}, openMode = {}", guestPath, openMode);
+    auto* mnt = Common::Singleton<Core::FileSys::MntPoints>::Instance();
+    const auto path = mnt->GetHostPath(guestPath);
+    const Common::FS::IOFile file(path, Common::FS::FileAccessMode::Read);
+    if (!file.IsOpen()) {
+        LOG_ERROR(Lib_Font, "Failed to open {}", path.string());
+        return ORBIS_FONT_ERROR_FS_OPEN_FAILED;
+    }
+    std::vector<u8> data(file.GetSize());
+    if (file.Read(data) != data.size()) {
+        return ORBIS_FONT_ERROR_FONT_OPEN_FAILED;
+    }
+    return OpenFace(lib, FontFace::Open(std::move(data), 0), pFontHandle);
 }
 
-s32 PS4_SYSV_ABI sceFontOpenFontInstance() {
-    LOG_ERROR(Lib_Font, "(STUBBED) called");
+s32 PS4_SYSV_ABI sceFontOpenFontInstance(OrbisFontHandle fontHandle, OrbisFontHandle setupFont,
+                                         OrbisFontHandle* pFontHandle) {
+    auto* font = ToFont(fontHandle);
+    if (!font) {
+        return ORBIS_FONT_ERROR_INVALID_FONT_HANDLE;
+    }
+    if (!pFontHandle) {
+        return ORBIS_FONT_ERROR_INVALID_PARAMETER;
+    }
+    // Instances share the font data and therefore the glyphs cached for it. Scales and dpi
+    // are taken from the setup font when given.
+    const auto* setup = ToFont(setupFont);
+    auto* instance = new FontInstance(setup ? *setup : *font);
+    instance->face = font->face;
+    instance->face_id = font->face_id;
+    instance->renderer = nullptr;
+    {
+        std::scoped_lock lk{g_open_fonts_mutex};
+        instance->library = font->library;
+        if (instance->library) {
+            instance->library->open_fonts.insert(instance);
+        }
+    }
+    *pFontHandle = instance;
     return ORBIS_OK;
 }
 
-s32 PS4_SYSV_ABI sceFontOpenFontMemory() {
-    LOG_ERROR(Lib_Font, "(STUBBED) called");
-    return ORBIS_OK;
+s32 PS4_SYSV_ABI sceFontOpenFontMemory(OrbisFontLib library, const void* fontAddress, u32 fontSize,
+                                       const void* openDetail, OrbisFontHandle* pFontHandle) {
+    auto* lib = ToLibrary(library);
+    if (!lib) {
+        return ORBIS_FONT_ERROR_INVALID_LIBRARY;
+    }
+    if (!fontAddress || fontSize == 0 || !pFontHandle) {
+        return ORBIS_FONT_ERROR_INVALID_PARAMETER;
+    }
+    // The guest keeps the font data mapped until the font is closed.
+    const std::span data{static_cast<const u8*>(fontAddress), fontSize};
+    return OpenFace(lib, FontFace::Open(data, 0), pFontHandle);
 }
 
 s32 PS4_SYSV_ABI sceFontOpenFontSet() {
@@ -717,13 +1087,77 @@ s32 PS4_SYSV_ABI sceFontRebindRenderer() {
     return ORBIS_OK;
 }
 
-s32 PS4_SYSV_ABI sceFontRenderCharGlyphImage() {
-    LOG_ERROR(Lib_Font, "(STUBBED) called");
-    return ORBIS_OK;
+s32 PS4_SYSV_ABI sceFontRenderCharGlyphImage(OrbisFontHandle fontHandle, u32 code,
+                                             OrbisFontRenderSurface* surf, float x, float y,
+                                             OrbisFontGlyphMetrics* metrics,
+                                             OrbisFontRenderOutput* result) {
+    return sceFontRenderCharGlyphImageHorizontal(fontHandle, code, surf, x, y, metrics, result);
 }
 
-s32 PS4_SYSV_ABI sceFontRenderCharGlyphImageHorizontal() {
-    LOG_ERROR(Lib_Font, "(STUBBED) called");
+s32 PS4_SYSV_ABI sceFontRenderCharGlyphImageHorizontal(OrbisFontHandle fontHandle, u32 code,
+                                                       OrbisFontRenderSurface* surf, float x,
+                                                       float y, OrbisFontGlyphMetrics* metrics,
+                                                       OrbisFontRenderOutput* result) {
+    auto* font = ToFont(fontHandle);
+    if (!font) {
+        return ORBIS_FONT_ERROR_INVALID_FONT_HANDLE;
+    }
+    if (!font->renderer) {
+        return ORBIS_FONT_ERROR_NOT_BOUND_RENDERER;
+    }
+    if (!surf || !surf->buffer) {
+        return ORBIS_FONT_ERROR_INVALID_PARAMETER;
+    }
+    if (surf->pixelSizeByte != 1 && surf->pixelSizeByte != 4) {
+        LOG_ERROR(Lib_Font, "Unsupported surface pixel size {}", surf->pixelSizeByte);
+        return ORBIS_FONT_ERROR_NO_SUPPORT_SURFACE;
+    }
+    const auto [scale_w, scale_h] = GetRenderScale(font);
+    u32 glyph{};
+    OrbisFontGlyphMetrics glyph_metrics{};
+    if (const s32 ret = GetGlyphMetrics(font, code, scale_w, scale_h, &glyph_metrics, glyph);
+        ret != ORBIS_OK) {
+        return ret;
+    }
+    if (metrics) {
+        *metrics = glyph_metrics;
+    }
+    if (result) {
+        *result = {};
+    }
+
+    // The pen position is on the baseline, the bitmap offsets are relative to it.
+    const GlyphKey key{
+        .face = font->face_id,
+        .scale_x = std::bit_cast<u32>(scale_w),
+        .scale_y = std::bit_cast<u32>(scale_h),
+        .glyph = glyph,
+    };
+    // Same lock order as sceFontCloseFont. Once the library mutex is held, destroying the library
+    // waits for it, so the open fonts lock can be dropped before rasterizing.
+    std::unique_lock fonts_lk{g_open_fonts_mutex};
+    auto* lib = font->library;
+    if (!lib) {
+        LOG_ERROR(Lib_Font, "Font library was destroyed");
+        return ORBIS_FONT_ERROR_INVALID_LIBRARY;
+    }
+    std::scoped_lock lk{lib->mutex};
+    fonts_lk.unlock();
+    const GlyphBitmap* bitmap = lib->cache.Find(key);
+    if (!bitmap) {
+        bitmap = lib->cache.Insert(key, font->face->Rasterize(glyph, scale_w, scale_h));
+    }
+    const s32 left = static_cast<s32>(std::floor(x)) + bitmap->offset_x;
+    const s32 top = static_cast<s32>(std::floor(y)) + bitmap->offset_y;
+    BlitGlyph(*bitmap, surf, left, top, result);
+    if (result) {
+        result->imageMetrics.bearingX = glyph_metrics.horizontal.bearingX;
+        result->imageMetrics.bearingY = glyph_metrics.horizontal.bearingY;
+        result->imageMetrics.dv = 0.0f;
+        result->imageMetrics.stride = static_cast<float>(surf->widthByte);
+        result->imageMetrics.width = static_cast<u32>(bitmap->width);
+        result->imageMetrics.height = static_cast<u32>(bitmap->height);
+    }
     return ORBIS_OK;
 }
 
@@ -854,19 +1288,36 @@ s32 PS4_SYSV_ABI sceFontSetFontsOpenMode() {
     return ORBIS_OK;
 }
 
-s32 PS4_SYSV_ABI sceFontSetResolutionDpi() {
-    LOG_ERROR(Lib_Font, "(STUBBED) called");
+s32 PS4_SYSV_ABI sceFontSetResolutionDpi(OrbisFontHandle fontHandle, u32 h, u32 v) {
+    auto* font = ToFont(fontHandle);
+    if (!font) {
+        return ORBIS_FONT_ERROR_INVALID_FONT_HANDLE;
+    }
+    font->dpi_h = h != 0 ? h : DefaultDpi;
+    font->dpi_v = v != 0 ? v : DefaultDpi;
     return ORBIS_OK;
 }
 
-s32 PS4_SYSV_ABI sceFontSetScalePixel() {
-    LOG_ERROR(Lib_Font, "(STUBBED) called");
+s32 PS4_SYSV_ABI sceFontSetScalePixel(OrbisFontHandle fontHandle, float w, float h) {
+    auto* font = ToFont(fontHandle);
+    if (!font) {
+        return ORBIS_FONT_ERROR_INVALID_FONT_HANDLE;
+    }
+    if (w <= 0.0f || h <= 0.0f) {
+        return ORBIS_FONT_ERROR_INVALID_PARAMETER;
+    }
+    font->scale_w = w;
+    font->scale_h = h;
     return ORBIS_OK;
 }
 
-s32 PS4_SYSV_ABI sceFontSetScalePoint() {
-    LOG_ERROR(Lib_Font, "(STUBBED) called");
-    return ORBIS_OK;
+s32 PS4_SYSV_ABI sceFontSetScalePoint(OrbisFontHandle fontHandle, float w, float h) {
+    auto* font = ToFont(fontHandle);
+    if (!font) {
+        return ORBIS_FONT_ERROR_INVALID_FONT_HANDLE;
+    }
+    return sceFontSetScalePixel(fontHandle, w * font->dpi_h / DefaultDpi,
+                                h * font->dpi_v / DefaultDpi);
 }
 
 s32 PS4_SYSV_ABI sceFontSetScriptLanguage() {
@@ -889,14 +1340,26 @@ s32 PS4_SYSV_ABI sceFontSetupRenderEffectWeight() {
     return ORBIS_OK;
 }
 
-s32 PS4_SYSV_ABI sceFontSetupRenderScalePixel() {
-    LOG_ERROR(Lib_Font, "(STUBBED) called");
+s32 PS4_SYSV_ABI sceFontSetupRenderScalePixel(OrbisFontHandle fontHandle, float w, float h) {
+    auto* font = ToFont(fontHandle);
+    if (!font) {
+        return ORBIS_FONT_ERROR_INVALID_FONT_HANDLE;
+    }
+    if (w <= 0.0f || h <= 0.0f) {
+        return ORBIS_FONT_ERROR_INVALID_PARAMETER;
+    }
+    font->render_scale_w = w;
+    font->render_scale_h = h;
     return ORBIS_OK;
 }
 
-s32 PS4_SYSV_ABI sceFontSetupRenderScalePoint() {
-    LOG_ERROR(Lib_Font, "(STUBBED) called");
-    return ORBIS_OK;
+s32 PS4_SYSV_ABI sceFontSetupRenderScalePoint(OrbisFontHandle fontHandle, float w, float h) {
+    auto* font = ToFont(fontHandle);
+    if (!font) {
+        return ORBIS_FONT_ERROR_INVALID_FONT_HANDLE;
+    }
+    return sceFontSetupRenderScalePixel(fontHandle, w * font->dpi_h / DefaultDpi,
+                                        h * font->dpi_v / DefaultDpi);
 }
 
 s32 PS4_SYSV_ABI sceFontStringGetTerminateCode() {
@@ -1124,8 +1587,15 @@ s32 PS4_SYSV_ABI sceFontTextSourceSetWritingForm() {
     return ORBIS_OK;
 }
 
-s32 PS4_SYSV_ABI sceFontUnbindRenderer() {
-    LOG_ERROR(Lib_Font, "(STUBBED) called");
+s32 PS4_SYSV_ABI sceFontUnbindRenderer(OrbisFontHandle fontHandle) {
+    auto* font = ToFont(fontHandle);
+    if (!font) {
+        return ORBIS_FONT_ERROR_INVALID_FONT_HANDLE;
+    }
+    if (!font->renderer) {
+        return ORBIS_FONT_ERROR_NOT_BOUND_RENDERER;
+    }
+    font->renderer = nullptr;
     return ORBIS_OK;
 }
 
@@ -53,8 +53,53 @@ struct OrbisFontStyleFrame {
     /*0x24*/ float slantRatio;
 };
 
-s32 PS4_SYSV_ABI sceFontAttachDeviceCacheBuffer();
-s32 PS4_SYSV_ABI sceFontBindRenderer();
+using OrbisFontLib = void*;
+using OrbisFontRenderer = void*;
+using OrbisFontHandle = void*;
+
+struct OrbisFontGlyphMetrics {
+    float width;
+    float height;
+    struct {
+        float bearingX;
+        float bearingY;
+        float advance;
+    } horizontal;
+    struct {
+        float bearingX;
+        float bearingY;
+        float advance;
+    } vertical;
+};
+
+struct OrbisFontHorizontalLayout {
+    float baseLineY;
+    float lineHeight;
+    float effectHeight;
+};
+
+struct OrbisFontGlyphImageMetrics {
+    float bearingX;
+    float bearingY;
+    float dv;
+    float stride;
+    u32 width;
+    u32 height;
+};
+
+struct OrbisFontRenderOutput {
+    const void* glyph;
+    struct {
+        u32 x;
+        u32 y;
+        u32 w;
+        u32 h;
+    } updateRect;
+    OrbisFontGlyphImageMetrics imageMetrics;
+};
+
+s32 PS4_SYSV_ABI sceFontAttachDeviceCacheBuffer(OrbisFontLib library, void* buffer, u32 size);
+s32 PS4_SYSV_ABI sceFontBindRenderer(OrbisFontHandle fontHandle, OrbisFontRenderer renderer);
 s32 PS4_SYSV_ABI sceFontCharacterGetBidiLevel(OrbisFontTextCharacter* textCharacter,
                                               int* bidiLevel);
 s32 PS4_SYSV_ABI sceFontCharacterGetSyllableStringState();
@@ -68,16 +113,20 @@ sceFontCharacterRefersTextBack(OrbisFontTextCharacter* textCharacter);
 OrbisFontTextCharacter* PS4_SYSV_ABI
 sceFontCharacterRefersTextNext(OrbisFontTextCharacter* textCharacter);
 s32 PS4_SYSV_ABI sceFontCharactersRefersTextCodes();
-s32 PS4_SYSV_ABI sceFontClearDeviceCache();
-s32 PS4_SYSV_ABI sceFontCloseFont();
+s32 PS4_SYSV_ABI sceFontClearDeviceCache(OrbisFontLib library);
+s32 PS4_SYSV_ABI sceFontCloseFont(OrbisFontHandle fontHandle);
 s32 PS4_SYSV_ABI sceFontControl();
 s32 PS4_SYSV_ABI sceFontCreateGraphicsDevice();
 s32 PS4_SYSV_ABI sceFontCreateGraphicsService();
 s32 PS4_SYSV_ABI sceFontCreateGraphicsServiceWithEdition();
-s32 PS4_SYSV_ABI sceFontCreateLibrary();
-s32 PS4_SYSV_ABI sceFontCreateLibraryWithEdition();
-s32 PS4_SYSV_ABI sceFontCreateRenderer();
-s32 PS4_SYSV_ABI sceFontCreateRendererWithEdition();
+s32 PS4_SYSV_ABI sceFontCreateLibrary(const void* memory, const void* selection,
+                                      OrbisFontLib* pLibrary);
+s32 PS4_SYSV_ABI sceFontCreateLibraryWithEdition(const void* memory, const void* selection,
+                                                 u64 edition, OrbisFontLib* pLibrary);
+s32 PS4_SYSV_ABI sceFontCreateRenderer(const void* memory, const void* selection,
+                                       OrbisFontRenderer* pRenderer);
+s32 PS4_SYSV_ABI sceFontCreateRendererWithEdition(const void* memory, const void* selection,
+                                                  u64 edition, OrbisFontRenderer* pRenderer);
 s32 PS4_SYSV_ABI sceFontCreateString();
 s32 PS4_SYSV_ABI sceFontCreateWords();
 s32 PS4_SYSV_ABI sceFontCreateWritingLine();
@@ -85,36 +134,39 @@ s32 PS4_SYSV_ABI sceFontDefineAttribute();
 s32 PS4_SYSV_ABI sceFontDeleteGlyph();
 s32 PS4_SYSV_ABI sceFontDestroyGraphicsDevice();
 s32 PS4_SYSV_ABI sceFontDestroyGraphicsService();
-s32 PS4_SYSV_ABI sceFontDestroyLibrary();
-s32 PS4_SYSV_ABI sceFontDestroyRenderer();
+s32 PS4_SYSV_ABI sceFontDestroyLibrary(OrbisFontLib* pLibrary);
+s32 PS4_SYSV_ABI sceFontDestroyRenderer(OrbisFontRenderer* pRenderer);
 s32 PS4_SYSV_ABI sceFontDestroyString();
 s32 PS4_SYSV_ABI sceFontDestroyWords();
 s32 PS4_SYSV_ABI sceFontDestroyWritingLine();
-s32 PS4_SYSV_ABI sceFontDettachDeviceCacheBuffer();
+s32 PS4_SYSV_ABI sceFontDettachDeviceCacheBuffer(OrbisFontLib library);
 s32 PS4_SYSV_ABI sceFontGenerateCharGlyph();
 s32 PS4_SYSV_ABI sceFontGetAttribute();
 s32 PS4_SYSV_ABI sceFontGetCharGlyphCode();
-s32 PS4_SYSV_ABI sceFontGetCharGlyphMetrics();
+s32 PS4_SYSV_ABI sceFontGetCharGlyphMetrics(OrbisFontHandle fontHandle, u32 code,
+                                            OrbisFontGlyphMetrics* metrics);
 s32 PS4_SYSV_ABI sceFontGetEffectSlant();
 s32 PS4_SYSV_ABI sceFontGetEffectWeight();
-s32 PS4_SYSV_ABI sceFontGetFontGlyphsCount();
+s32 PS4_SYSV_ABI sceFontGetFontGlyphsCount(OrbisFontHandle fontHandle, u32* count);
 s32 PS4_SYSV_ABI sceFontGetFontGlyphsOutlineProfile();
 s32 PS4_SYSV_ABI sceFontGetFontMetrics();
 s32 PS4_SYSV_ABI sceFontGetFontResolution();
 s32 PS4_SYSV_ABI sceFontGetFontStyleInformation();
 s32 PS4_SYSV_ABI sceFontGetGlyphExpandBufferState();
-s32 PS4_SYSV_ABI sceFontGetHorizontalLayout();
+s32 PS4_SYSV_ABI sceFontGetHorizontalLayout(OrbisFontHandle fontHandle,
+                                            OrbisFontHorizontalLayout* layout);
 s32 PS4_SYSV_ABI sceFontGetKerning();
 s32 PS4_SYSV_ABI sceFontGetLibrary();
 s32 PS4_SYSV_ABI sceFontGetPixelResolution();
-s32 PS4_SYSV_ABI sceFontGetRenderCharGlyphMetrics();
+s32 PS4_SYSV_ABI sceFontGetRenderCharGlyphMetrics(OrbisFontHandle fontHandle, u32 code,
+                                                  OrbisFontGlyphMetrics* metrics);
 s32 PS4_SYSV_ABI sceFontGetRenderEffectSlant();
 s32 PS4_SYSV_ABI sceFontGetRenderEffectWeight();
 s32 PS4_SYSV_ABI sceFontGetRenderScaledKerning();
-s32 PS4_SYSV_ABI sceFontGetRenderScalePixel();
+s32 PS4_SYSV_ABI sceFontGetRenderScalePixel(OrbisFontHandle fontHandle, float* w, float* h);
 s32 PS4_SYSV_ABI sceFontGetRenderScalePoint();
-s32 PS4_SYSV_ABI sceFontGetResolutionDpi();
-s32 PS4_SYSV_ABI sceFontGetScalePixel();
+s32 PS4_SYSV_ABI sceFontGetResolutionDpi(OrbisFontHandle fontHandle, u32* h, u32* v);
+s32 PS4_SYSV_ABI sceFontGetScalePixel(OrbisFontHandle fontHandle, float* w, float* h);
 s32 PS4_SYSV_ABI sceFontGetScalePoint();
 s32 PS4_SYSV_ABI sceFontGetScriptLanguage();
 s32 PS4_SYSV_ABI sceFontGetTypographicDesign();
@@ -184,13 +236,22 @@ s32 PS4_SYSV_ABI sceFontGraphicsUpdateShapeFill();
 s32 PS4_SYSV_ABI sceFontGraphicsUpdateShapeFillPlot();
 s32 PS4_SYSV_ABI sceFontMemoryInit();
 s32 PS4_SYSV_ABI sceFontMemoryTerm();
-s32 PS4_SYSV_ABI sceFontOpenFontFile();
-s32 PS4_SYSV_ABI sceFontOpenFontInstance();
-s32 PS4_SYSV_ABI sceFontOpenFontMemory();
+s32 PS4_SYSV_ABI sceFontOpenFontFile(OrbisFontLib library, const char* guestPath, u32 openMode,
+                                     const void* openDetail, OrbisFontHandle* pFontHandle);
+s32 PS4_SYSV_ABI sceFontOpenFontInstance(OrbisFontHandle fontHandle, OrbisFontHandle setupFont,
+                                         OrbisFontHandle* pFontHandle);
+s32 PS4_SYSV_ABI sceFontOpenFontMemory(OrbisFontLib library, const void* fontAddress, u32 fontSize,
+                                       const void* openDetail, OrbisFontHandle* pFontHandle);
 s32 PS4_SYSV_ABI sceFontOpenFontSet();
 s32 PS4_SYSV_ABI sceFontRebindRenderer();
-s32 PS4_SYSV_ABI sceFontRenderCharGlyphImage();
-s32 PS4_SYSV_ABI sceFontRenderCharGlyphImageHorizontal();
+s32 PS4_SYSV_ABI sceFontRenderCharGlyphImage(OrbisFontHandle fontHandle, u32 code,
+                                             OrbisFontRenderSurface* surf, float x, float y,
+                                             OrbisFontGlyphMetrics* metrics,
+                                             OrbisFontRenderOutput* result);
+s32 PS4_SYSV_ABI sceFontRenderCharGlyphImageHorizontal(OrbisFontHandle fontHandle, u32 code,
+                                                       OrbisFontRenderSurface* surf, float x,
+                                                       float y, OrbisFontGlyphMetrics* metrics,
+                                                       OrbisFontRenderOutput* result);
 s32 PS4_SYSV_ABI sceFontRenderCharGlyphImageVertical();
 s32 PS4_SYSV_ABI sceFontRendererGetOutlineBufferSize();
 s32 PS4_SYSV_ABI sceFontRendererResetOutlineBuffer();
@@ -205,15 +266,15 @@ s32 PS4_SYSV_ABI sceFontRenderSurfaceSetStyleFrame(OrbisFontRenderSurface* rende
 s32 PS4_SYSV_ABI sceFontSetEffectSlant();
 s32 PS4_SYSV_ABI sceFontSetEffectWeight();
 s32 PS4_SYSV_ABI sceFontSetFontsOpenMode();
-s32 PS4_SYSV_ABI sceFontSetResolutionDpi();
-s32 PS4_SYSV_ABI sceFontSetScalePixel();
-s32 PS4_SYSV_ABI sceFontSetScalePoint();
+s32 PS4_SYSV_ABI sceFontSetResolutionDpi(OrbisFontHandle fontHandle, u32 h, u32 v);
+s32 PS4_SYSV_ABI sceFontSetScalePixel(OrbisFontHandle fontHandle, float w, float h);
+s32 PS4_SYSV_ABI sceFontSetScalePoint(OrbisFontHandle fontHandle, float w, float h);
 s32 PS4_SYSV_ABI sceFontSetScriptLanguage();
 s32 PS4_SYSV_ABI sceFontSetTypographicDesign();
 s32 PS4_SYSV_ABI sceFontSetupRenderEffectSlant();
 s32 PS4_SYSV_ABI sceFontSetupRenderEffectWeight();
-s32 PS4_SYSV_ABI sceFontSetupRenderScalePixel();
-s32 PS4_SYSV_ABI sceFontSetupRenderScalePoint();
+s32 PS4_SYSV_ABI sceFontSetupRenderScalePixel(OrbisFontHandle fontHandle, float w, float h);
+s32 PS4_SYSV_ABI sceFontSetupRenderScalePoint(OrbisFontHandle fontHandle, float w, float h);
 s32 PS4_SYSV_ABI sceFontStringGetTerminateCode();
 s32 PS4_SYSV_ABI sceFontStringGetTerminateOrder();
 s32 PS4_SYSV_ABI sceFontStringGetWritingForm();
@@ -246,7 +307,7 @@ s32 PS4_SYSV_ABI sceFontTextSourceInit();
 s32 PS4_SYSV_ABI sceFontTextSourceRewind();
 s32 PS4_SYSV_ABI sceFontTextSourceSetDefaultFont();
 s32 PS4_SYSV_ABI sceFontTextSourceSetWritingForm();
-s32 PS4_SYSV_ABI sceFontUnbindRenderer();
+s32 PS4_SYSV_ABI sceFontUnbindRenderer(OrbisFontHandle fontHandle);
 s32 PS4_SYSV_ABI sceFontWordsFindWordCharacters();
 s32 PS4_SYSV_ABI sceFontWritingGetRenderMetrics();
 s32 PS4_SYSV_ABI sceFontWritingInit();
@@ -296,4 +357,4 @@ s32 PS4_SYSV_ABI Func_FE4788A96EF46256();
 s32 PS4_SYSV_ABI Func_FE7E5AE95D3058F5();
 
 void RegisterlibSceFont(Core::Loader::SymbolsResolver* sym);
-} // namespace Libraries::Font
\ No newline at end of file
+} // namespace Libraries::Font
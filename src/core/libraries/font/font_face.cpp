@@ -0,0 +1,108 @@
+// SPDX-FileCopyrightText: Copyright 2025 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+
+#include "core/libraries/font/font_face.h"
+
+// Dear ImGui ships stb_truetype, keep our copy private to this file.
+#define STB_TRUETYPE_IMPLEMENTATION
+#define STBTT_STATIC
+#include <imstb_truetype.h>
+
+namespace Libraries::Font {
+
+FontFace::FontFace() : info{std::make_unique<stbtt_fontinfo>()} {}
+
+FontFace::~FontFace() = default;
+
+std::shared_ptr<FontFace> FontFace::Open(std::span<const u8> data, u32 index) {
+    std::shared_ptr<FontFace> face{new FontFace()};
+    face->data = data;
+    if (!face->Init(index)) {
+        return nullptr;
+    }
+    return face;
+}
+
+std::shared_ptr<FontFace> FontFace::Open(std::vector<u8>&& data, u32 index) {
+    std::shared_ptr<FontFace> face{new FontFace()};
+    face->owned_data = std::move(data);
+    face->data = face->owned_data;
+    if (!face->Init(index)) {
+        return nullptr;
+    }
+    return face;
+}
+
+bool FontFace::Init(u32 index) {
+    // Every table offset is read from the data, make sure the header itself is there.
+    if (data.size() < 12) {
+        return false;
+    }
+    const s32 offset = stbtt_GetFontOffsetForIndex(data.data(), static_cast<s32>(index));
+    if (offset < 0 || static_cast<size_t>(offset) >= data.size()) {
+        return false;
+    }
+    return stbtt_InitFont(info.get(), data.data(), offset) != 0;
+}
+
+u32 FontFace::NumGlyphs() const noexcept {
+    return static_cast<u32>(info->numGlyphs);
+}
+
+u32 FontFace::FindGlyph(u32 code) const {
+    return static_cast<u32>(stbtt_FindGlyphIndex(info.get(), static_cast<s32>(code)));
+}
+
+float FontFace::PixelScale(float pixels) const {
+    return stbtt_ScaleForMappingEmToPixels(info.get(), pixels);
+}
+
+GlyphLayout FontFace::GetGlyphLayout(u32 glyph, float scale_x, float scale_y) const {
+    const float sx = PixelScale(scale_x);
+    const float sy = PixelScale(scale_y);
+    s32 advance{};
+    s32 left_bearing{};
+    stbtt_GetGlyphHMetrics(info.get(), static_cast<s32>(glyph), &advance, &left_bearing);
+    s32 x0{}, y0{}, x1{}, y1{};
+    stbtt_GetGlyphBitmapBox(info.get(), static_cast<s32>(glyph), sx, sy, &x0, &y0, &x1, &y1);
+    return GlyphLayout{
+        .width = static_cast<float>(x1 - x0),
+        .height = static_cast<float>(y1 - y0),
+        .bearing_x = static_cast<float>(x0),
+        .bearing_y = static_cast<float>(-y0),
+        .advance = static_cast<float>(advance) * sx,
+    };
+}
+
+LineLayout FontFace::GetLineLayout(float scale_y) const {
+    const float sy = PixelScale(scale_y);
+    s32 ascent{}, descent{}, line_gap{};
+    stbtt_GetFontVMetrics(info.get(), &ascent, &descent, &line_gap);
+    return LineLayout{
+        .baseline_y = static_cast<float>(ascent) * sy,
+        .line_height = static_cast<float>(ascent - descent + line_gap) * sy,
+    };
+}
+
+GlyphBitmap FontFace::Rasterize(u32 glyph, float scale_x, float scale_y) const {
+    const float sx = PixelScale(scale_x);
+    const float sy = PixelScale(scale_y);
+    s32 x0{}, y0{}, x1{}, y1{};
+    stbtt_GetGlyphBitmapBox(info.get(), static_cast<s32>(glyph), sx, sy, &x0, &y0, &x1, &y1);
+    GlyphBitmap bitmap{
+        .width = std::max(x1 - x0, 0),
+        .height = std::max(y1 - y0, 0),
+        .offset_x = x0,
+        .offset_y = y0,
+    };
+    bitmap.pixels.resize(static_cast<size_t>(bitmap.width) * bitmap.height);
+    if (!bitmap.pixels.empty()) {
+        stbtt_MakeGlyphBitmap(info.get(), bitmap.pixels.data(), bitmap.width, bitmap.height,
+                              bitmap.width, sx, sy, static_cast<s32>(glyph));
+    }
+    return bitmap;
+}
+
+} // namespace Libraries::Font
@@ -0,0 +1,65 @@
+// SPDX-FileCopyrightText: Copyright 2025 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "common/types.h"
+#include "core/libraries/font/glyph_cache.h"
+
+struct stbtt_fontinfo;
+
+namespace Libraries::Font {
+
+struct GlyphLayout {
+    float width;
+    float height;
+    float bearing_x; ///< From the pen position to the left edge
+    float bearing_y; ///< From the baseline to the top edge, growing upwards
+    float advance;
+};
+
+struct LineLayout {
+    float baseline_y; ///< From the top of the line to the baseline
+    float line_height;
+};
+
+/// TrueType or OpenType font data together with the tables needed to rasterize it.
+class FontFace {
+public:
+    ~FontFace();
+
+    /// Parses the font at the given index of a collection. The data must outlive the face.
+    static std::shared_ptr<FontFace> Open(std::span<const u8> data, u32 index);
+
+    /// Same as above, but the face keeps its own copy of the data.
+    static std::shared_ptr<FontFace> Open(std::vector<u8>&& data, u32 index);
+
+    [[nodiscard]] u32 NumGlyphs() const noexcept;
+
+    /// Returns the glyph index for a code point, 0 if the font does not cover it.
+    [[nodiscard]] u32 FindGlyph(u32 code) const;
+
+    [[nodiscard]] GlyphLayout GetGlyphLayout(u32 glyph, float scale_x, float scale_y) const;
+
+    [[nodiscard]] LineLayout GetLineLayout(float scale_y) const;
+
+    [[nodiscard]] GlyphBitmap Rasterize(u32 glyph, float scale_x, float scale_y) const;
+
+private:
+    FontFace();
+
+    bool Init(u32 index);
+
+    /// Converts a size in pixels per em to the scale applied to font units.
+    [[nodiscard]] float PixelScale(float pixels) const;
+
+    std::vector<u8> owned_data;
+    std::span<const u8> data;
+    std::unique_ptr<stbtt_fontinfo> info;
+};
+
+} // namespace Libraries::Font
@@ -0,0 +1,87 @@
+// SPDX-FileCopyrightText: Copyright 2025 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "common/hash.h"
+#include "core/libraries/font/glyph_cache.h"
+
+namespace Libraries::Font {
+
+size_t GlyphCache::KeyHash::operator()(const GlyphKey& key) const noexcept {
+    u64 seed = key.face;
+    seed = HashCombine(seed, (u64{key.scale_x} << 32) | key.scale_y);
+    return HashCombine(seed, u64{key.glyph});
+}
+
+GlyphCache::GlyphCache(u64 capacity_) : capacity{capacity_} {}
+
+GlyphCache::~GlyphCache() = default;
+
+void GlyphCache::SetCapacity(u64 capacity_) {
+    capacity = capacity_;
+    EvictToCapacity();
+}
+
+const GlyphBitmap* GlyphCache::Find(const GlyphKey& key) {
+    const auto it = lookup.find(key);
+    if (it == lookup.end()) {
+        ++misses;
+        return nullptr;
+    }
+    ++hits;
+    entries.splice(entries.begin(), entries, it->second);
+    return &it->second->bitmap;
+}
+
+const GlyphBitmap* GlyphCache::Insert(const GlyphKey& key, GlyphBitmap&& bitmap) {
+    if (const auto it = lookup.find(key); it != lookup.end()) {
+        Erase(it->second);
+    }
+    used_bytes += bitmap.pixels.size();
+    entries.push_front(Entry{key, std::move(bitmap)});
+    lookup.emplace(key, entries.begin());
+    EvictToCapacity();
+    return &entries.front().bitmap;
+}
+
+void GlyphCache::EraseFace(u64 face) {
+    for (auto it = entries.begin(); it != entries.end();) {
+        const auto next = std::next(it);
+        if (it->key.face == face) {
+            Erase(it);
+        }
+        it = next;
+    }
+}
+
+void GlyphCache::Clear() {
+    entries.clear();
+    lookup.clear();
+    used_bytes = 0;
+}
+
+GlyphCache::Stats GlyphCache::GetStats() const {
+    return Stats{
+        .hits = hits,
+        .misses = misses,
+        .evictions = evictions,
+        .num_glyphs = entries.size(),
+        .used_bytes = used_bytes,
+    };
+}
+
+void GlyphCache::EvictToCapacity() {
+    // The most recent glyph is kept even when it is larger than the whole budget, the caller
+    // is about to draw it.
+    while (used_bytes > capacity && entries.size() > 1) {
+        Erase(std::prev(entries.end()));
+        ++evictions;
+    }
+}
+
+void GlyphCache::Erase(EntryList::iterator it) {
+    used_bytes -= it->bitmap.pixels.size();
+    lookup.erase(it->key);
+    entries.erase(it);
+}
+
+} // namespace Libraries::Font
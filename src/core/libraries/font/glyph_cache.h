@@ -0,0 +1,91 @@
+// SPDX-FileCopyrightText: Copyright 2025 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include "common/types.h"
+
+namespace Libraries::Font {
+
+struct GlyphKey {
+    u64 face;    ///< Id of the font data, shared by every instance opened from it
+    u32 scale_x; ///< Bit pattern of the horizontal pixel scale
+    u32 scale_y; ///< Bit pattern of the vertical pixel scale
+    u32 glyph;   ///< Glyph index inside the font
+
+    bool operator==(const GlyphKey&) const = default;
+};
+
+struct GlyphBitmap {
+    std::vector<u8> pixels; ///< One coverage byte per pixel, rows tightly packed
+    s32 width;
+    s32 height;
+    s32 offset_x; ///< From the pen position to the left edge
+    s32 offset_y; ///< From the baseline to the top edge, growing downwards
+};
+
+/**
+ * Rasterized glyphs shared by every font of a library, evicted in least recently used order once
+ * their pixels exceed the capacity. Not thread safe, the owning library serializes access.
+ */
+class GlyphCache {
+public:
+    static constexpr u64 DefaultCapacity = 1_MB;
+
+    struct Stats {
+        u64 hits;
+        u64 misses;
+        u64 evictions;
+        u64 num_glyphs;
+        u64 used_bytes;
+    };
+
+    explicit GlyphCache(u64 capacity = DefaultCapacity);
+    ~GlyphCache();
+
+    /// Changes the pixel budget, evicting glyphs that no longer fit.
+    void SetCapacity(u64 capacity);
+
+    /// Returns the cached glyph and marks it as the most recently used one.
+    [[nodiscard]] const GlyphBitmap* Find(const GlyphKey& key);
+
+    /// Caches a glyph after a miss. The returned bitmap stays valid until the next insertion.
+    const GlyphBitmap* Insert(const GlyphKey& key, GlyphBitmap&& bitmap);
+
+    /// Drops every glyph rasterized from the given font data.
+    void EraseFace(u64 face);
+
+    void Clear();
+
+    [[nodiscard]] Stats GetStats() const;
+
+private:
+    struct Entry {
+        GlyphKey key;
+        GlyphBitmap bitmap;
+    };
+
+    struct KeyHash {
+        size_t operator()(const GlyphKey& key) const noexcept;
+    };
+
+    using EntryList = std::list<Entry>;
+
+    void EvictToCapacity();
+    void Erase(EntryList::iterator it);
+
+    EntryList entries; ///< Most recently used first
+    std::unordered_map<GlyphKey, EntryList::iterator, KeyHash> lookup;
+    u64 capacity;
+    u64 used_bytes{};
+    u64 hits{};
+    u64 misses{};
+    u64 evictions{};
+};
+
+} // namespace Libraries::Font
@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <chrono>
+
 #include "gnm_error.h"
 #include "gnmdriver.h"
 
@@ -63,11 +65,10 @@ static constexpr std::array indirect_sgpr_offsets{0u, 0u, 0x4cu, 0u, 0xccu, 0u,
 // this flag in case we need it in the future.
 static constexpr bool UseNeoCompatSequences = false;
 
-// In case if `submitDone` is issued we need to block submissions until GPU idle
-static u32 submission_lock{};
-std::condition_variable cv_lock{};
-std::mutex m_submission{};
-static u64 frames_submitted{};      // frame counter
+// Number of frames closed with `submitDone` that the GPU may still be processing before
+// further submissions block
+static u32 frames_in_flight{1};
+static u64 frames_submitted{};      // frame counter, doubles as the fence of the last closed frame
 static bool send_init_packet{true}; // initialize HW state before first game's submit in a frame
 static s32 sdk_version{0};
 
@@ -77,16 +78,22 @@ static u32 asc_next_offs_dw[Liverpool::NumComputeRings];
 static VAddr tessellation_factors_ring_addr = -1;
 static constexpr u32 tessellation_offchip_buffer_size = 0x800000u;
 
-static void ResetSubmissionLock(Platform::InterruptId irq) {
-    std::unique_lock lock{m_submission};
-    submission_lock = 0;
-    cv_lock.notify_all();
+static bool IsSubmitSlotAvailable() {
+    return frames_submitted < frames_in_flight ||
+           liverpool->CompletedFrameFence() > frames_submitted - frames_in_flight;
 }
 
-static void WaitGpuIdle() {
+// Blocks the submitting thread while the GPU lags behind by the maximum number of frames
+static void WaitSubmitSlot() {
     HLE_TRACE;
-    std::unique_lock lock{m_submission};
-    cv_lock.wait(lock, [] { return submission_lock == 0; });
+    if (IsSubmitSlotAvailable()) {
+        return;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    liverpool->WaitFrameFence(frames_submitted - frames_in_flight + 1);
+    const auto blocked = std::chrono::steady_clock::now() - start;
+    DebugState.AddSubmitWait(
+        std::chrono::duration_cast<std::chrono::microseconds>(blocked).count());
 }
 
 // Write a special ending NOP packet with N DWs data block
@@ -158,7 +165,7 @@ s32 PS4_SYSV_ABI sceGnmAddEqEvent(SceKernelEqueue eq, u64 id, void* udata) {
 
 int PS4_SYSV_ABI sceGnmAreSubmitsAllowed() {
     LOG_TRACE(Lib_GnmDriver, "called");
-    return submission_lock == 0;
+    return IsSubmitSlotAvailable();
 }
 
 int PS4_SYSV_ABI sceGnmBeginWorkload(u32 workload_stream, u64* workload) {
@@ -293,7 +300,7 @@ void PS4_SYSV_ABI sceGnmDingDong(u32 gnm_vqid, u32 next_offs_dw) {
         return;
     }
 
-    WaitGpuIdle();
+    WaitSubmitSlot();
 
     if (DebugState.ShouldPauseInSubmit()) {
         DebugState.PauseGuestThreads();
@@ -2193,7 +2200,7 @@ int PS4_SYSV_ABI sceGnmSubmitCommandBuffersForWorkload(u32 workload, u32 count,
         }
     }
 
-    WaitGpuIdle();
+    WaitSubmitSlot();
 
     if (DebugState.ShouldPauseInSubmit()) {
         DebugState.PauseGuestThreads();
@@ -2279,10 +2286,7 @@ s32 PS4_SYSV_ABI sceGnmSubmitCommandBuffers(u32 count, const u32* dcb_gpu_addrs[
 int PS4_SYSV_ABI sceGnmSubmitDone() {
     HLE_TRACE;
     LOG_DEBUG(Lib_GnmDriver, "called");
-    WaitGpuIdle();
-    if (!liverpool->IsGpuIdle()) {
-        submission_lock = true;
-    }
+    WaitSubmitSlot();
     liverpool->SubmitDone();
     send_init_packet = true;
     ++frames_submitted;
@@ -2850,13 +2854,11 @@ void RegisterLib(Core::Loader::SymbolsResolver* sym) {
         sdk_version = 0;
     }
 
+    frames_in_flight = Config::getGpuFramesInFlight();
     if (Config::copyGPUCmdBuffers()) {
-        liverpool->ReserveCopyBufferSpace();
+        liverpool->ReserveCopyBufferSpace(frames_in_flight);
     }
 
-    Platform::IrqC::Instance()->Register(Platform::InterruptId::GpuIdle, ResetSubmissionLock,
-                                         nullptr);
-
     LIB_FUNCTION("b0xyllnVY-I", "libSceGnmDriver", 1, "libSceGnmDriver", sceGnmAddEqEvent);
     LIB_FUNCTION("b08AgtPlHPg", "libSceGnmDriver", 1, "libSceGnmDriver", sceGnmAreSubmitsAllowed);
     LIB_FUNCTION("ihxrbsoSKWc", "libSceGnmDriver", 1, "libSceGnmDriver", sceGnmBeginWorkload);
@@ -10,6 +10,7 @@
 #include "core/libraries/libs.h"
 #include "jpeg_error.h"
 #include "jpegenc.h"
+#include "jpegenc_impl.h"
 
 namespace Libraries::JpegEnc {
 
@@ -172,8 +173,8 @@ s32 PS4_SYSV_ABI sceJpegEncEncode(OrbisJpegEncHandle handle, const OrbisJpegEncE
         return param_ret;
     }
 
-    LOG_ERROR(Lib_Jpeg,
-              "(STUBBED) image_size = {} , jpeg_size = {} , image_width = {} , image_height = {} , "
+    LOG_TRACE(Lib_Jpeg,
+              "image_size = {} , jpeg_size = {} , image_width = {} , image_height = {} , "
               "image_pitch = {} , pixel_format = {} , encode_mode = {} , color_space = {} , "
               "sampling_type = {} , compression_ratio = {} , restart_interval = {}",
               param->image_size, param->jpeg_size, param->image_width, param->image_height,
@@ -182,8 +183,20 @@ s32 PS4_SYSV_ABI sceJpegEncEncode(OrbisJpegEncHandle handle, const OrbisJpegEncE
               magic_enum::enum_name(param->sampling_type), param->compression_ratio,
               param->restart_interval);
 
+    if (param->image_width == 0 || param->image_height == 0) {
+        LOG_ERROR(Lib_Jpeg, "Empty image");
+        return ORBIS_JPEG_ENC_ERROR_INVALID_PARAM;
+    }
+
+    JpegEncoder encoder{*param};
+    const auto size = encoder.Encode();
+    if (!size) {
+        LOG_ERROR(Lib_Jpeg, "Output buffer of {} bytes is too small", param->jpeg_size);
+        return ORBIS_JPEG_ENC_ERROR_INVALID_SIZE;
+    }
+
     if (output_info) {
-        output_info->size = param->jpeg_size;
+        output_info->size = *size;
         output_info->height = param->image_height;
     }
     return ORBIS_OK;
@@ -0,0 +1,663 @@
+// SPDX-FileCopyrightText: Copyright 2025 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <span>
+#include <thread>
+
+#include "common/assert.h"
+#include "core/libraries/jpeg/jpegenc_impl.h"
+
+#ifdef __AVX2__
+#define JPEG_ENC_USE_AVX
+#include <immintrin.h>
+#endif
+
+namespace Libraries::JpegEnc {
+
+namespace {
+
+/// Upper bound of host threads used for a single image.
+constexpr u32 MaxWorkers = 8;
+
+/// Images with at least this many MCUs get a restart marker per MCU row when the guest did
+/// not ask for a restart interval, so they can still be encoded in parallel.
+constexpr u32 ImplicitRestartMinMcus = 1024;
+
+// Maps natural order coefficient indices to their zigzag position.
+constexpr std::array<u8, 64> ZigZag = {
+    0,  1,  5,  6,  14, 15, 27, 28, 2,  4,  7,  13, 16, 26, 29, 42, 3,  8,  12, 17, 25, 30,
+    41, 43, 9,  11, 18, 24, 31, 40, 44, 53, 10, 19, 23, 32, 39, 45, 52, 54, 20, 22, 33, 38,
+    46, 51, 55, 60, 21, 34, 37, 47, 50, 56, 59, 61, 35, 36, 48, 49, 57, 58, 62, 63,
+};
+
+// ITU T.81 Annex K quantization tables, natural order.
+constexpr std::array<u8, 64> LumaQuant = {
+    16, 11, 10, 16, 24,  40,  51,  61,  12, 12, 14, 19, 26,  58,  60,  55,
+    14, 13, 16, 24, 40,  57,  69,  56,  14, 17, 22, 29, 51,  87,  80,  62,
+    18, 22, 37, 56, 68,  109, 103, 77,  24, 35, 55, 64, 81,  104, 113, 92,
+    49, 64, 78, 87, 103, 121, 120, 101, 72, 92, 95, 98, 112, 100, 103, 99,
+};
+
+constexpr std::array<u8, 64> ChromaQuant = {
+    17, 18, 24, 47, 99, 99, 99, 99, 18, 21, 26, 66, 99, 99, 99, 99, 24, 26, 56, 99, 99, 99,
+    99, 99, 47, 66, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99,
+    99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99,
+};
+
+// ITU T.81 Annex K Huffman tables.
+constexpr std::array<u8, 16> LumaDcBits = {0, 1, 5, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0};
+constexpr std::array<u8, 16> ChromaDcBits = {0, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0};
+constexpr std::array<u8, 12> DcValues = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+
+constexpr std::array<u8, 16> LumaAcBits = {0, 2, 1, 3, 3, 2, 4, 3, 5, 5, 4, 4, 0, 0, 1, 0x7d};
+constexpr std::array<u8, 162> LumaAcValues = {
+    0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21, 0x31, 0x41, 0x06, 0x13, 0x51, 0x61,
+    0x07, 0x22, 0x71, 0x14, 0x32, 0x81, 0x91, 0xa1, 0x08, 0x23, 0x42, 0xb1, 0xc1, 0x15, 0x52,
+    0xd1, 0xf0, 0x24, 0x33, 0x62, 0x72, 0x82, 0x09, 0x0a, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x25,
+    0x26, 0x27, 0x28, 0x29, 0x2a, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x43, 0x44, 0x45,
+    0x46, 0x47, 0x48, 0x49, 0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x63, 0x64,
+    0x65, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x83,
+    0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99,
+    0x9a, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6,
+    0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3,
+    0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xe1, 0xe2, 0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8,
+    0xe9, 0xea, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa,
+};
+
+constexpr std::array<u8, 16> ChromaAcBits = {0, 2, 1, 2, 4, 4, 3, 4, 7, 5, 4, 4, 0, 1, 2, 0x77};
+constexpr std::array<u8, 162> ChromaAcValues = {
+    0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31, 0x06, 0x12, 0x41, 0x51, 0x07, 0x61,
+    0x71, 0x13, 0x22, 0x32, 0x81, 0x08, 0x14, 0x42, 0x91, 0xa1, 0xb1, 0xc1, 0x09, 0x23, 0x33,
+    0x52, 0xf0, 0x15, 0x62, 0x72, 0xd1, 0x0a, 0x16, 0x24, 0x34, 0xe1, 0x25, 0xf1, 0x17, 0x18,
+    0x19, 0x1a, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x43, 0x44,
+    0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x63,
+    0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a,
+    0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97,
+    0x98, 0x99, 0x9a, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4,
+    0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca,
+    0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xe2, 0xe3, 0xe4, 0xe5, 0xe6, 0xe7,
+    0xe8, 0xe9, 0xea, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa,
+};
+
+struct HuffTable {
+    std::array<u16, 256> code{};
+    std::array<u8, 256> size{};
+
+    HuffTable(std::span<const u8, 16> bits, std::span<const u8> values) {
+        u32 k = 0;
+        u16 next = 0;
+        for (u32 len = 1; len <= 16; ++len) {
+            for (u32 i = 0; i < bits[len - 1]; ++i, ++k) {
+                code[values[k]] = next++;
+                size[values[k]] = static_cast<u8>(len);
+            }
+            next <<= 1;
+        }
+    }
+};
+
+const HuffTable& GetHuffTable(u32 table, bool ac) {
+    static const std::array<HuffTable, 4> tables = {
+        HuffTable{LumaDcBits, DcValues},
+        HuffTable{LumaAcBits, LumaAcValues},
+        HuffTable{ChromaDcBits, DcValues},
+        HuffTable{ChromaAcBits, ChromaAcValues},
+    };
+    return tables[table * 2 + (ac ? 1 : 0)];
+}
+
+/// Entropy coded segment writer, with 0xFF byte stuffing.
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<u8>& out) : out{out} {}
+
+    void Put(u32 value, u32 length) {
+        acc = (acc << length) | value;
+        bits += length;
+        while (bits >= 8) {
+            bits -= 8;
+            const u8 byte = static_cast<u8>(acc >> bits);
+            out.push_back(byte);
+            if (byte == 0xFF) {
+                out.push_back(0);
+            }
+        }
+    }
+
+    void PutSymbol(const HuffTable& table, u32 symbol) {
+        Put(table.code[symbol], table.size[symbol]);
+    }
+
+    /// Pads the last byte with one bits, as required before a marker.
+    void Flush() {
+        if (bits != 0) {
+            Put((1U << (8 - bits)) - 1, 8 - bits);
+        }
+    }
+
+private:
+    std::vector<u8>& out;
+    u64 acc{};
+    u32 bits{};
+};
+
+inline u32 Category(s32 value) {
+    return static_cast<u32>(std::bit_width(static_cast<u32>(std::abs(value))));
+}
+
+inline u32 ValueBits(s32 value, u32 category) {
+    return static_cast<u32>(value < 0 ? value - 1 : value) & ((1U << category) - 1);
+}
+
+void EncodeBlock(BitWriter& writer, const std::array<s16, 64>& coefs, s32& dc_pred,
+                 const HuffTable& dc_table, const HuffTable& ac_table) {
+    const s32 diff = coefs[0] - dc_pred;
+    dc_pred = coefs[0];
+    const u32 dc_category = Category(diff);
+    writer.PutSymbol(dc_table, dc_category);
+    if (dc_category != 0) {
+        writer.Put(ValueBits(diff, dc_category), dc_category);
+    }
+
+    u32 run = 0;
+    for (u32 k = 1; k < 64; ++k) {
+        const s32 coef = coefs[k];
+        if (coef == 0) {
+            ++run;
+            continue;
+        }
+        for (; run > 15; run -= 16) {
+            writer.PutSymbol(ac_table, 0xF0);
+        }
+        const u32 category = Category(coef);
+        writer.PutSymbol(ac_table, (run << 4) | category);
+        writer.Put(ValueBits(coef, category), category);
+        run = 0;
+    }
+    if (run != 0) {
+        writer.PutSymbol(ac_table, 0x00);
+    }
+}
+
+/// One dimensional AAN forward DCT over 8 values. T is either float or an 8 lane vector, in
+/// which case 8 independent transforms run at once.
+template <typename T>
+inline void Dct8(T* d, T c4, T c6, T c2_minus_c6, T c2_plus_c6) {
+    const T tmp0 = d[0] + d[7];
+    const T tmp7 = d[0] - d[7];
+    const T tmp1 = d[1] + d[6];
+    const T tmp6 = d[1] - d[6];
+    const T tmp2 = d[2] + d[5];
+    const T tmp5 = d[2] - d[5];
+    const T tmp3 = d[3] + d[4];
+    const T tmp4 = d[3] - d[4];
+
+    // Even part
+    const T tmp10 = tmp0 + tmp3;
+    const T tmp13 = tmp0 - tmp3;
+    const T tmp11 = tmp1 + tmp2;
+    const T tmp12 = tmp1 - tmp2;
+    d[0] = tmp10 + tmp11;
+    d[4] = tmp10 - tmp11;
+    const T z1 = (tmp12 + tmp13) * c4;
+    d[2] = tmp13 + z1;
+    d[6] = tmp13 - z1;
+
+    // Odd part
+    const T odd10 = tmp4 + tmp5;
+    const T odd11 = tmp5 + tmp6;
+    const T odd12 = tmp6 + tmp7;
+    const T z5 = (odd10 - odd12) * c6;
+    const T z2 = odd10 * c2_minus_c6 + z5;
+    const T z4 = odd12 * c2_plus_c6 + z5;
+    const T z3 = odd11 * c4;
+    const T z11 = tmp7 + z3;
+    const T z13 = tmp7 - z3;
+    d[5] = z13 + z2;
+    d[3] = z13 - z2;
+    d[1] = z11 + z4;
+    d[7] = z11 - z4;
+}
+
+constexpr float C4 = 0.707106781f;
+constexpr float C6 = 0.382683433f;
+constexpr float C2MinusC6 = 0.541196100f;
+constexpr float C2PlusC6 = 1.306562965f;
+
+#ifdef JPEG_ENC_USE_AVX
+inline void Transpose8x8(__m256* r) {
+    const __m256 t0 = _mm256_unpacklo_ps(r[0], r[1]);
+    const __m256 t1 = _mm256_unpackhi_ps(r[0], r[1]);
+    const __m256 t2 = _mm256_unpacklo_ps(r[2], r[3]);
+    const __m256 t3 = _mm256_unpackhi_ps(r[2], r[3]);
+    const __m256 t4 = _mm256_unpacklo_ps(r[4], r[5]);
+    const __m256 t5 = _mm256_unpackhi_ps(r[4], r[5]);
+    const __m256 t6 = _mm256_unpacklo_ps(r[6], r[7]);
+    const __m256 t7 = _mm256_unpackhi_ps(r[6], r[7]);
+    const __m256 s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+    r[0] = _mm256_permute2f128_ps(s0, s4, 0x20);
+    r[1] = _mm256_permute2f128_ps(s1, s5, 0x20);
+    r[2] = _mm256_permute2f128_ps(s2, s6, 0x20);
+    r[3] = _mm256_permute2f128_ps(s3, s7, 0x20);
+    r[4] = _mm256_permute2f128_ps(s0, s4, 0x31);
+    r[5] = _mm256_permute2f128_ps(s1, s5, 0x31);
+    r[6] = _mm256_permute2f128_ps(s2, s6, 0x31);
+    r[7] = _mm256_permute2f128_ps(s3, s7, 0x31);
+}
+#endif
+
+/// Transforms and quantizes an 8x8 block of level shifted samples with the given row stride.
+/// Output coefficients are in zigzag order.
+void ForwardDct(const float* src, u32 stride, const std::array<float, 64>& divisors,
+                std::array<s16, 64>& out) {
+    alignas(32) std::array<s32, 64> quantized;
+#ifdef JPEG_ENC_USE_AVX
+    __m256 rows[8];
+    for (u32 i = 0; i < 8; ++i) {
+        rows[i] = _mm256_loadu_ps(src + i * stride);
+    }
+    const __m256 c4 = _mm256_set1_ps(C4);
+    const __m256 c6 = _mm256_set1_ps(C6);
+    const __m256 c2_minus_c6 = _mm256_set1_ps(C2MinusC6);
+    const __m256 c2_plus_c6 = _mm256_set1_ps(C2PlusC6);
+    // Vertical pass across rows, then horizontal pass on the transposed block.
+    Dct8(rows, c4, c6, c2_minus_c6, c2_plus_c6);
+    Transpose8x8(rows);
+    Dct8(rows, c4, c6, c2_minus_c6, c2_plus_c6);
+    Transpose8x8(rows);
+    for (u32 i = 0; i < 8; ++i) {
+        const __m256 v = _mm256_mul_ps(rows[i], _mm256_loadu_ps(divisors.data() + i * 8));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(quantized.data() + i * 8),
+                           _mm256_cvtps_epi32(v));
+    }
+#else
+    std::array<float, 64> block;
+    for (u32 i = 0; i < 8; ++i) {
+        std::memcpy(block.data() + i * 8, src + i * stride, 8 * sizeof(float));
+        Dct8(block.data() + i * 8, C4, C6, C2MinusC6, C2PlusC6);
+    }
+    for (u32 c = 0; c < 8; ++c) {
+        std::array<float, 8> column;
+        for (u32 r = 0; r < 8; ++r) {
+            column[r] = block[r * 8 + c];
+        }
+        Dct8(column.data(), C4, C6, C2MinusC6, C2PlusC6);
+        for (u32 r = 0; r < 8; ++r) {
+            block[r * 8 + c] = column[r];
+        }
+    }
+    for (u32 i = 0; i < 64; ++i) {
+        quantized[i] = static_cast<s32>(std::lrint(block[i] * divisors[i]));
+    }
+#endif
+    for (u32 i = 0; i < 64; ++i) {
+        // Baseline AC coefficients must fit in 10 bits, which also keeps DC differences in 11.
+        out[ZigZag[i]] = static_cast<s16>(std::clamp(quantized[i], -1023, 1023));
+    }
+}
+
+/// Scratch planes for one MCU of at most 16x16 pixels, level shifted.
+struct McuPlanes {
+    static constexpr u32 Stride = 16;
+
+    alignas(32) std::array<float, Stride * 16> y;
+    alignas(32) std::array<float, Stride * 16> cb;
+    alignas(32) std::array<float, Stride * 16> cr;
+    alignas(32) std::array<float, 64> cb_sub;
+    alignas(32) std::array<float, 64> cr_sub;
+};
+
+inline void RgbToYcc(float r, float g, float b, float* y, float* cb, float* cr) {
+    *y = 0.299f * r + 0.587f * g + 0.114f * b - 128.0f;
+    *cb = -0.168736f * r - 0.331264f * g + 0.5f * b;
+    *cr = 0.5f * r - 0.418688f * g - 0.081312f * b;
+}
+
+/// Converts `count` pixels (at most 8) of a row starting at `x`, replicating the last column
+/// past the right edge of the image.
+void ConvertPixels(const OrbisJpegEncEncodeParam& param, const u8* row, u32 x, u32 count,
+                   float* y, float* cb, float* cr) {
+    const u32 last = param.image_width - 1;
+    const bool full_vector = count == 8 && x + 8 <= param.image_width;
+    switch (param.pixel_format) {
+    case ORBIS_JPEG_ENC_PIXEL_FORMAT_R8G8B8A8:
+    case ORBIS_JPEG_ENC_PIXEL_FORMAT_B8G8R8A8: {
+        const bool bgr = param.pixel_format == ORBIS_JPEG_ENC_PIXEL_FORMAT_B8G8R8A8;
+#ifdef JPEG_ENC_USE_AVX
+        if (full_vector) {
+            const __m256i px = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + x * 4));
+            const __m256i mask = _mm256_set1_epi32(0xFF);
+            const __m256 c0 = _mm256_cvtepi32_ps(_mm256_and_si256(px, mask));
+            const __m256 g = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(px, 8), mask));
+            const __m256 c2 = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(px, 16), mask));
+            const __m256 r = bgr ? c2 : c0;
+            const __m256 b = bgr ? c0 : c2;
+            const auto dot = [&](float kr, float kg, float kb, float bias) {
+                return _mm256_fmadd_ps(
+                    r, _mm256_set1_ps(kr),
+                    _mm256_fmadd_ps(g, _mm256_set1_ps(kg),
+                                    _mm256_fmadd_ps(b, _mm256_set1_ps(kb), _mm256_set1_ps(bias))));
+            };
+            _mm256_storeu_ps(y, dot(0.299f, 0.587f, 0.114f, -128.0f));
+            _mm256_storeu_ps(cb, dot(-0.168736f, -0.331264f, 0.5f, 0.0f));
+            _mm256_storeu_ps(cr, dot(0.5f, -0.418688f, -0.081312f, 0.0f));
+            return;
+        }
+#endif
+        for (u32 i = 0; i < count; ++i) {
+            const u8* px = row + std::min(x + i, last) * 4;
+            const float r = px[bgr ? 2 : 0];
+            const float g = px[1];
+            const float b = px[bgr ? 0 : 2];
+            RgbToYcc(r, g, b, y + i, cb + i, cr + i);
+        }
+        return;
+    }
+    case ORBIS_JPEG_ENC_PIXEL_FORMAT_Y8U8Y8V8: {
+#ifdef JPEG_ENC_USE_AVX
+        if (full_vector && (x & 1) == 0) {
+            const __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x * 2));
+            const auto extract = [&](__m128i shuffle) {
+                const __m128i bytes = _mm_shuffle_epi8(px, shuffle);
+                return _mm256_sub_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(bytes)),
+                                     _mm256_set1_ps(128.0f));
+            };
+            _mm256_storeu_ps(y, extract(_mm_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, -1, -1, -1, -1,
+                                                      -1, -1, -1, -1)));
+            _mm256_storeu_ps(cb, extract(_mm_setr_epi8(1, 1, 5, 5, 9, 9, 13, 13, -1, -1, -1, -1,
+                                                       -1, -1, -1, -1)));
+            _mm256_storeu_ps(cr, extract(_mm_setr_epi8(3, 3, 7, 7, 11, 11, 15, 15, -1, -1, -1, -1,
+                                                       -1, -1, -1, -1)));
+            return;
+        }
+#endif
+        for (u32 i = 0; i < count; ++i) {
+            const u32 px = std::min(x + i, last);
+            const u8* pair = row + (px & ~1U) * 2;
+            y[i] = static_cast<float>(row[px * 2]) - 128.0f;
+            cb[i] = static_cast<float>(pair[1]) - 128.0f;
+            cr[i] = static_cast<float>(pair[3]) - 128.0f;
+        }
+        return;
+    }
+    case ORBIS_JPEG_ENC_PIXEL_FORMAT_Y8: {
+#ifdef JPEG_ENC_USE_AVX
+        if (full_vector) {
+            const __m128i px = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(row + x));
+            _mm256_storeu_ps(y, _mm256_sub_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(px)),
+                                              _mm256_set1_ps(128.0f)));
+            return;
+        }
+#endif
+        for (u32 i = 0; i < count; ++i) {
+            y[i] = static_cast<float>(row[std::min(x + i, last)]) - 128.0f;
+        }
+        return;
+    }
+    default:
+        UNREACHABLE_MSG("Unsupported pixel format {}", static_cast<u32>(param.pixel_format));
+    }
+}
+
+} // Anonymous namespace
+
+JpegEncoder::JpegEncoder(const OrbisJpegEncEncodeParam& param_) : param{param_} {
+    if (param.color_space == ORBIS_JPEG_ENC_COLOR_SPACE_GRAYSCALE) {
+        num_components = 1;
+        components[0] = {1, 1, 1, 0};
+    } else {
+        const u8 v = param.sampling_type == ORBIS_JPEG_ENC_SAMPLING_TYPE_420 ? 2 : 1;
+        num_components = 3;
+        components[0] = {1, 2, v, 0};
+        components[1] = {2, 1, 1, 1};
+        components[2] = {3, 1, 1, 1};
+    }
+    mcu_width = components[0].h * 8;
+    mcu_height = components[0].v * 8;
+    mcus_x = (param.image_width + mcu_width - 1) / mcu_width;
+    mcus_y = (param.image_height + mcu_height - 1) / mcu_height;
+
+    restart_interval = static_cast<u32>(std::max(param.restart_interval, 0));
+    if (restart_interval == 0 && mcus_y > 1 && mcus_x * mcus_y >= ImplicitRestartMinMcus) {
+        restart_interval = mcus_x;
+    }
+
+    BuildQuantTables(param.compression_ratio);
+}
+
+void JpegEncoder::BuildQuantTables(u8 compression_ratio) {
+    // Lower ratios give better quality; a ratio of 1 (or 0) is treated as quality 100.
+    const s32 quality = std::clamp(101 - static_cast<s32>(compression_ratio), 1, 100);
+    const s32 scale = quality < 50 ? 5000 / quality : 200 - quality * 2;
+
+    // AAN scale factors, folded into the quantizer divisors.
+    constexpr std::array<float, 8> aan_scale = {
+        1.0f * 2.828427125f,         1.387039845f * 2.828427125f, 1.306562965f * 2.828427125f,
+        1.175875602f * 2.828427125f, 1.0f * 2.828427125f,         0.785694958f * 2.828427125f,
+        0.541196100f * 2.828427125f, 0.275899379f * 2.828427125f,
+    };
+
+    for (u32 t = 0; t < 2; ++t) {
+        const auto& base = t == 0 ? LumaQuant : ChromaQuant;
+        for (u32 i = 0; i < 64; ++i) {
+            const s32 q = std::clamp((base[i] * scale + 50) / 100, 1, 255);
+            quant_tables[t][ZigZag[i]] = static_cast<u8>(q);
+            scaled_divisors[t][i] = 1.0f / (static_cast<float>(q) * aan_scale[i / 8] *
+                                            aan_scale[i % 8]);
+        }
+    }
+}
+
+void JpegEncoder::WriteHeaders(std::vector<u8>& out) const {
+    const auto put16 = [&](u32 value) {
+        out.push_back(static_cast<u8>(value >> 8));
+        out.push_back(static_cast<u8>(value));
+    };
+    const auto marker = [&](u8 type) {
+        out.push_back(0xFF);
+        out.push_back(type);
+    };
+    const bool mjpeg = param.encode_mode == ORBIS_JPEG_ENC_ENCODE_MODE_MJPEG;
+    const u32 num_tables = num_components == 1 ? 1 : 2;
+
+    marker(0xD8); // SOI
+    if (!mjpeg) {
+        marker(0xE0); // APP0
+        put16(16);
+        constexpr std::array<u8, 14> jfif = {'J', 'F', 'I', 'F', 0, 1, 1, 0, 0, 1, 0, 1, 0, 0};
+        out.insert(out.end(), jfif.begin(), jfif.end());
+    }
+
+    marker(0xDB); // DQT
+    put16(2 + num_tables * 65);
+    for (u32 t = 0; t < num_tables; ++t) {
+        out.push_back(static_cast<u8>(t));
+        out.insert(out.end(), quant_tables[t].begin(), quant_tables[t].end());
+    }
+
+    marker(0xC0); // SOF0
+    put16(8 + num_components * 3);
+    out.push_back(8);
+    put16(param.image_height);
+    put16(param.image_width);
+    out.push_back(static_cast<u8>(num_components));
+    for (u32 c = 0; c < num_components; ++c) {
+        out.push_back(components[c].id);
+        out.push_back(static_cast<u8>((components[c].h << 4) | components[c].v));
+        out.push_back(components[c].table);
+    }
+
+    // Motion JPEG frames leave out the Huffman tables, decoders use the standard ones.
+    if (!mjpeg) {
+        const auto put_table = [&](u8 id, std::span<const u8, 16> bits,
+                                   std::span<const u8> values) {
+            out.push_back(id);
+            out.insert(out.end(), bits.begin(), bits.end());
+            out.insert(out.end(), values.begin(), values.end());
+        };
+        marker(0xC4); // DHT
+        put16(2 + (1 + 16 + DcValues.size() + 1 + 16 + LumaAcValues.size()) * num_tables);
+        put_table(0x00, LumaDcBits, DcValues);
+        put_table(0x10, LumaAcBits, LumaAcValues);
+        if (num_tables == 2) {
+            put_table(0x01, ChromaDcBits, DcValues);
+            put_table(0x11, ChromaAcBits, ChromaAcValues);
+        }
+    }
+
+    if (restart_interval != 0) {
+        marker(0xDD); // DRI
+        put16(4);
+        put16(restart_interval);
+    }
+
+    marker(0xDA); // SOS
+    put16(6 + num_components * 2);
+    out.push_back(static_cast<u8>(num_components));
+    for (u32 c = 0; c < num_components; ++c) {
+        out.push_back(components[c].id);
+        out.push_back(static_cast<u8>((components[c].table << 4) | components[c].table));
+    }
+    out.push_back(0);
+    out.push_back(63);
+    out.push_back(0);
+}
+
+void JpegEncoder::EncodeSegments(u32 first_segment, u32 last_segment,
+                                 std::vector<u8>& out) const {
+    const u32 num_mcus = mcus_x * mcus_y;
+    const u32 mcus_per_segment = restart_interval != 0 ? restart_interval : num_mcus;
+    const u32 num_segments = (num_mcus + mcus_per_segment - 1) / mcus_per_segment;
+    const auto* image = static_cast<const u8*>(param.image);
+    const bool color = num_components == 3;
+    const u32 h_sub = components[0].h;
+    const u32 v_sub = components[0].v;
+
+    McuPlanes planes;
+    std::array<s16, 64> coefs;
+    for (u32 segment = first_segment; segment < last_segment; ++segment) {
+        BitWriter writer{out};
+        std::array<s32, 3> dc_pred{};
+        const u32 mcu_end = std::min((segment + 1) * mcus_per_segment, num_mcus);
+        for (u32 mcu = segment * mcus_per_segment; mcu < mcu_end; ++mcu) {
+            const u32 x0 = (mcu % mcus_x) * mcu_width;
+            const u32 y0 = (mcu / mcus_x) * mcu_height;
+
+            // Convert the MCU, replicating the last row and column at the image edges.
+            for (u32 r = 0; r < mcu_height; ++r) {
+                const u32 src_y = std::min(y0 + r, param.image_height - 1);
+                const u8* row = image + static_cast<size_t>(src_y) * param.image_pitch;
+                for (u32 x = 0; x < mcu_width; x += 8) {
+                    const u32 offset = r * McuPlanes::Stride + x;
+                    ConvertPixels(param, row, x0 + x, 8, planes.y.data() + offset,
+                                  planes.cb.data() + offset, planes.cr.data() + offset);
+                }
+            }
+
+            for (u32 by = 0; by < v_sub; ++by) {
+                for (u32 bx = 0; bx < h_sub; ++bx) {
+                    ForwardDct(planes.y.data() + by * 8 * McuPlanes::Stride + bx * 8,
+                               McuPlanes::Stride, scaled_divisors[0], coefs);
+                    EncodeBlock(writer, coefs, dc_pred[0], GetHuffTable(0, false),
+                                GetHuffTable(0, true));
+                }
+            }
+            if (!color) {
+                continue;
+            }
+
+            // Average the chroma planes down to a single 8x8 block.
+            const float weight = 1.0f / static_cast<float>(h_sub * v_sub);
+            for (u32 r = 0; r < 8; ++r) {
+                for (u32 c = 0; c < 8; ++c) {
+                    float cb = 0.0f;
+                    float cr = 0.0f;
+                    for (u32 sy = 0; sy < v_sub; ++sy) {
+                        for (u32 sx = 0; sx < h_sub; ++sx) {
+                            const u32 i = (r * v_sub + sy) * McuPlanes::Stride + c * h_sub + sx;
+                            cb += planes.cb[i];
+                            cr += planes.cr[i];
+                        }
+                    }
+                    planes.cb_sub[r * 8 + c] = cb * weight;
+                    planes.cr_sub[r * 8 + c] = cr * weight;
+                }
+            }
+            ForwardDct(planes.cb_sub.data(), 8, scaled_divisors[1], coefs);
+            EncodeBlock(writer, coefs, dc_pred[1], GetHuffTable(1, false), GetHuffTable(1, true));
+            ForwardDct(planes.cr_sub.data(), 8, scaled_divisors[1], coefs);
+            EncodeBlock(writer, coefs, dc_pred[2], GetHuffTable(1, false), GetHuffTable(1, true));
+        }
+        writer.Flush();
+        if (segment + 1 != num_segments) {
+            out.push_back(0xFF);
+            out.push_back(static_cast<u8>(0xD0 + (segment & 7))); // RSTn
+        }
+    }
+}
+
+std::optional<u32> JpegEncoder::Encode() {
+    const u32 num_mcus = mcus_x * mcus_y;
+    const u32 num_segments =
+        restart_interval != 0 ? (num_mcus + restart_interval - 1) / restart_interval : 1;
+
+    std::vector<u8> header;
+    WriteHeaders(header);
+
+    // Segments are independent, so split them into more chunks than workers and let each
+    // worker pick up the next chunk when done, which keeps busy and flat areas balanced.
+    const u32 num_workers =
+        std::clamp(std::thread::hardware_concurrency(), 1U, std::min(MaxWorkers, num_segments));
+    const u32 num_chunks = std::min(num_segments, num_workers * 4);
+    std::vector<std::vector<u8>> chunks(num_chunks);
+    std::atomic<u32> next_chunk{0};
+    const auto worker = [&] {
+        for (u32 chunk = next_chunk++; chunk < num_chunks; chunk = next_chunk++) {
+            const u32 first = static_cast<u32>(u64(chunk) * num_segments / num_chunks);
+            const u32 last = static_cast<u32>(u64(chunk + 1) * num_segments / num_chunks);
+            chunks[chunk].reserve(size_t(last - first) * restart_interval * 64);
+            EncodeSegments(first, last, chunks[chunk]);
+        }
+    };
+    {
+        std::vector<std::jthread> threads;
+        threads.reserve(num_workers - 1);
+        for (u32 i = 1; i < num_workers; ++i) {
+            threads.emplace_back(worker);
+        }
+        worker();
+    }
+
+    size_t total_size = header.size() + 2;
+    for (const auto& chunk : chunks) {
+        total_size += chunk.size();
+    }
+    if (total_size > param.jpeg_size) {
+        return std::nullopt;
+    }
+
+    auto* out = static_cast<u8*>(param.jpeg);
+    std::memcpy(out, header.data(), header.size());
+    out += header.size();
+    for (const auto& chunk : chunks) {
+        std::memcpy(out, chunk.data(), chunk.size());
+        out += chunk.size();
+    }
+    out[0] = 0xFF;
+    out[1] = 0xD9; // EOI
+    return static_cast<u32>(total_size);
+}
+
+} // namespace Libraries::JpegEnc
@@ -0,0 +1,49 @@
+// SPDX-FileCopyrightText: Copyright 2025 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <optional>
+#include <vector>
+
+#include "common/types.h"
+#include "core/libraries/jpeg/jpegenc.h"
+
+namespace Libraries::JpegEnc {
+
+/// Baseline JPEG encoder backing sceJpegEncEncode. Encoding runs on host worker threads,
+/// split at restart interval boundaries, so it never needs memory from the guest handle.
+class JpegEncoder {
+public:
+    explicit JpegEncoder(const OrbisJpegEncEncodeParam& param);
+
+    /// Encodes the image into the guest output buffer.
+    /// Returns the number of bytes written, or std::nullopt if the buffer is too small.
+    std::optional<u32> Encode();
+
+private:
+    struct Component {
+        u8 id;
+        u8 h;
+        u8 v;
+        u8 table;
+    };
+
+    void BuildQuantTables(u8 compression_ratio);
+    void WriteHeaders(std::vector<u8>& out) const;
+    void EncodeSegments(u32 first_segment, u32 last_segment, std::vector<u8>& out) const;
+
+    const OrbisJpegEncEncodeParam& param;
+    std::array<Component, 3> components{};
+    u32 num_components{};
+    u32 mcu_width{};
+    u32 mcu_height{};
+    u32 mcus_x{};
+    u32 mcus_y{};
+    u32 restart_interval{};
+    std::array<std::array<u8, 64>, 2> quant_tables{};
+    std::array<std::array<float, 64>, 2> scaled_divisors{};
+};
+
+} // namespace Libraries::JpegEnc
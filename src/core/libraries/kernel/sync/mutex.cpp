@@ -5,8 +5,46 @@
 
 #include "common/assert.h"
 
+#ifdef __linux__
+#include <cerrno>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 namespace Libraries::Kernel {
 
+#ifdef __linux__
+namespace {
+
+constexpr u32 Unlocked = 0;
+constexpr u32 Locked = 1;
+constexpr u32 Contended = 2;
+
+long Futex(std::atomic<u32>* addr, int op, u32 val, const timespec* timeout = nullptr,
+           u32 val3 = 0) {
+    return syscall(SYS_futex, reinterpret_cast<u32*>(addr), op | FUTEX_PRIVATE_FLAG, val, timeout,
+                   nullptr, val3);
+}
+
+template <class Clock>
+timespec ToTimespec(std::chrono::time_point<Clock> time) {
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch());
+    return timespec{
+        .tv_sec = static_cast<time_t>(ns.count() / 1'000'000'000),
+        .tv_nsec = static_cast<long>(ns.count() % 1'000'000'000),
+    };
+}
+
+u32 CurrentTid() {
+    thread_local const u32 tid = static_cast<u32>(syscall(SYS_gettid));
+    return tid;
+}
+
+} // Anonymous namespace
+#endif
+
 TimedMutex::TimedMutex() {
 #ifdef _WIN64
     mtx = CreateMutex(nullptr, false, nullptr);
@@ -28,6 +66,10 @@ void TimedMutex::lock() {
             return;
         }
     }
+#elif defined(__linux__)
+    if (!try_lock()) [[unlikely]] {
+        LockSlow();
+    }
 #else
     mtx.lock();
 #endif
@@ -36,6 +78,10 @@ void TimedMutex::lock() {
 bool TimedMutex::try_lock() {
 #ifdef _WIN64
     return WaitForSingleObjectEx(mtx, 0, true) == WAIT_OBJECT_0;
+#elif defined(__linux__)
+    u32 expected = Unlocked;
+    return state.compare_exchange_strong(expected, pi ? CurrentTid() : Locked,
+                                         std::memory_order_acquire, std::memory_order_relaxed);
 #else
     return mtx.try_lock();
 #endif
@@ -44,9 +90,64 @@ bool TimedMutex::try_lock() {
 void TimedMutex::unlock() {
 #ifdef _WIN64
     ReleaseMutex(mtx);
+#elif defined(__linux__)
+    if (pi) {
+        // The kernel sets FUTEX_WAITERS in the word when someone is blocked, which makes the
+        // fast path fail and hands ownership over with priority boosting undone.
+        u32 expected = CurrentTid();
+        if (!state.compare_exchange_strong(expected, Unlocked, std::memory_order_release,
+                                           std::memory_order_relaxed)) {
+            Futex(&state, FUTEX_UNLOCK_PI, 0);
+        }
+        return;
+    }
+    if (state.exchange(Unlocked, std::memory_order_release) == Contended) {
+        Futex(&state, FUTEX_WAKE, 1);
+    }
 #else
     mtx.unlock();
 #endif
 }
 
-} // namespace Libraries::Kernel
\ No newline at end of file
+#ifdef __linux__
+void TimedMutex::LockSlow() {
+    if (pi) {
+        while (Futex(&state, FUTEX_LOCK_PI, 0) != 0) {
+            ASSERT_MSG(errno == EINTR || errno == EAGAIN, "FUTEX_LOCK_PI failed: {}", errno);
+        }
+        return;
+    }
+    // Mark the lock contended so that the owner knows to wake us up on unlock.
+    while (state.exchange(Contended, std::memory_order_acquire) != Unlocked) {
+        Futex(&state, FUTEX_WAIT, Contended);
+    }
+}
+
+bool TimedMutex::LockUntil(std::chrono::steady_clock::time_point abs_time) {
+    // FUTEX_WAIT_BITSET takes an absolute CLOCK_MONOTONIC deadline, which is what steady_clock
+    // is backed by on Linux, so spurious wakeups do not need to recompute the timeout.
+    const timespec deadline = ToTimespec(abs_time);
+    while (state.exchange(Contended, std::memory_order_acquire) != Unlocked) {
+        if (Futex(&state, FUTEX_WAIT_BITSET, Contended, &deadline, FUTEX_BITSET_MATCH_ANY) != 0 &&
+            errno != EAGAIN && errno != EINTR) {
+            u32 expected = Unlocked;
+            return state.compare_exchange_strong(expected, Contended, std::memory_order_acquire,
+                                                 std::memory_order_relaxed);
+        }
+    }
+    return true;
+}
+
+bool TimedMutex::LockPiUntil(std::chrono::system_clock::time_point abs_time) {
+    // FUTEX_LOCK_PI always measures its timeout against CLOCK_REALTIME.
+    const timespec deadline = ToTimespec(abs_time);
+    while (Futex(&state, FUTEX_LOCK_PI, 0, &deadline) != 0) {
+        if (errno != EINTR && errno != EAGAIN) {
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
+} // namespace Libraries::Kernel
@@ -9,6 +9,8 @@
 
 #ifdef _WIN64
 #include <windows.h>
+#elif defined(__linux__)
+#include <atomic>
 #else
 #include <mutex>
 #endif
@@ -25,9 +27,19 @@ public:
 
     void unlock();
 
+#ifdef __linux__
+    /// Switches the mutex to a priority inheriting futex. Must be called while unlocked.
+    void SetPriorityInheritance(bool enable) {
+        pi = enable;
+    }
+#endif
+
     template <class Rep, class Period>
     bool try_lock_for(const std::chrono::duration<Rep, Period>& rel_time) {
-#ifdef _WIN64
+#ifdef __linux__
+        const auto rel_ns = std::chrono::ceil<std::chrono::nanoseconds>(rel_time);
+        return try_lock_until(std::chrono::steady_clock::now() + rel_ns);
+#elif defined(_WIN64)
         constexpr auto zero = std::chrono::duration<Rep, Period>::zero();
         const auto now = std::chrono::steady_clock::now();
 
@@ -49,7 +61,18 @@ public:
 
     template <class Clock, class Duration>
     bool try_lock_until(const std::chrono::time_point<Clock, Duration>& abs_time) {
-#ifdef _WIN64
+#ifdef __linux__
+        if (try_lock()) {
+            return true;
+        }
+        // Futex timeouts are expressed against CLOCK_MONOTONIC (or CLOCK_REALTIME for PI),
+        // so rebase the deadline of arbitrary clocks onto the one the kernel expects.
+        const auto rel_ns = std::chrono::ceil<std::chrono::nanoseconds>(abs_time - Clock::now());
+        if (pi) {
+            return LockPiUntil(std::chrono::system_clock::now() + rel_ns);
+        }
+        return LockUntil(std::chrono::steady_clock::now() + rel_ns);
+#elif defined(_WIN64)
         for (;;) {
             const auto now = Clock::now();
             if (abs_time <= now) {
@@ -72,6 +95,15 @@ public:
 private:
 #ifdef _WIN64
     HANDLE mtx;
+#elif defined(__linux__)
+    void LockSlow();
+    bool LockUntil(std::chrono::steady_clock::time_point abs_time);
+    bool LockPiUntil(std::chrono::system_clock::time_point abs_time);
+
+    // Plain mutexes use 0 = unlocked, 1 = locked, 2 = locked with waiters.
+    // PI mutexes hold the owner TID as required by FUTEX_LOCK_PI.
+    std::atomic<u32> state{0};
+    bool pi{false};
 #else
     std::timed_mutex mtx;
 #endif
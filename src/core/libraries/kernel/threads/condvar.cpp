@@ -28,10 +28,10 @@ static int CondInit(PthreadCondT* cond, const PthreadCondAttrT* cond_attr, const
     }
 
     if (name) {
-        cvp->name = name;
+        strncpy(cvp->name.data(), name, cvp->name.size() - 1);
     } else {
-        static int CondId = 0;
-        cvp->name = fmt::format("Cond{}", CondId++);
+        static std::atomic<int> CondId = 0;
+        fmt::format_to_n(cvp->name.data(), cvp->name.size() - 1, "Cond{}", CondId++);
     }
 
     if (cond_attr == nullptr || *cond_attr == nullptr) {
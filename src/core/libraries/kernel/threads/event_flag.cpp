@@ -1,13 +1,15 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
-#include <condition_variable>
+#include <chrono>
+#include <list>
 #include <mutex>
-#include <thread>
 
 #include "common/assert.h"
 #include "common/logging/log.h"
 #include "core/libraries/kernel/orbis_error.h"
+#include "core/libraries/kernel/sync/semaphore.h"
+#include "core/libraries/kernel/threads/pthread.h"
 #include "core/libraries/libs.h"
 
 namespace Libraries::Kernel {
@@ -36,66 +38,37 @@ public:
     int Wait(u64 bits, WaitMode wait_mode, ClearMode clear_mode, u64* result, u32* ptr_micros) {
         std::unique_lock lock{m_mutex};
 
-        uint32_t micros = 0;
-        bool infinitely = true;
-        if (ptr_micros != nullptr) {
-            micros = *ptr_micros;
-            infinitely = false;
-        }
-
-        if (m_thread_mode == ThreadMode::Single && m_waiting_threads > 0) {
+        if (m_thread_mode == ThreadMode::Single && !m_wait_list.empty()) {
             return ORBIS_KERNEL_ERROR_EPERM;
         }
 
-        auto const start = std::chrono::system_clock::now();
-        m_waiting_threads++;
-        auto waitFunc = [this, wait_mode, bits] {
-            return (m_status == Status::Canceled || m_status == Status::Deleted ||
-                    (wait_mode == WaitMode::And && (m_bits & bits) == bits) ||
-                    (wait_mode == WaitMode::Or && (m_bits & bits) != 0));
-        };
-
-        if (infinitely) {
-            m_cond_var.wait(lock, waitFunc);
-        } else {
-            if (!m_cond_var.wait_for(lock, std::chrono::microseconds(micros), waitFunc)) {
-                if (result != nullptr) {
-                    *result = m_bits;
-                }
-                *ptr_micros = 0;
-                --m_waiting_threads;
-                return ORBIS_KERNEL_ERROR_ETIMEDOUT;
+        if (IsSatisfied(m_bits, bits, wait_mode)) {
+            if (result != nullptr) {
+                *result = m_bits;
             }
-        }
-        --m_waiting_threads;
-        if (result != nullptr) {
-            *result = m_bits;
-        }
-
-        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
-                           std::chrono::system_clock::now() - start)
-                           .count();
-        if (result != nullptr) {
-            *result = m_bits;
+            ApplyClear(bits, clear_mode);
+            return ORBIS_OK;
         }
 
-        if (ptr_micros != nullptr) {
-            *ptr_micros = (elapsed >= micros ? 0 : micros - elapsed);
+        if (ptr_micros != nullptr && *ptr_micros == 0) {
+            if (result != nullptr) {
+                *result = m_bits;
+            }
+            return ORBIS_KERNEL_ERROR_ETIMEDOUT;
         }
 
-        if (m_status == Status::Canceled) {
-            return ORBIS_KERNEL_ERROR_ECANCELED;
-        } else if (m_status == Status::Deleted) {
-            return ORBIS_KERNEL_ERROR_EACCES;
+        // Park on a wait record of our own, Set only wakes the waiters it satisfies.
+        WaitingThread waiter{bits, wait_mode, clear_mode, m_queue_mode};
+        const auto it = AddWaiter(&waiter);
+        const int ret = waiter.Wait(lock, ptr_micros);
+        if (ret == ORBIS_KERNEL_ERROR_ETIMEDOUT) {
+            m_wait_list.erase(it);
+            waiter.result_bits = m_bits;
         }
-
-        if (clear_mode == ClearMode::All) {
-            m_bits = 0;
-        } else if (clear_mode == ClearMode::Bits) {
-            m_bits &= ~bits;
+        if (result != nullptr) {
+            *result = waiter.result_bits;
         }
-
-        return ORBIS_OK;
+        return ret;
     }
 
     int Poll(u64 bits, WaitMode wait_mode, ClearMode clear_mode, u64* result) {
@@ -109,63 +82,130 @@ public:
     }
 
     void Set(u64 bits) {
-        std::unique_lock lock{m_mutex};
+        std::scoped_lock lock{m_mutex};
+        m_bits |= bits;
 
-        while (m_status != Status::Set) {
-            m_mutex.unlock();
-            std::this_thread::sleep_for(std::chrono::microseconds(10));
-            m_mutex.lock();
+        // Wake up satisfied waiters in queue order. Each one consumes its clear mode before the
+        // next is checked, like the real kernel does.
+        for (auto it = m_wait_list.begin(); it != m_wait_list.end() && m_bits != 0;) {
+            auto* waiter = *it;
+            if (!IsSatisfied(m_bits, waiter->bits, waiter->wait_mode)) {
+                ++it;
+                continue;
+            }
+            it = m_wait_list.erase(it);
+            waiter->result_bits = m_bits;
+            ApplyClear(waiter->bits, waiter->clear_mode);
+            waiter->was_signaled = true;
+            waiter->sem.release();
         }
-
-        m_bits |= bits;
-        m_cond_var.notify_all();
     }
 
     void Clear(u64 bits) {
-        std::unique_lock lock{m_mutex};
-        while (m_status != Status::Set) {
-            m_mutex.unlock();
-            std::this_thread::sleep_for(std::chrono::microseconds(10));
-            m_mutex.lock();
-        }
-
+        std::scoped_lock lock{m_mutex};
         m_bits &= bits;
     }
 
     void Cancel(u64 setPattern, int* numWaitThreads) {
-        std::unique_lock lock{m_mutex};
-
-        while (m_status != Status::Set) {
-            m_mutex.unlock();
-            std::this_thread::sleep_for(std::chrono::microseconds(10));
-            m_mutex.lock();
-        }
+        std::scoped_lock lock{m_mutex};
 
         if (numWaitThreads) {
-            *numWaitThreads = m_waiting_threads;
+            *numWaitThreads = static_cast<int>(m_wait_list.size());
         }
 
-        m_status = Status::Canceled;
         m_bits = setPattern;
+        for (auto* waiter : m_wait_list) {
+            waiter->result_bits = setPattern;
+            waiter->was_canceled = true;
+            waiter->sem.release();
+        }
+        m_wait_list.clear();
+    }
+
+private:
+    struct WaitingThread {
+        BinarySemaphore sem;
+        u32 priority;
+        u64 bits;
+        WaitMode wait_mode;
+        ClearMode clear_mode;
+        u64 result_bits{};
+        bool was_signaled{};
+        bool was_canceled{};
+
+        explicit WaitingThread(u64 bits, WaitMode wait_mode, ClearMode clear_mode,
+                               QueueMode queue_mode)
+            : sem{0}, priority{0}, bits{bits}, wait_mode{wait_mode}, clear_mode{clear_mode} {
+            // Retrieve calling thread priority for sorting into waiting threads list.
+            if (queue_mode == QueueMode::ThreadPrio) {
+                priority = g_curthread->attr.prio;
+            }
+        }
 
-        m_cond_var.notify_all();
+        [[nodiscard]] int GetResult() const {
+            if (was_signaled) {
+                return ORBIS_OK;
+            }
+            if (was_canceled) {
+                return ORBIS_KERNEL_ERROR_ECANCELED;
+            }
+            return ORBIS_KERNEL_ERROR_ETIMEDOUT;
+        }
 
-        while (m_waiting_threads > 0) {
-            m_mutex.unlock();
-            std::this_thread::sleep_for(std::chrono::microseconds(10));
-            m_mutex.lock();
+        int Wait(std::unique_lock<std::mutex>& lk, u32* timeout) {
+            lk.unlock();
+            if (!timeout) {
+                // Wait indefinitely until we are woken up.
+                sem.acquire();
+                lk.lock();
+            } else {
+                // Wait until timeout runs out, recording how much remaining time there was.
+                const auto start = std::chrono::high_resolution_clock::now();
+                sem.try_acquire_for(std::chrono::microseconds(*timeout));
+                const auto end = std::chrono::high_resolution_clock::now();
+                const auto time =
+                    std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+                lk.lock();
+                if (was_signaled || was_canceled) {
+                    *timeout = time >= *timeout ? 0 : *timeout - time;
+                } else {
+                    *timeout = 0;
+                }
+            }
+            return GetResult();
         }
+    };
+
+    using WaitList = std::list<WaitingThread*>;
 
-        m_status = Status::Set;
+    static bool IsSatisfied(u64 pattern, u64 bits, WaitMode wait_mode) {
+        return wait_mode == WaitMode::And ? (pattern & bits) == bits : (pattern & bits) != 0;
     }
 
-private:
-    enum class Status { Set, Canceled, Deleted };
+    void ApplyClear(u64 bits, ClearMode clear_mode) {
+        if (clear_mode == ClearMode::All) {
+            m_bits = 0;
+        } else if (clear_mode == ClearMode::Bits) {
+            m_bits &= ~bits;
+        }
+    }
+
+    WaitList::iterator AddWaiter(WaitingThread* waiter) {
+        // Insert at the end of the list for FIFO order.
+        if (m_queue_mode == QueueMode::Fifo) {
+            m_wait_list.push_back(waiter);
+            return --m_wait_list.end();
+        }
+        // Find the first with lower priority (greater number) than us and insert right before it.
+        auto it = m_wait_list.begin();
+        while (it != m_wait_list.end() && (*it)->priority <= waiter->priority) {
+            ++it;
+        }
+        return m_wait_list.insert(it, waiter);
+    }
 
     std::mutex m_mutex;
-    std::condition_variable m_cond_var;
-    Status m_status = Status::Set;
-    int m_waiting_threads = 0;
+    WaitList m_wait_list;
     std::string m_name;
     ThreadMode m_thread_mode = ThreadMode::Single;
     QueueMode m_queue_mode = QueueMode::Fifo;
@@ -223,10 +263,6 @@ int PS4_SYSV_ABI sceKernelCreateEventFlag(OrbisKernelEventFlag* ef, const char*
         UNREACHABLE();
     }
 
-    if (queue_mode == EventFlagInternal::QueueMode::ThreadPrio) {
-        LOG_ERROR(Kernel_Event, "ThreadPriority attr is not supported!");
-    }
-
     *ef = new EventFlagInternal(std::string(pName), thread_mode, queue_mode, initPattern);
     return ORBIS_OK;
 }
@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <cstring>
 #include <thread>
 #include "common/assert.h"
 #include "common/types.h"
@@ -58,10 +59,10 @@ static int MutexInit(PthreadMutexT* mutex, const PthreadMutexAttr* mutex_attr, c
     }
 
     if (name) {
-        pmutex->name = name;
+        strncpy(pmutex->name.data(), name, pmutex->name.size() - 1);
     } else {
-        static int MutexId = 0;
-        pmutex->name = fmt::format("Mutex{}", MutexId++);
+        static std::atomic<int> MutexId = 0;
+        fmt::format_to_n(pmutex->name.data(), pmutex->name.size() - 1, "Mutex{}", MutexId++);
     }
 
     pmutex->m_flags = PthreadMutexFlags(attr->m_type);
@@ -70,6 +71,9 @@ static int MutexInit(PthreadMutexT* mutex, const PthreadMutexAttr* mutex_attr, c
     pmutex->m_spinloops = 0;
     pmutex->m_yieldloops = 0;
     pmutex->m_protocol = attr->m_protocol;
+#ifdef __linux__
+    pmutex->m_lock.SetPriorityInheritance(attr->m_protocol == PthreadMutexProt::Inherit);
+#endif
     if (attr->m_type == PthreadMutexType::AdaptiveNp) {
         pmutex->m_spinloops = MUTEX_ADAPTIVE_SPINS;
         // pmutex->m_yieldloops = _thr_yieldloops;
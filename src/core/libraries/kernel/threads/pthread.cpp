@@ -4,6 +4,7 @@
 #include "common/assert.h"
 #include "common/thread.h"
 #include "core/debug_state.h"
+#include "core/guest_profiler.h"
 #include "core/libraries/kernel/kernel.h"
 #include "core/libraries/kernel/posix_error.h"
 #include "core/libraries/kernel/threads.h"
@@ -40,6 +41,8 @@ static void ExitThread() {
         _thread_cleanupspecific();
     }
 
+    Core::Profiler::Instance()->UnregisterCurrentThread();
+
     auto* thread_state = ThrState::Instance();
     ASSERT(thread_state->active_threads.fetch_sub(1) != 1);
 
@@ -205,6 +208,7 @@ static void RunThread(void* arg) {
     g_curthread = curthread;
     Common::SetCurrentThreadName(curthread->name.c_str());
     DebugState.AddCurrentThreadToGuestList();
+    Core::Profiler::Instance()->RegisterCurrentThread(curthread->name);
 
     /* Run the current thread's start routine with argument: */
     curthread->native_thr.Initialize();
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <forward_list>
 #include <list>
@@ -54,7 +55,7 @@ struct PthreadMutex {
     int m_spinloops;
     int m_yieldloops;
     PthreadMutexProt m_protocol;
-    std::string name;
+    std::array<char, 32> name;
 
     [[nodiscard]] PthreadMutexType Type() const noexcept {
         return static_cast<PthreadMutexType>(m_flags & PthreadMutexFlags::TypeMask);
@@ -120,7 +121,7 @@ struct PthreadCond {
     bool has_kern_waiters;
     u32 flags;
     ClockId clock_id;
-    std::string name;
+    std::array<char, 32> name;
 
     int Wait(PthreadMutexT* mutex, const OrbisKernelTimespec* abstime, u64 usec = 0);
 
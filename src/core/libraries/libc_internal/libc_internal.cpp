@@ -21,4 +21,9 @@ void RegisterLib(Core::Loader::SymbolsResolver* sym) {
     RegisterlibSceLibcInternalMemory(sym);
     RegisterlibSceLibcInternalIo(sym);
 }
+
+void RegisterHostStringFunctions(Core::Loader::SymbolsResolver* sym) {
+    RegisterlibSceLibcInternalHostStr(sym);
+    RegisterlibSceLibcInternalHostMemory(sym);
+}
 } // namespace Libraries::LibcInternal
\ No newline at end of file
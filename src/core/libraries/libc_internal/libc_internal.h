@@ -15,4 +15,7 @@ namespace Libraries::LibcInternal {
 // so everything is just in the .cpp file
 
 void RegisterLib(Core::Loader::SymbolsResolver* sym);
+
+/// Registers host string and memory routines that take priority over the LLE module exports.
+void RegisterHostStringFunctions(Core::Loader::SymbolsResolver* sym);
 } // namespace Libraries::LibcInternal
\ No newline at end of file
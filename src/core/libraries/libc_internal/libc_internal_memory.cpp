@@ -1,6 +1,9 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <cstring>
+
 #include "common/assert.h"
 #include "common/logging/log.h"
 #include "core/libraries/error_codes.h"
@@ -27,15 +30,41 @@ s32 PS4_SYSV_ABI internal_memcpy_s(void* dest, size_t destsz, const void* src, s
 }
 
 s32 PS4_SYSV_ABI internal_memcmp(const void* s1, const void* s2, size_t n) {
-    return std::memcmp(s1, s2, n);
+    // The guest libc returns the difference of the first mismatching bytes, while the host one
+    // only guarantees the sign. Let the host compare blocks and only scan the one that differs.
+    static constexpr size_t BlockSize = 256;
+    const auto* a = static_cast<const u8*>(s1);
+    const auto* b = static_cast<const u8*>(s2);
+    for (size_t i = 0; i < n; i += BlockSize) {
+        const size_t size = std::min(BlockSize, n - i);
+        if (std::memcmp(a + i, b + i, size) == 0) {
+            continue;
+        }
+        const auto [pa, pb] = std::mismatch(a + i, a + i + size, b + i);
+        return static_cast<s32>(*pa) - static_cast<s32>(*pb);
+    }
+    return 0;
 }
 
-void RegisterlibSceLibcInternalMemory(Core::Loader::SymbolsResolver* sym) {
+void* PS4_SYSV_ABI internal_memmove(void* dest, const void* src, size_t n) {
+    return std::memmove(dest, src, n);
+}
 
-    LIB_FUNCTION("NFLs+dRJGNg", "libSceLibcInternal", 1, "libSceLibcInternal", internal_memcpy_s);
+void* PS4_SYSV_ABI internal_memchr(const void* s, int c, size_t n) {
+    return const_cast<void*>(std::memchr(s, c, n));
+}
+
+void RegisterlibSceLibcInternalHostMemory(Core::Loader::SymbolsResolver* sym) {
     LIB_FUNCTION("Q3VBxCXhUHs", "libSceLibcInternal", 1, "libSceLibcInternal", internal_memcpy);
     LIB_FUNCTION("8zTFvBIAIN8", "libSceLibcInternal", 1, "libSceLibcInternal", internal_memset);
     LIB_FUNCTION("DfivPArhucg", "libSceLibcInternal", 1, "libSceLibcInternal", internal_memcmp);
+    LIB_FUNCTION("+P6FRGH4LfA", "libSceLibcInternal", 1, "libSceLibcInternal", internal_memmove);
+    LIB_FUNCTION("8u8lPzUEq+U", "libSceLibcInternal", 1, "libSceLibcInternal", internal_memchr);
+}
+
+void RegisterlibSceLibcInternalMemory(Core::Loader::SymbolsResolver* sym) {
+    RegisterlibSceLibcInternalHostMemory(sym);
+    LIB_FUNCTION("NFLs+dRJGNg", "libSceLibcInternal", 1, "libSceLibcInternal", internal_memcpy_s);
 }
 
 } // namespace Libraries::LibcInternal
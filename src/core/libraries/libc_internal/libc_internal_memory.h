@@ -11,4 +11,7 @@ class SymbolsResolver;
 
 namespace Libraries::LibcInternal {
 void RegisterlibSceLibcInternalMemory(Core::Loader::SymbolsResolver* sym);
+
+/// Registers only the routines that match the guest libc exactly, to be used over the LLE module.
+void RegisterlibSceLibcInternalHostMemory(Core::Loader::SymbolsResolver* sym);
 } // namespace Libraries::LibcInternal
\ No newline at end of file
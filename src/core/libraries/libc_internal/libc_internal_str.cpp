@@ -1,6 +1,9 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <bit>
+#include <cstring>
+
 #include "common/assert.h"
 #include "common/logging/log.h"
 #include "core/libraries/error_codes.h"
@@ -27,12 +30,48 @@ s32 PS4_SYSV_ABI internal_strcat_s(char* dest, size_t dest_size, const char* src
 #endif
 }
 
+// The guest libc returns the difference of the first mismatching characters, while the host one
+// only guarantees the sign. Strings are compared a word at a time as long as neither read can
+// cross into the next page, which may not be mapped.
+static bool CanReadWord(const u8* ptr) {
+    static constexpr uintptr_t PageSize = 4_KB;
+    return (reinterpret_cast<uintptr_t>(ptr) & (PageSize - 1)) <= PageSize - sizeof(u64);
+}
+
+static bool HasZeroByte(u64 word) {
+    return ((word - 0x0101010101010101ULL) & ~word & 0x8080808080808080ULL) != 0;
+}
+
+static s32 CompareStrings(const char* str1, const char* str2, size_t num) {
+    static_assert(std::endian::native == std::endian::little);
+    const auto* a = reinterpret_cast<const u8*>(str1);
+    const auto* b = reinterpret_cast<const u8*>(str2);
+    size_t i = 0;
+    while (i < num) {
+        if (num - i >= sizeof(u64) && CanReadWord(a + i) && CanReadWord(b + i)) {
+            u64 word_a;
+            u64 word_b;
+            std::memcpy(&word_a, a + i, sizeof(u64));
+            std::memcpy(&word_b, b + i, sizeof(u64));
+            if (word_a == word_b && !HasZeroByte(word_a)) {
+                i += sizeof(u64);
+                continue;
+            }
+        }
+        if (a[i] != b[i] || a[i] == 0) {
+            return static_cast<s32>(a[i]) - static_cast<s32>(b[i]);
+        }
+        ++i;
+    }
+    return 0;
+}
+
 s32 PS4_SYSV_ABI internal_strcmp(const char* str1, const char* str2) {
-    return std::strcmp(str1, str2);
+    return CompareStrings(str1, str2, SIZE_MAX);
 }
 
 s32 PS4_SYSV_ABI internal_strncmp(const char* str1, const char* str2, size_t num) {
-    return std::strncmp(str1, str2, num);
+    return CompareStrings(str1, str2, num);
 }
 
 size_t PS4_SYSV_ABI internal_strlen(const char* str) {
@@ -60,16 +99,46 @@ const char* PS4_SYSV_ABI internal_strchr(const char* str, int c) {
     return std::strchr(str, c);
 }
 
-void RegisterlibSceLibcInternalStr(Core::Loader::SymbolsResolver* sym) {
-    LIB_FUNCTION("5Xa2ACNECdo", "libSceLibcInternal", 1, "libSceLibcInternal", internal_strcpy_s);
-    LIB_FUNCTION("K+gcnFFJKVc", "libSceLibcInternal", 1, "libSceLibcInternal", internal_strcat_s);
-    LIB_FUNCTION("aesyjrHVWy4", "libSceLibcInternal", 1, "libSceLibcInternal", internal_strcmp);
-    LIB_FUNCTION("Ovb2dSJOAuE", "libSceLibcInternal", 1, "libSceLibcInternal", internal_strncmp);
+size_t PS4_SYSV_ABI internal_strnlen(const char* str, size_t max_len) {
+    const void* end = std::memchr(str, 0, max_len);
+    return end ? static_cast<const char*>(end) - str : max_len;
+}
+
+const char* PS4_SYSV_ABI internal_strrchr(const char* str, int c) {
+    return std::strrchr(str, c);
+}
+
+char* PS4_SYSV_ABI internal_strcpy(char* dest, const char* src) {
+    return std::strcpy(dest, src);
+}
+
+char* PS4_SYSV_ABI internal_strncat(char* dest, const char* src, size_t count) {
+    return std::strncat(dest, src, count);
+}
+
+const char* PS4_SYSV_ABI internal_strstr(const char* str, const char* substr) {
+    return std::strstr(str, substr);
+}
+
+void RegisterlibSceLibcInternalHostStr(Core::Loader::SymbolsResolver* sym) {
+    LIB_FUNCTION("Ovb2dSJOAuE", "libSceLibcInternal", 1, "libSceLibcInternal", internal_strcmp);
+    LIB_FUNCTION("aesyjrHVWy4", "libSceLibcInternal", 1, "libSceLibcInternal", internal_strncmp);
     LIB_FUNCTION("j4ViWNHEgww", "libSceLibcInternal", 1, "libSceLibcInternal", internal_strlen);
+    LIB_FUNCTION("5jNubw4vlAA", "libSceLibcInternal", 1, "libSceLibcInternal", internal_strnlen);
+    LIB_FUNCTION("kiZSXIWd9vg", "libSceLibcInternal", 1, "libSceLibcInternal", internal_strcpy);
     LIB_FUNCTION("6sJWiWSRuqk", "libSceLibcInternal", 1, "libSceLibcInternal", internal_strncpy);
-    LIB_FUNCTION("YNzNkJzYqEg", "libSceLibcInternal", 1, "libSceLibcInternal", internal_strncpy_s);
     LIB_FUNCTION("Ls4tzzhimqQ", "libSceLibcInternal", 1, "libSceLibcInternal", internal_strcat);
+    LIB_FUNCTION("kHg45qPC6f0", "libSceLibcInternal", 1, "libSceLibcInternal", internal_strncat);
     LIB_FUNCTION("ob5xAW4ln-0", "libSceLibcInternal", 1, "libSceLibcInternal", internal_strchr);
+    LIB_FUNCTION("9yDWMxEFdJU", "libSceLibcInternal", 1, "libSceLibcInternal", internal_strrchr);
+    LIB_FUNCTION("viiwFMaNamA", "libSceLibcInternal", 1, "libSceLibcInternal", internal_strstr);
+}
+
+void RegisterlibSceLibcInternalStr(Core::Loader::SymbolsResolver* sym) {
+    RegisterlibSceLibcInternalHostStr(sym);
+    LIB_FUNCTION("5Xa2ACNECdo", "libSceLibcInternal", 1, "libSceLibcInternal", internal_strcpy_s);
+    LIB_FUNCTION("K+gcnFFJKVc", "libSceLibcInternal", 1, "libSceLibcInternal", internal_strcat_s);
+    LIB_FUNCTION("YNzNkJzYqEg", "libSceLibcInternal", 1, "libSceLibcInternal", internal_strncpy_s);
 }
 
 } // namespace Libraries::LibcInternal
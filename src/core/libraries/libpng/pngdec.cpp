@@ -6,6 +6,7 @@
 #include "common/logging/log.h"
 #include "core/libraries/libpng/pngdec.h"
 #include "core/libraries/libpng/pngdec_error.h"
+#include "core/libraries/libpng/pngdec_fast.h"
 #include "core/libraries/libs.h"
 
 namespace Libraries::PngDec {
@@ -97,6 +98,10 @@ s32 PS4_SYSV_ABI scePngDecDecode(OrbisPngDecHandle handle, const OrbisPngDecDeco
               param->png_mem_size, param->image_mem_size, int(param->pixel_format),
               param->alpha_value, param->image_pitch);
 
+    if (const auto result = DecodePngFast(*param, imageInfo)) {
+        return *result;
+    }
+
     auto pngh = (PngHandler*)handle;
 
     const auto pngdata = PngStruct{
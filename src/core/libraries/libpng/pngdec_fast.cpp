@@ -0,0 +1,505 @@
+// SPDX-FileCopyrightText: Copyright 2025 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <span>
+#include <vector>
+#include <zlib.h>
+
+#include "common/logging/log.h"
+#include "core/libraries/libpng/pngdec_error.h"
+#include "core/libraries/libpng/pngdec_fast.h"
+
+#ifdef __AVX2__
+#define PNG_DEC_USE_AVX
+#include <immintrin.h>
+#endif
+
+namespace Libraries::PngDec {
+
+namespace {
+
+constexpr std::array<u8, 8> PngSignature = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+/// Bytes of inflated data processed per batch of rows.
+constexpr size_t BatchSize = 256_KB;
+
+enum class ColorType : u8 {
+    Gray = 0,
+    Rgb = 2,
+    Palette = 3,
+    GrayAlpha = 4,
+    Rgba = 6,
+};
+
+enum class Filter : u8 {
+    None = 0,
+    Sub = 1,
+    Up = 2,
+    Average = 3,
+    Paeth = 4,
+};
+
+constexpr u32 ChunkType(const char (&name)[5]) {
+    return (u32(u8(name[0])) << 24) | (u32(u8(name[1])) << 16) | (u32(u8(name[2])) << 8) |
+           u32(u8(name[3]));
+}
+
+inline u32 ReadBE32(const u8* data) {
+    return (u32(data[0]) << 24) | (u32(data[1]) << 16) | (u32(data[2]) << 8) | u32(data[3]);
+}
+
+struct Chunk {
+    u32 type;
+    std::span<const u8> data;
+};
+
+/// Walks the chunks of a PNG stream in guest memory. Like libpng, chunks are checked against
+/// their CRC, a mismatch ends the walk.
+class ChunkReader {
+public:
+    explicit ChunkReader(std::span<const u8> png) : png{png}, offset{PngSignature.size()} {}
+
+    std::optional<Chunk> Next() {
+        if (offset + 12 > png.size()) {
+            return std::nullopt;
+        }
+        const u32 length = ReadBE32(png.data() + offset);
+        if (length > png.size() - offset - 12) {
+            return std::nullopt;
+        }
+        // The CRC covers the chunk type and data.
+        const u8* type = png.data() + offset + 4;
+        const u32 crc = static_cast<u32>(crc32(0, type, length + 4));
+        if (crc != ReadBE32(type + 4 + length)) {
+            bad_crc = true;
+            return std::nullopt;
+        }
+        const Chunk chunk{ReadBE32(type), png.subspan(offset + 8, length)};
+        offset += size_t(length) + 12;
+        return chunk;
+    }
+
+    [[nodiscard]] bool HasBadCrc() const {
+        return bad_crc;
+    }
+
+private:
+    std::span<const u8> png;
+    size_t offset;
+    bool bad_crc{};
+};
+
+struct Header {
+    u32 width;
+    u32 height;
+    u8 bit_depth;
+    ColorType color_type;
+    u8 interlace;
+};
+
+inline u32 BytesPerPixel(ColorType type) {
+    switch (type) {
+    case ColorType::Gray:
+    case ColorType::Palette:
+        return 1;
+    case ColorType::GrayAlpha:
+        return 2;
+    case ColorType::Rgb:
+        return 3;
+    case ColorType::Rgba:
+        return 4;
+    }
+    return 0;
+}
+
+inline u8 PaethPredictor(u8 a, u8 b, u8 c) {
+    const s32 p = s32(a) + s32(b) - s32(c);
+    const s32 pa = std::abs(p - s32(a));
+    const s32 pb = std::abs(p - s32(b));
+    const s32 pc = std::abs(p - s32(c));
+    if (pa <= pb && pa <= pc) {
+        return a;
+    }
+    return pb <= pc ? b : c;
+}
+
+#ifdef PNG_DEC_USE_AVX
+inline __m128i LoadPixel(const u8* p, u32 bpp) {
+    u32 v = 0;
+    std::memcpy(&v, p, bpp);
+    return _mm_cvtsi32_si128(static_cast<s32>(v));
+}
+
+inline void StorePixel(u8* p, __m128i v, u32 bpp) {
+    const u32 value = static_cast<u32>(_mm_cvtsi128_si32(v));
+    std::memcpy(p, &value, bpp);
+}
+
+/// Pixel at a time unfiltering of 3 and 4 byte pixels, the same approach libpng takes.
+template <Filter filter>
+void UnfilterPixels(u8* row, const u8* prev, u32 row_bytes, u32 bpp) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i a = zero;
+    __m128i c = zero;
+    for (u32 i = 0; i < row_bytes; i += bpp) {
+        const __m128i x = LoadPixel(row + i, bpp);
+        __m128i d;
+        if constexpr (filter == Filter::Sub) {
+            d = _mm_add_epi8(x, a);
+        } else if constexpr (filter == Filter::Average) {
+            const __m128i b = LoadPixel(prev + i, bpp);
+            // avg_epu8 rounds up, subtract the carried bit to get floor((a + b) / 2).
+            const __m128i avg = _mm_sub_epi8(
+                _mm_avg_epu8(a, b), _mm_and_si128(_mm_xor_si128(a, b), _mm_set1_epi8(1)));
+            d = _mm_add_epi8(x, avg);
+        } else {
+            const __m128i b = LoadPixel(prev + i, bpp);
+            const __m128i a16 = _mm_unpacklo_epi8(a, zero);
+            const __m128i b16 = _mm_unpacklo_epi8(b, zero);
+            const __m128i c16 = _mm_unpacklo_epi8(c, zero);
+            const __m128i pa = _mm_abs_epi16(_mm_sub_epi16(b16, c16));
+            const __m128i pb = _mm_abs_epi16(_mm_sub_epi16(a16, c16));
+            const __m128i pc =
+                _mm_abs_epi16(_mm_add_epi16(_mm_sub_epi16(b16, c16), _mm_sub_epi16(a16, c16)));
+            const __m128i smallest = _mm_min_epi16(pc, _mm_min_epi16(pa, pb));
+            const __m128i nearest =
+                _mm_blendv_epi8(_mm_blendv_epi8(c16, b16, _mm_cmpeq_epi16(smallest, pb)), a16,
+                                _mm_cmpeq_epi16(smallest, pa));
+            d = _mm_add_epi8(x, _mm_packus_epi16(nearest, nearest));
+            c = b;
+        }
+        StorePixel(row + i, d, bpp);
+        a = d;
+    }
+}
+#endif
+
+bool UnfilterRow(Filter filter, u8* row, const u8* prev, u32 row_bytes, u32 bpp) {
+    switch (filter) {
+    case Filter::None:
+        return true;
+    case Filter::Up: {
+        u32 i = 0;
+#ifdef PNG_DEC_USE_AVX
+        for (; i + 32 <= row_bytes; i += 32) {
+            const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + i));
+            const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(prev + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(row + i), _mm256_add_epi8(x, b));
+        }
+#endif
+        for (; i < row_bytes; ++i) {
+            row[i] += prev[i];
+        }
+        return true;
+    }
+    default:
+        break;
+    }
+
+#ifdef PNG_DEC_USE_AVX
+    if (bpp >= 3) {
+        switch (filter) {
+        case Filter::Sub:
+            UnfilterPixels<Filter::Sub>(row, prev, row_bytes, bpp);
+            return true;
+        case Filter::Average:
+            UnfilterPixels<Filter::Average>(row, prev, row_bytes, bpp);
+            return true;
+        case Filter::Paeth:
+            UnfilterPixels<Filter::Paeth>(row, prev, row_bytes, bpp);
+            return true;
+        default:
+            return false;
+        }
+    }
+#endif
+
+    switch (filter) {
+    case Filter::Sub:
+        for (u32 i = bpp; i < row_bytes; ++i) {
+            row[i] += row[i - bpp];
+        }
+        return true;
+    case Filter::Average:
+        for (u32 i = 0; i < bpp; ++i) {
+            row[i] += prev[i] >> 1;
+        }
+        for (u32 i = bpp; i < row_bytes; ++i) {
+            row[i] += static_cast<u8>((u32(row[i - bpp]) + u32(prev[i])) >> 1);
+        }
+        return true;
+    case Filter::Paeth:
+        for (u32 i = 0; i < bpp; ++i) {
+            row[i] += prev[i];
+        }
+        for (u32 i = bpp; i < row_bytes; ++i) {
+            row[i] += PaethPredictor(row[i - bpp], prev[i], prev[i - bpp]);
+        }
+        return true;
+    default:
+        return false;
+    }
+}
+
+/// Converts one unfiltered row into 32-bit RGBA or BGRA pixels.
+void ConvertRow(const Header& header, bool bgra, u8 alpha, const std::array<u32, 256>& palette,
+                const u8* src, u8* dst) {
+    const u32 width = header.width;
+    const u32 alpha_mask = u32(alpha) << 24;
+    u32 x = 0;
+    switch (header.color_type) {
+    case ColorType::Rgba: {
+        if (!bgra) {
+            std::memcpy(dst, src, size_t(width) * 4);
+            return;
+        }
+#ifdef PNG_DEC_USE_AVX
+        const __m128i swap =
+            _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+        for (; x + 4 <= width; x += 4) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x * 4));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 4), _mm_shuffle_epi8(v, swap));
+        }
+#endif
+        for (; x < width; ++x) {
+            dst[x * 4 + 0] = src[x * 4 + 2];
+            dst[x * 4 + 1] = src[x * 4 + 1];
+            dst[x * 4 + 2] = src[x * 4 + 0];
+            dst[x * 4 + 3] = src[x * 4 + 3];
+        }
+        return;
+    }
+    case ColorType::Rgb: {
+        const u32 r = bgra ? 2 : 0;
+        const u32 b = bgra ? 0 : 2;
+#ifdef PNG_DEC_USE_AVX
+        const __m128i expand =
+            bgra ? _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1)
+                 : _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+        const __m128i fill = _mm_set1_epi32(static_cast<s32>(alpha_mask));
+        // Loads 16 bytes for 4 pixels, so stop while a full load still fits in the row.
+        for (; x + 6 <= width; x += 4) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x * 3));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 4),
+                             _mm_or_si128(_mm_shuffle_epi8(v, expand), fill));
+        }
+#endif
+        for (; x < width; ++x) {
+            dst[x * 4 + r] = src[x * 3 + 0];
+            dst[x * 4 + 1] = src[x * 3 + 1];
+            dst[x * 4 + b] = src[x * 3 + 2];
+            dst[x * 4 + 3] = alpha;
+        }
+        return;
+    }
+    case ColorType::Gray: {
+#ifdef PNG_DEC_USE_AVX
+        const __m128i expand =
+            _mm_setr_epi8(0, 0, 0, -1, 1, 1, 1, -1, 2, 2, 2, -1, 3, 3, 3, -1);
+        const __m128i fill = _mm_set1_epi32(static_cast<s32>(alpha_mask));
+        for (; x + 4 <= width; x += 4) {
+            u32 v;
+            std::memcpy(&v, src + x, sizeof(v));
+            const __m128i g = _mm_shuffle_epi8(_mm_cvtsi32_si128(static_cast<s32>(v)), expand);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 4), _mm_or_si128(g, fill));
+        }
+#endif
+        for (; x < width; ++x) {
+            dst[x * 4 + 0] = dst[x * 4 + 1] = dst[x * 4 + 2] = src[x];
+            dst[x * 4 + 3] = alpha;
+        }
+        return;
+    }
+    case ColorType::GrayAlpha: {
+#ifdef PNG_DEC_USE_AVX
+        const __m128i expand =
+            _mm_setr_epi8(0, 0, 0, 1, 2, 2, 2, 3, 4, 4, 4, 5, 6, 6, 6, 7);
+        for (; x + 4 <= width; x += 4) {
+            const __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + x * 2));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 4),
+                             _mm_shuffle_epi8(v, expand));
+        }
+#endif
+        for (; x < width; ++x) {
+            dst[x * 4 + 0] = dst[x * 4 + 1] = dst[x * 4 + 2] = src[x * 2];
+            dst[x * 4 + 3] = src[x * 2 + 1];
+        }
+        return;
+    }
+    case ColorType::Palette:
+        for (; x < width; ++x) {
+            std::memcpy(dst + x * 4, &palette[src[x]], sizeof(u32));
+        }
+        return;
+    }
+}
+
+} // Anonymous namespace
+
+std::optional<s32> DecodePngFast(const OrbisPngDecDecodeParam& param,
+                                 OrbisPngDecImageInfo* image_info) {
+    const std::span<const u8> png{param.png_mem_addr, param.png_mem_size};
+    if (png.size() < PngSignature.size() ||
+        std::memcmp(png.data(), PngSignature.data(), PngSignature.size()) != 0) {
+        return std::nullopt;
+    }
+
+    // Parse everything up to the first IDAT chunk. A bad CRC in there leaves the image to libpng,
+    // which knows which ancillary chunks it may skip.
+    ChunkReader reader{png};
+    Header header{};
+    std::span<const u8> plte;
+    std::span<const u8> trns;
+    std::optional<Chunk> chunk = reader.Next();
+    if (!chunk || chunk->type != ChunkType("IHDR") || chunk->data.size() != 13) {
+        return std::nullopt;
+    }
+    header.width = ReadBE32(chunk->data.data());
+    header.height = ReadBE32(chunk->data.data() + 4);
+    header.bit_depth = chunk->data[8];
+    header.color_type = static_cast<ColorType>(chunk->data[9]);
+    header.interlace = chunk->data[12];
+    const u32 bpp = BytesPerPixel(header.color_type);
+    if (header.bit_depth != 8 || bpp == 0 || header.interlace != 0 || header.width == 0 ||
+        header.height == 0 || chunk->data[10] != 0 || chunk->data[11] != 0) {
+        return std::nullopt;
+    }
+    for (chunk = reader.Next(); chunk && chunk->type != ChunkType("IDAT"); chunk = reader.Next()) {
+        if (chunk->type == ChunkType("PLTE")) {
+            plte = chunk->data;
+        } else if (chunk->type == ChunkType("tRNS")) {
+            trns = chunk->data;
+        }
+    }
+    if (!chunk) {
+        return std::nullopt;
+    }
+    // Color key transparency is left to libpng.
+    if (!trns.empty() && header.color_type != ColorType::Palette) {
+        return std::nullopt;
+    }
+    if (header.color_type == ColorType::Palette && (plte.empty() || plte.size() % 3 != 0)) {
+        return std::nullopt;
+    }
+
+    if (image_info != nullptr) {
+        image_info->bit_depth = header.bit_depth;
+        image_info->image_width = header.width;
+        image_info->image_height = header.height;
+        switch (header.color_type) {
+        case ColorType::Gray:
+            image_info->color_space = OrbisPngDecColorSpace::Grayscale;
+            break;
+        case ColorType::Rgb:
+            image_info->color_space = OrbisPngDecColorSpace::Rgb;
+            break;
+        case ColorType::Palette:
+            image_info->color_space = OrbisPngDecColorSpace::Clut;
+            break;
+        case ColorType::GrayAlpha:
+            image_info->color_space = OrbisPngDecColorSpace::GrayscaleAlpha;
+            break;
+        case ColorType::Rgba:
+            image_info->color_space = OrbisPngDecColorSpace::Rgba;
+            break;
+        }
+        image_info->image_flag = trns.empty() ? OrbisPngDecImageFlag::None
+                                              : OrbisPngDecImageFlag::TrnsChunkExist;
+    }
+
+    const bool bgra = param.pixel_format == OrbisPngDecPixelFormat::B8G8R8A8;
+    const u8 alpha = static_cast<u8>(param.alpha_value);
+    std::array<u32, 256> palette{};
+    for (u32 i = 0; i < plte.size() / 3; ++i) {
+        const u8 r = plte[i * 3 + 0];
+        const u8 g = plte[i * 3 + 1];
+        const u8 b = plte[i * 3 + 2];
+        const u8 a = i < trns.size() ? trns[i] : (trns.empty() ? alpha : 0xFF);
+        palette[i] = bgra ? (u32(b) | (u32(g) << 8) | (u32(r) << 16) | (u32(a) << 24))
+                          : (u32(r) | (u32(g) << 8) | (u32(b) << 16) | (u32(a) << 24));
+    }
+
+    const u32 row_bytes = header.width * bpp;
+    const size_t filtered_row = size_t(row_bytes) + 1;
+    const u32 pitch = param.image_pitch > 0 ? param.image_pitch : header.width * 4;
+    const u32 batch_rows =
+        std::clamp<u32>(static_cast<u32>(BatchSize / filtered_row), 1, header.height);
+
+    // Rows are inflated in batches and unfiltered in place, keeping the last row of the
+    // previous batch around as the prior scanline.
+    std::vector<u8> batch(filtered_row * batch_rows);
+    std::vector<u8> prev(row_bytes, 0);
+
+    z_stream stream{};
+    if (inflateInit(&stream) != Z_OK) {
+        return ORBIS_PNG_DEC_ERROR_FATAL;
+    }
+    stream.next_in = const_cast<u8*>(chunk->data.data());
+    stream.avail_in = static_cast<uInt>(chunk->data.size());
+
+    s32 result = ORBIS_OK;
+    u8* out = param.image_mem_addr;
+    for (u32 y = 0; y < header.height && result == ORBIS_OK;) {
+        const u32 rows = std::min(batch_rows, header.height - y);
+        stream.next_out = batch.data();
+        stream.avail_out = static_cast<uInt>(filtered_row * rows);
+        while (stream.avail_out != 0) {
+            if (stream.avail_in == 0) {
+                chunk = reader.Next();
+                if (reader.HasBadCrc()) {
+                    LOG_ERROR(Lib_Png, "Image data chunk CRC mismatch");
+                    result = ORBIS_PNG_DEC_ERROR_INVALID_DATA;
+                    break;
+                }
+                if (!chunk || chunk->type != ChunkType("IDAT")) {
+                    LOG_ERROR(Lib_Png, "Truncated image data");
+                    result = ORBIS_PNG_DEC_ERROR_INVALID_DATA;
+                    break;
+                }
+                stream.next_in = const_cast<u8*>(chunk->data.data());
+                stream.avail_in = static_cast<uInt>(chunk->data.size());
+                continue;
+            }
+            const s32 ret = inflate(&stream, Z_NO_FLUSH);
+            if (ret == Z_STREAM_END && stream.avail_out != 0) {
+                LOG_ERROR(Lib_Png, "Image data ends early");
+                result = ORBIS_PNG_DEC_ERROR_INVALID_DATA;
+                break;
+            }
+            if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR) {
+                LOG_ERROR(Lib_Png, "Failed to inflate image data: {}", ret);
+                result = ORBIS_PNG_DEC_ERROR_DECODE_ERROR;
+                break;
+            }
+        }
+        if (result != ORBIS_OK) {
+            break;
+        }
+
+        const u8* prior = prev.data();
+        for (u32 r = 0; r < rows; ++r, ++y, out += pitch) {
+            u8* row = batch.data() + filtered_row * r;
+            if (!UnfilterRow(static_cast<Filter>(row[0]), row + 1, prior, row_bytes, bpp)) {
+                LOG_ERROR(Lib_Png, "Invalid filter type {}", row[0]);
+                result = ORBIS_PNG_DEC_ERROR_INVALID_DATA;
+                break;
+            }
+            ConvertRow(header, bgra, alpha, palette, row + 1, out);
+            prior = row + 1;
+        }
+        std::memcpy(prev.data(), prior, row_bytes);
+    }
+    inflateEnd(&stream);
+
+    if (result != ORBIS_OK) {
+        return result;
+    }
+    return (header.width > 32767 || header.height > 32767) ? 0
+                                                           : (header.width << 16) | header.height;
+}
+
+} // namespace Libraries::PngDec
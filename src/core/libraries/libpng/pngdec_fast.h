@@ -0,0 +1,19 @@
+// SPDX-FileCopyrightText: Copyright 2025 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <optional>
+
+#include "core/libraries/libpng/pngdec.h"
+
+namespace Libraries::PngDec {
+
+/// Decodes non interlaced 8-bit grayscale, RGB, RGBA and palette images by inflating the IDAT
+/// chunks straight from guest memory and writing converted rows into the output buffer.
+/// Returns std::nullopt without touching the output when the image needs the libpng path,
+/// otherwise the value scePngDecDecode should return.
+std::optional<s32> DecodePngFast(const OrbisPngDecDecodeParam& param,
+                                 OrbisPngDecImageInfo* image_info);
+
+} // namespace Libraries::PngDec
@@ -1,12 +1,15 @@
 // SPDX-FileCopyrightText: Copyright 2025 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <future>
 #include <unordered_map>
 #include <pugixml.hpp>
 
 #include "common/logging/log.h"
 #include "common/path_util.h"
 #include "common/slot_vector.h"
+#include "common/thread.h"
+#include "core/file_format/trp.h"
 #include "core/libraries/libs.h"
 #include "core/libraries/np/np_error.h"
 #include "core/libraries/np/np_trophy.h"
@@ -34,6 +37,27 @@ struct TrophyContext {
 static Common::SlotVector<OrbisNpTrophyHandle> trophy_handles{};
 static Common::SlotVector<ContextKey> trophy_contexts{};
 static std::unordered_map<ContextKey, TrophyContext, ContextKeyHash> contexts_internal{};
+static std::shared_future<void> trophy_extraction{};
+
+void ExtractTrophyFilesAsync(const std::filesystem::path& game_folder) {
+    const auto extract = [game_folder, serial = game_serial] {
+        Common::SetCurrentThreadName("shadPS4:TrophyExtract");
+        TRP trp;
+        if (!trp.Extract(game_folder, serial)) {
+            LOG_ERROR(Lib_NpTrophy, "Couldn't extract trophies");
+        }
+    };
+    trophy_extraction = std::async(std::launch::async, extract).share();
+}
+
+// Waits for the extraction started at boot, so only the first trophy call can block on it.
+static std::filesystem::path GetTrophyFilesDir() {
+    if (trophy_extraction.valid()) {
+        trophy_extraction.wait();
+    }
+    return Common::FS::GetUserPath(Common::FS::PathType::MetaDataDir) / game_serial /
+           "TrophyFiles";
+}
 
 void ORBIS_NP_TROPHY_FLAG_ZERO(OrbisNpTrophyFlagArray* p) {
     for (int i = 0; i < ORBIS_NP_TROPHY_NUM_MAX; i++) {
@@ -253,8 +277,7 @@ int PS4_SYSV_ABI sceNpTrophyGetGameIcon(OrbisNpTrophyContext context, OrbisNpTro
     char trophy_folder[9];
     snprintf(trophy_folder, sizeof(trophy_folder), "trophy%02d", contextkey.second);
 
-    const auto trophy_dir =
-        Common::FS::GetUserPath(Common::FS::PathType::MetaDataDir) / game_serial / "TrophyFiles";
+    const auto trophy_dir = GetTrophyFilesDir();
     auto icon_file = trophy_dir / trophy_folder / "Icons" / "ICON0.PNG";
 
     Common::FS::IOFile icon(icon_file, Common::FS::FileAccessMode::Read);
@@ -306,8 +329,7 @@ int PS4_SYSV_ABI sceNpTrophyGetGameInfo(OrbisNpTrophyContext context, OrbisNpTro
     char trophy_folder[9];
     snprintf(trophy_folder, sizeof(trophy_folder), "trophy%02d", contextkey.second);
 
-    const auto trophy_dir =
-        Common::FS::GetUserPath(Common::FS::PathType::MetaDataDir) / game_serial / "TrophyFiles";
+    const auto trophy_dir = GetTrophyFilesDir();
     auto trophy_file = trophy_dir / trophy_folder / "Xml" / "TROP.XML";
 
     pugi::xml_document doc;
@@ -413,8 +435,7 @@ int PS4_SYSV_ABI sceNpTrophyGetGroupInfo(OrbisNpTrophyContext context, OrbisNpTr
     char trophy_folder[9];
     snprintf(trophy_folder, sizeof(trophy_folder), "trophy%02d", contextkey.second);
 
-    const auto trophy_dir =
-        Common::FS::GetUserPath(Common::FS::PathType::MetaDataDir) / game_serial / "TrophyFiles";
+    const auto trophy_dir = GetTrophyFilesDir();
     auto trophy_file = trophy_dir / trophy_folder / "Xml" / "TROP.XML";
 
     pugi::xml_document doc;
@@ -524,8 +545,7 @@ int PS4_SYSV_ABI sceNpTrophyGetTrophyInfo(OrbisNpTrophyContext context, OrbisNpT
     char trophy_folder[9];
     snprintf(trophy_folder, sizeof(trophy_folder), "trophy%02d", contextkey.second);
 
-    const auto trophy_dir =
-        Common::FS::GetUserPath(Common::FS::PathType::MetaDataDir) / game_serial / "TrophyFiles";
+    const auto trophy_dir = GetTrophyFilesDir();
     auto trophy_file = trophy_dir / trophy_folder / "Xml" / "TROP.XML";
 
     pugi::xml_document doc;
@@ -598,8 +618,7 @@ s32 PS4_SYSV_ABI sceNpTrophyGetTrophyUnlockState(OrbisNpTrophyContext context,
     char trophy_folder[9];
     snprintf(trophy_folder, sizeof(trophy_folder), "trophy%02d", contextkey.second);
 
-    const auto trophy_dir =
-        Common::FS::GetUserPath(Common::FS::PathType::MetaDataDir) / game_serial / "TrophyFiles";
+    const auto trophy_dir = GetTrophyFilesDir();
     auto trophy_file = trophy_dir / trophy_folder / "Xml" / "TROP.XML";
 
     pugi::xml_document doc;
@@ -966,8 +985,7 @@ int PS4_SYSV_ABI sceNpTrophyUnlockTrophy(OrbisNpTrophyContext context, OrbisNpTr
     char trophy_folder[9];
     snprintf(trophy_folder, sizeof(trophy_folder), "trophy%02d", contextkey.second);
 
-    const auto trophy_dir =
-        Common::FS::GetUserPath(Common::FS::PathType::MetaDataDir) / game_serial / "TrophyFiles";
+    const auto trophy_dir = GetTrophyFilesDir();
     auto trophy_file = trophy_dir / trophy_folder / "Xml" / "TROP.XML";
 
     pugi::xml_document doc;
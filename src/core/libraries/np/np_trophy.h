@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <filesystem>
+
 #include "common/types.h"
 #include "core/libraries/rtc/rtc.h"
 
@@ -14,6 +16,10 @@ namespace Libraries::Np::NpTrophy {
 
 extern std::string game_serial;
 
+/// Extracts the trophy files of game_serial on a background thread. Trophy functions that read
+/// them wait for it to finish.
+void ExtractTrophyFilesAsync(const std::filesystem::path& game_folder);
+
 constexpr int ORBIS_NP_TROPHY_FLAG_SETSIZE = 128;
 constexpr int ORBIS_NP_TROPHY_FLAG_BITS_SHIFT = 5;
 
@@ -2,14 +2,26 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <deque>
+#include <fstream>
 #include <mutex>
 #include <semaphore>
+#include <unordered_map>
 
 #include <magic_enum/magic_enum.hpp>
+#include <xxhash.h>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
 
 #include "save_backup.h"
+#include "save_catalog.h"
 #include "save_instance.h"
 
+#include "common/io_file.h"
 #include "common/logging/log.h"
 #include "common/logging/log_entry.h"
 #include "common/polyfill_thread.h"
@@ -19,6 +31,7 @@ constexpr std::string_view sce_sys = "sce_sys";               // system folder i
 constexpr std::string_view backup_dir = "sce_backup";         // backup folder
 constexpr std::string_view backup_dir_tmp = "sce_backup_tmp"; // in-progress backup folder
 constexpr std::string_view backup_dir_old = "sce_backup_old"; // previous backup folder
+constexpr std::string_view backup_manifest = "sce_backup_manifest"; // file hashes of a backup
 
 namespace fs = std::filesystem;
 
@@ -36,6 +49,89 @@ static std::deque<BackupRequest> g_result_queue;
 static std::atomic_int g_backup_progress = 0;
 static std::atomic g_backup_status = WorkerStatus::NotStarted;
 
+struct ManifestEntry {
+    u64 size;
+    XXH128_hash_t hash;
+};
+
+// Keyed by the generic path of the file relative to the save directory
+using Manifest = std::unordered_map<std::string, ManifestEntry>;
+
+static XXH128_hash_t HashFile(const fs::path& path) {
+    Common::FS::IOFile file{path, Common::FS::FileAccessMode::Read};
+    if (!file.IsOpen()) {
+        throw fs::filesystem_error("Failed to open file for hashing", path,
+                                   std::make_error_code(std::errc::io_error));
+    }
+    XXH3_state_t state;
+    XXH3_128bits_reset(&state);
+    std::vector<u8> buffer(64_KB);
+    size_t read;
+    while ((read = file.ReadRaw<u8>(buffer.data(), buffer.size())) != 0) {
+        XXH3_128bits_update(&state, buffer.data(), read);
+    }
+    return XXH3_128bits_digest(&state);
+}
+
+static Manifest LoadManifest(const fs::path& path) {
+    Manifest manifest;
+    std::ifstream file{path};
+    u64 high, low, size;
+    std::string rel_path;
+    while (file >> std::hex >> high >> low >> std::dec >> size && file.get() == ' ' &&
+           std::getline(file, rel_path)) {
+        manifest.emplace(std::move(rel_path), ManifestEntry{
+                                                  .size = size,
+                                                  .hash = {.low64 = low, .high64 = high},
+                                              });
+    }
+    return manifest;
+}
+
+static void SaveManifest(const fs::path& path, const Manifest& manifest) {
+    std::ofstream file{path};
+    for (const auto& [rel_path, entry] : manifest) {
+        file << fmt::format("{:x} {:x} {} {}\n", entry.hash.high64, entry.hash.low64, entry.size,
+                            rel_path);
+    }
+    if (!file) {
+        throw fs::filesystem_error("Failed to write backup manifest", path,
+                                   std::make_error_code(std::errc::io_error));
+    }
+}
+
+// Copies a file, sharing its extents when the host filesystem supports reflinks
+static void CloneFile(const fs::path& from, const fs::path& to) {
+#ifdef __linux__
+    const int src_fd = open(from.c_str(), O_RDONLY | O_CLOEXEC);
+    if (src_fd >= 0) {
+        const int dst_fd = open(to.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+        const bool cloned = dst_fd >= 0 && ioctl(dst_fd, FICLONE, src_fd) == 0;
+        if (dst_fd >= 0) {
+            close(dst_fd);
+        }
+        close(src_fd);
+        if (cloned) {
+            return;
+        }
+        fs::remove(to);
+    }
+#endif
+    fs::copy_file(from, to);
+}
+
+// A backup interrupted between moving the last generation aside and publishing the new one
+// leaves only sce_backup_old behind. Move it back so it is not lost.
+static void RecoverInterruptedBackup(const fs::path& dir_name) {
+    const auto backup_dir = dir_name / ::backup_dir;
+    const auto backup_dir_old = dir_name / ::backup_dir_old;
+    if (!fs::exists(backup_dir) && fs::exists(backup_dir_old)) {
+        LOG_WARNING(Lib_SaveData, "Recovering interrupted backup of {}",
+                    fmt::UTF(dir_name.u8string()));
+        fs::rename(backup_dir_old, backup_dir);
+    }
+}
+
 static void backup(const std::filesystem::path& dir_name) {
     std::unique_lock lk{g_backup_running_mutex};
     if (!fs::exists(dir_name)) {
@@ -46,14 +142,23 @@ static void backup(const std::filesystem::path& dir_name) {
     const auto backup_dir_tmp = dir_name / ::backup_dir_tmp;
     const auto backup_dir_old = dir_name / ::backup_dir_old;
 
+    RecoverInterruptedBackup(dir_name);
     fs::remove_all(backup_dir_tmp);
     fs::remove_all(backup_dir_old);
 
     std::vector<std::filesystem::path> backup_files;
-    for (const auto& entry : fs::directory_iterator(dir_name)) {
-        const auto filename = entry.path().filename();
-        if (filename != ::backup_dir) {
-            backup_files.push_back(entry.path());
+    fs::create_directory(backup_dir_tmp);
+    for (auto it = fs::recursive_directory_iterator(dir_name);
+         it != fs::recursive_directory_iterator(); ++it) {
+        const auto& path = it->path();
+        const auto filename = path.filename();
+        if (it.depth() == 0 && (filename == ::backup_dir || filename == ::backup_dir_tmp ||
+                                filename == ::backup_dir_old)) {
+            it.disable_recursion_pending();
+        } else if (it->is_directory()) {
+            fs::create_directory(backup_dir_tmp / path.lexically_relative(dir_name));
+        } else if (it->is_regular_file()) {
+            backup_files.push_back(path);
         }
     }
 
@@ -62,12 +167,37 @@ static void backup(const std::filesystem::path& dir_name) {
     int total_count = static_cast<int>(backup_files.size());
     int current_count = 0;
 
-    fs::create_directory(backup_dir_tmp);
+    // Files whose content did not change since the last generation are hard linked from it.
+    // Backup files are never modified in place, so the generations can share them.
+    const Manifest prev_manifest = LoadManifest(backup_dir / ::backup_manifest);
+    Manifest manifest;
     for (const auto& file : backup_files) {
-        fs::copy(file, backup_dir_tmp / file.filename(), fs::copy_options::recursive);
+        const auto rel_path = file.lexically_relative(dir_name);
+        const auto dst_path = backup_dir_tmp / rel_path;
+        auto key = rel_path.generic_string();
+        const ManifestEntry entry{
+            .size = fs::file_size(file),
+            .hash = HashFile(file),
+        };
+
+        bool linked = false;
+        const auto prev = prev_manifest.find(key);
+        if (prev != prev_manifest.end() && prev->second.size == entry.size &&
+            XXH128_isEqual(prev->second.hash, entry.hash)) {
+            std::error_code ec;
+            fs::create_hard_link(backup_dir / rel_path, dst_path, ec);
+            linked = !ec;
+        }
+        if (!linked) {
+            CloneFile(file, dst_path);
+        }
+        manifest.emplace(std::move(key), entry);
+
         current_count++;
         g_backup_progress = current_count * 100 / total_count;
     }
+    SaveManifest(backup_dir_tmp / ::backup_manifest, manifest);
+
     bool has_existing_backup = fs::exists(backup_dir);
     if (has_existing_backup) {
         fs::rename(backup_dir, backup_dir_old);
@@ -199,7 +329,11 @@ bool NewRequest(OrbisUserServiceUserId user_id, std::string_view title_id,
 bool Restore(const std::filesystem::path& save_path) {
     LOG_INFO(Lib_SaveData, "Restoring backup for {}", fmt::UTF(save_path.u8string()));
     std::unique_lock lk{g_backup_running_mutex};
-    if (!fs::exists(save_path) || !fs::exists(save_path / backup_dir)) {
+    if (!fs::exists(save_path)) {
+        return false;
+    }
+    RecoverInterruptedBackup(save_path);
+    if (!fs::exists(save_path / backup_dir)) {
         return false;
     }
     for (const auto& entry : fs::directory_iterator(save_path)) {
@@ -211,8 +345,11 @@ bool Restore(const std::filesystem::path& save_path) {
 
     for (const auto& entry : fs::directory_iterator(save_path / backup_dir)) {
         const auto filename = entry.path().filename();
-        fs::copy(entry.path(), save_path / filename, fs::copy_options::recursive);
+        if (filename != backup_manifest) {
+            fs::copy(entry.path(), save_path / filename, fs::copy_options::recursive);
+        }
     }
+    Catalog::Invalidate(save_path.parent_path());
 
     return true;
 }
@@ -0,0 +1,125 @@
+// SPDX-FileCopyrightText: Copyright 2025 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <mutex>
+#include <numeric>
+#include <unordered_map>
+
+#include "common/assert.h"
+#include "common/io_file.h"
+#include "common/logging/log.h"
+#include "core/libraries/save_data/save_catalog.h"
+#include "core/libraries/save_data/save_instance.h"
+
+namespace fs = std::filesystem;
+
+namespace Libraries::SaveData::Catalog {
+
+constexpr u32 SaveDataBlockSize = 32768; // 32 KiB
+
+struct CachedCatalog {
+    fs::file_time_type dir_mtime;
+    std::shared_ptr<const TitleCatalog> catalog;
+    u32 writable_mounts;
+};
+
+static std::mutex g_catalog_mutex;
+static std::unordered_map<std::string, CachedCatalog> g_catalogs;
+
+static std::shared_ptr<const TitleCatalog> Scan(const fs::path& title_save_path) {
+    auto catalog = std::make_shared<TitleCatalog>();
+    auto& entries = catalog->entries;
+
+    for (const auto& path : fs::directory_iterator{title_save_path}) {
+        auto dir_name = path.path().filename().string();
+        // skip non-directories, sce_* and directories without param.sfo
+        if (!fs::is_directory(path) || dir_name.starts_with("sce_")) {
+            continue;
+        }
+        const auto sfo_path = SaveInstance::GetParamSFOPath(path);
+        if (!fs::exists(sfo_path)) {
+            continue;
+        }
+        PSF sfo;
+        if (!sfo.Open(sfo_path)) {
+            LOG_ERROR(Lib_SaveData, "Failed to read SFO: {}", fmt::UTF(sfo_path.u8string()));
+            ASSERT_MSG(false, "Failed to read SFO");
+        }
+
+        const size_t size = Common::FS::GetDirectorySize(path);
+        const size_t total = SaveInstance::GetMaxBlockFromSFO(sfo);
+        entries.push_back(Entry{
+            .dir_name = std::move(dir_name),
+            .sfo = std::move(sfo),
+            .max_blocks = static_cast<int>(total),
+            .free_blocks = total - size / SaveDataBlockSize,
+        });
+    }
+
+    const auto sorted = [&](auto&& proj) {
+        std::vector<u32> view(entries.size());
+        std::iota(view.begin(), view.end(), 0U);
+        std::ranges::stable_sort(view, {}, [&](u32 i) { return proj(entries[i]); });
+        return view;
+    };
+    auto& views = catalog->views;
+    views[static_cast<size_t>(SortKey::DirName)] =
+        sorted([](const Entry& e) -> const std::string& { return e.dir_name; });
+    views[static_cast<size_t>(SortKey::UserParam)] = sorted([](const Entry& e) {
+        return e.sfo.GetInteger(SaveParams::SAVEDATA_LIST_PARAM).value_or(0);
+    });
+    views[static_cast<size_t>(SortKey::Blocks)] =
+        sorted([](const Entry& e) { return e.max_blocks; });
+    views[static_cast<size_t>(SortKey::Mtime)] =
+        sorted([](const Entry& e) { return e.sfo.GetLastWrite(); });
+    views[static_cast<size_t>(SortKey::FreeBlocks)] =
+        sorted([](const Entry& e) { return e.free_blocks; });
+    views[static_cast<size_t>(SortKey::Unsorted)] = sorted([](const Entry&) { return 0; });
+
+    return catalog;
+}
+
+std::shared_ptr<const TitleCatalog> Get(const fs::path& title_save_path) {
+    // Adding, removing or renaming a save directory updates the modification time of the title
+    // directory. Writes by the emulator inside a save directory are reported through Invalidate,
+    // the guest can write to a save mounted for writing at any time.
+    std::error_code ec;
+    const auto dir_mtime = fs::last_write_time(title_save_path, ec);
+
+    std::scoped_lock lk{g_catalog_mutex};
+    auto& cached = g_catalogs[title_save_path.string()];
+    if (!cached.catalog || ec || cached.dir_mtime != dir_mtime || cached.writable_mounts != 0) {
+        cached.catalog = Scan(title_save_path);
+        cached.dir_mtime = dir_mtime;
+    }
+    return cached.catalog;
+}
+
+void Invalidate(const fs::path& title_save_path) {
+    std::scoped_lock lk{g_catalog_mutex};
+    if (const auto it = g_catalogs.find(title_save_path.string()); it != g_catalogs.end()) {
+        it->second.catalog.reset();
+    }
+}
+
+void OnMount(const fs::path& title_save_path, bool read_only) {
+    std::scoped_lock lk{g_catalog_mutex};
+    auto& cached = g_catalogs[title_save_path.string()];
+    cached.catalog.reset();
+    if (!read_only) {
+        ++cached.writable_mounts;
+    }
+}
+
+void OnUmount(const fs::path& title_save_path, bool read_only) {
+    std::scoped_lock lk{g_catalog_mutex};
+    auto& cached = g_catalogs[title_save_path.string()];
+    cached.catalog.reset();
+    if (!read_only) {
+        ASSERT(cached.writable_mounts > 0);
+        --cached.writable_mounts;
+    }
+}
+
+} // namespace Libraries::SaveData::Catalog
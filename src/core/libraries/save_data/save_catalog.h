@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: Copyright 2025 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/types.h"
+#include "core/file_format/psf.h"
+
+namespace Libraries::SaveData::Catalog {
+
+// Same values as OrbisSaveDataSortKey. The unused value 4 keeps directory iteration order.
+enum class SortKey : u32 {
+    DirName = 0,
+    UserParam = 1,
+    Blocks = 2,
+    Mtime = 3,
+    Unsorted = 4,
+    FreeBlocks = 5,
+    Count,
+};
+
+struct Entry {
+    std::string dir_name;
+    PSF sfo;
+    int max_blocks;
+    u64 free_blocks;
+};
+
+// Parsed save directories of one title and user
+struct TitleCatalog {
+    std::vector<Entry> entries; // In directory iteration order
+    // Entry indices stably sorted in ascending order, one view per key
+    std::array<std::vector<u32>, static_cast<size_t>(SortKey::Count)> views;
+
+    [[nodiscard]] const std::vector<u32>& View(SortKey key) const {
+        return views[static_cast<size_t>(key)];
+    }
+};
+
+// Returns the catalog of a title save path, scanning it again if the directory changed or the
+// catalog was invalidated since the last call. The path must exist.
+std::shared_ptr<const TitleCatalog> Get(const std::filesystem::path& title_save_path);
+
+// Drops the cached catalog. Called whenever the emulator writes to a save directory.
+void Invalidate(const std::filesystem::path& title_save_path);
+
+// Tracks saves mounted for the guest. While one is writable the catalog is scanned on every Get.
+void OnMount(const std::filesystem::path& title_save_path, bool read_only);
+void OnUmount(const std::filesystem::path& title_save_path, bool read_only);
+
+} // namespace Libraries::SaveData::Catalog
@@ -11,6 +11,7 @@
 #include "common/singleton.h"
 #include "core/file_sys/fs.h"
 #include "save_backup.h"
+#include "save_catalog.h"
 #include "save_instance.h"
 
 constexpr auto OrbisSaveDataBlocksMin2 = 96;    // 3MiB
@@ -189,6 +190,7 @@ void SaveInstance::SetupAndMount(bool read_only, bool copy_icon, bool ignore_cor
     g_mnt->Mount(save_path, mount_point, read_only);
     mounted = true;
     this->read_only = read_only;
+    Catalog::OnMount(save_path.parent_path(), read_only);
 }
 
 void SaveInstance::Umount() {
@@ -206,6 +208,7 @@ void SaveInstance::Umount() {
 
     fs::remove(corrupt_file_path);
     g_mnt->Unmount(save_path, mount_point);
+    Catalog::OnUmount(save_path.parent_path(), read_only);
 }
 
 void SaveInstance::CreateFiles() {
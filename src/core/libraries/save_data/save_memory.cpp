@@ -17,6 +17,7 @@
 #include "common/singleton.h"
 #include "common/thread.h"
 #include "core/file_sys/fs.h"
+#include "core/libraries/save_data/save_catalog.h"
 #include "core/libraries/system/msgdialog_ui.h"
 #include "save_instance.h"
 
@@ -63,6 +64,7 @@ void PersistMemory(u32 slot_id, bool lock) {
             if (f.IsOpen()) {
                 f.WriteRaw<u8>(data.memory_cache.data(), data.memory_cache.size());
                 f.Close();
+                Catalog::Invalidate(data.folder_path.parent_path());
                 return;
             }
             const auto err = std::error_code{r, std::iostream_category()};
@@ -152,6 +154,7 @@ void SetIcon(u32 slot_id, void* buf, size_t buf_size) {
         file.WriteRaw<u8>(buf, buf_size);
         file.Close();
     }
+    Catalog::Invalidate(data.folder_path.parent_path());
 }
 
 bool IsSaveMemoryInitialized(u32 slot_id) {
@@ -191,6 +194,7 @@ void SaveSFO(u32 slot_id) {
         throw std::filesystem::filesystem_error("Failed to write param.sfo", sfo_path,
                                                 std::make_error_code(std::errc::permission_denied));
     }
+    Catalog::Invalidate(data.folder_path.parent_path());
 }
 
 void ReadMemory(u32 slot_id, void* buf, size_t buf_size, int64_t offset) {
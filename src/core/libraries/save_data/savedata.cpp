@@ -24,6 +24,7 @@
 #include "core/libraries/system/msgdialog.h"
 #include "core/libraries/system/msgdialog_ui.h"
 #include "save_backup.h"
+#include "save_catalog.h"
 #include "save_instance.h"
 #include "save_memory.h"
 
@@ -742,6 +743,7 @@ Error PS4_SYSV_ABI sceSaveDataDelete(const OrbisSaveDataDelete* del) {
     try {
         if (fs::exists(save_path)) {
             fs::remove_all(save_path);
+            Catalog::Invalidate(save_path.parent_path());
         }
     } catch (const fs::filesystem_error& e) {
         LOG_ERROR(Lib_SaveData, "Failed to delete save data: {}", e.what());
@@ -795,68 +797,21 @@ Error PS4_SYSV_ABI sceSaveDataDirNameSearch(const OrbisSaveDataDirNameSearchCond
         return Error::OK;
     }
 
-    std::vector<std::string> dir_list;
+    const auto catalog = Catalog::Get(save_path);
+    const auto sort_key = static_cast<Catalog::SortKey>(cond->key);
 
-    for (const auto& path : fs::directory_iterator{save_path}) {
-        auto dir_name = path.path().filename().string();
-        // skip non-directories, sce_* and directories without param.sfo
-        if (fs::is_directory(path) && !dir_name.starts_with("sce_") &&
-            fs::exists(SaveInstance::GetParamSFOPath(path))) {
-            dir_list.push_back(dir_name);
+    // Views are stably sorted, so filtering them gives the same order as sorting the filtered list
+    std::vector<const Catalog::Entry*> dir_list;
+    dir_list.reserve(catalog->entries.size());
+    const auto pat = cond->dirName != nullptr
+                         ? Common::ToLower(std::string_view{cond->dirName->data})
+                         : std::string{};
+    for (const u32 index : catalog->View(sort_key)) {
+        const auto& entry = catalog->entries[index];
+        if (pat.empty() || match(Common::ToLower(entry.dir_name), pat)) {
+            dir_list.push_back(&entry);
         }
     }
-    if (cond->dirName != nullptr) {
-        // Filter names
-        const auto pat = Common::ToLower(std::string_view{cond->dirName->data});
-        if (!pat.empty()) {
-            std::erase_if(dir_list, [&](const std::string& dir_name) {
-                return !match(Common::ToLower(dir_name), pat);
-            });
-        }
-    }
-
-    std::unordered_map<std::string, PSF> map_dir_sfo;
-    std::unordered_map<std::string, int> map_max_blocks;
-    std::unordered_map<std::string, OrbisSaveDataBlocks> map_free_size;
-
-    for (const auto& dir_name : dir_list) {
-        const auto dir_path = SaveInstance::MakeDirSavePath(cond->userId, title_id, dir_name);
-        const auto sfo_path = SaveInstance::GetParamSFOPath(dir_path);
-        PSF sfo;
-        if (!sfo.Open(sfo_path)) {
-            LOG_ERROR(Lib_SaveData, "Failed to read SFO: {}", fmt::UTF(sfo_path.u8string()));
-            ASSERT_MSG(false, "Failed to read SFO");
-        }
-
-        size_t size = Common::FS::GetDirectorySize(dir_path);
-        size_t total = SaveInstance::GetMaxBlockFromSFO(sfo);
-
-        map_dir_sfo.emplace(dir_name, std::move(sfo));
-        map_free_size.emplace(dir_name, total - size / OrbisSaveDataBlockSize);
-        map_max_blocks.emplace(dir_name, total);
-    }
-
-#define PROJ(x) [&](const auto& v) { return x; }
-    switch (cond->key) {
-    case OrbisSaveDataSortKey::DIRNAME:
-        std::ranges::stable_sort(dir_list);
-        break;
-    case OrbisSaveDataSortKey::USER_PARAM:
-        std::ranges::stable_sort(
-            dir_list, {},
-            PROJ(map_dir_sfo.at(v).GetInteger(SaveParams::SAVEDATA_LIST_PARAM).value_or(0)));
-        break;
-    case OrbisSaveDataSortKey::BLOCKS:
-        std::ranges::stable_sort(dir_list, {}, PROJ(map_max_blocks.at(v)));
-        break;
-    case OrbisSaveDataSortKey::FREE_BLOCKS:
-        std::ranges::stable_sort(dir_list, {}, PROJ(map_free_size.at(v)));
-        break;
-    case OrbisSaveDataSortKey::MTIME:
-        std::ranges::stable_sort(dir_list, {}, PROJ(map_dir_sfo.at(v).GetLastWrite()));
-        break;
-    }
-#undef PROJ
 
     if (cond->order == OrbisSaveDataSortOrder::DESCENT) {
         std::ranges::reverse(dir_list);
@@ -871,19 +826,19 @@ Error PS4_SYSV_ABI sceSaveDataDirNameSearch(const OrbisSaveDataDirNameSearchCond
     }
 
     for (size_t i = 0; i < max_count; i++) {
+        const auto& entry = *dir_list[i];
         auto& name_data = result->dirNames[i].data;
-        name_data.FromString(dir_list[i]);
+        name_data.FromString(entry.dir_name);
 
         if (g_fw_ver >= ElfInfo::FW_17 && result->params != nullptr) {
-            auto& sfo = map_dir_sfo.at(dir_list[i]);
             auto& param_data = result->params[i];
-            param_data.FromSFO(sfo);
+            param_data.FromSFO(entry.sfo);
         }
 
         if (g_fw_ver >= ElfInfo::FW_25 && result->infos != nullptr) {
             auto& info = result->infos[i];
-            info.blocks = map_max_blocks.at(dir_list[i]);
-            info.freeBlocks = map_free_size.at(dir_list[i]);
+            info.blocks = entry.max_blocks;
+            info.freeBlocks = entry.free_blocks;
         }
     }
 
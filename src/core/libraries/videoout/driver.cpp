@@ -138,6 +138,8 @@ int VideoOutDriver::RegisterBuffers(VideoOutPort* port, s32 startIndex, void* co
         // Reset flip label also when registering buffer
         port->buffer_labels[startIndex + i] = 0;
         port->SignalVoLabel();
+        liverpool->NotifyMemoryWrite(
+            reinterpret_cast<VAddr>(&port->buffer_labels[startIndex + i]), sizeof(u64));
 
         presenter->RegisterVideoOutSurface(group, address);
         LOG_INFO(Lib_VideoOut, "buffers[{}] = {:#x}", i + startIndex, address);
@@ -203,6 +205,8 @@ void VideoOutDriver::Flip(const Request& req) {
     if (port->prev_index != -1) {
         port->buffer_labels[port->prev_index] = 0;
         port->SignalVoLabel();
+        liverpool->NotifyMemoryWrite(
+            reinterpret_cast<VAddr>(&port->buffer_labels[port->prev_index]), sizeof(u64));
     }
     // save to prev buf index
     port->prev_index = req.index;
@@ -1,11 +1,16 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <condition_variable>
+#include <memory>
 #include <mutex>
 #include <stop_token>
-#include <unordered_map>
+#include <thread>
 #include <queue>
+#include <vector>
 #include <zlib.h>
 
 #include "common/logging/log.h"
@@ -25,23 +30,89 @@ struct InflateTask {
     u32 dst_length;
 };
 
+/// Result of a finished request. Each request ID owns one slot, which a worker publishes without
+/// taking the queue mutex: length and status are written, then done is set with release semantics.
 struct InflateResult {
+    std::atomic<bool> done;
     u32 length;
     s32 status;
 };
 
-static Kernel::Thread task_thread;
+/// Result slots are allocated in chunks as request IDs are handed out, and kept until
+/// sceZlibFinalize, so sceZlibGetResult can be repeated for any request.
+static constexpr u64 ResultChunkSize = 4096;
+static constexpr u64 MaxResultChunks = 65536;
+using ResultChunk = std::array<InflateResult, ResultChunkSize>;
+
+/// Upper bound of host inflate workers.
+static constexpr u32 MaxWorkers = 4;
+
+static std::array<Kernel::Thread, MaxWorkers> workers;
+static u32 num_workers;
 
 static std::mutex mutex;
 static std::queue<InflateTask> task_queue;
 static std::condition_variable_any task_queue_cv;
 static std::queue<u64> done_queue;
 static std::condition_variable_any done_queue_cv;
-static std::unordered_map<u64, InflateResult> results;
+/// Looked up without locking. Chunks are only added, under mutex, before their IDs are handed out.
+static std::array<std::atomic<ResultChunk*>, MaxResultChunks> result_chunks;
+static std::vector<std::unique_ptr<ResultChunk>> result_storage;
 static u64 next_request_id;
 
-void ZlibTaskThread(const std::stop_token& stop) {
-    Common::SetCurrentThreadName("shadPS4:ZlibTaskThread");
+static bool IsInitialized() {
+    return workers[0].Joinable();
+}
+
+static InflateResult* FindResult(u64 request_id) {
+    const u64 chunk_index = request_id / ResultChunkSize;
+    if (chunk_index >= MaxResultChunks) {
+        return nullptr;
+    }
+    ResultChunk* chunk = result_chunks[chunk_index].load(std::memory_order_acquire);
+    return chunk ? &(*chunk)[request_id % ResultChunkSize] : nullptr;
+}
+
+/// Makes sure the slot of the next request ID exists. Requires mutex.
+static bool ReserveResult() {
+    const u64 chunk_index = next_request_id / ResultChunkSize;
+    if (chunk_index >= MaxResultChunks) {
+        return false;
+    }
+    if (!result_chunks[chunk_index].load(std::memory_order_relaxed)) {
+        auto& chunk = result_storage.emplace_back(std::make_unique<ResultChunk>());
+        result_chunks[chunk_index].store(chunk.get(), std::memory_order_release);
+    }
+    return true;
+}
+
+static s32 Inflate(z_stream& stream, const InflateTask& task, u32& length) {
+    // Reusing the stream keeps the window allocation alive between requests.
+    inflateReset(&stream);
+    // next_in is only const when zlib is built with ZLIB_CONST, inflate never writes to it.
+    stream.next_in = static_cast<Bytef*>(const_cast<void*>(task.src));
+    stream.avail_in = task.src_length;
+    stream.next_out = static_cast<Bytef*>(task.dst);
+    stream.avail_out = task.dst_length;
+
+    const int ret = inflate(&stream, Z_FINISH);
+    length = static_cast<u32>(stream.total_out);
+    if (ret == Z_STREAM_END) {
+        return ORBIS_OK;
+    }
+    // Same mapping as uncompress: running out of output space is the only Z_BUF_ERROR case,
+    // a truncated stream is a data error.
+    return stream.avail_out == 0 ? ORBIS_ZLIB_ERROR_NOSPACE : ORBIS_ZLIB_ERROR_FATAL;
+}
+
+void ZlibTaskThread(const std::stop_token& stop, u32 index) {
+    Common::SetCurrentThreadName(fmt::format("shadPS4:ZlibTaskThread{}", index).c_str());
+
+    z_stream stream{};
+    if (inflateInit(&stream) != Z_OK) {
+        LOG_ERROR(Lib_Zlib, "Failed to initialize inflate stream");
+        return;
+    }
 
     while (!stop.stop_requested()) {
         InflateTask task;
@@ -55,45 +126,50 @@ void ZlibTaskThread(const std::stop_token& stop) {
             task_queue.pop();
         }
 
-        uLongf decompressed_length = task.dst_length;
-        const auto ret = uncompress(static_cast<Bytef*>(task.dst), &decompressed_length,
-                                    static_cast<const Bytef*>(task.src), task.src_length);
+        u32 length{};
+        const s32 status = Inflate(stream, task, length);
+
+        auto* result = FindResult(task.request_id);
+        result->length = length;
+        result->status = status;
+        result->done.store(true, std::memory_order_release);
 
         {
-            // Lock, insert the new result, and push the finished request ID to the done queue.
-            std::unique_lock lock(mutex);
-            results[task.request_id] = InflateResult{
-                .length = static_cast<u32>(decompressed_length),
-                .status = ret == Z_BUF_ERROR ? ORBIS_ZLIB_ERROR_NOSPACE
-                          : ret == Z_OK      ? ORBIS_OK
-                                             : ORBIS_ZLIB_ERROR_FATAL,
-            };
+            std::scoped_lock lock(mutex);
             done_queue.push(task.request_id);
         }
         done_queue_cv.notify_one();
     }
+
+    inflateEnd(&stream);
 }
 
 s32 PS4_SYSV_ABI sceZlibInitialize(const void* buffer, u32 length) {
     LOG_INFO(Lib_Zlib, "called");
-    if (task_thread.Joinable()) {
+    if (IsInitialized()) {
         return ORBIS_ZLIB_ERROR_ALREADY_INITIALIZED;
     }
 
     // Initialize with empty task data
     task_queue = std::queue<InflateTask>();
     done_queue = std::queue<u64>();
-    results.clear();
+    for (auto& chunk : result_chunks) {
+        chunk.store(nullptr, std::memory_order_relaxed);
+    }
+    result_storage.clear();
     next_request_id = 1;
 
-    task_thread.Run([](const std::stop_token& stop) { ZlibTaskThread(stop); });
+    num_workers = std::clamp(std::thread::hardware_concurrency() / 2, 1U, MaxWorkers);
+    for (u32 i = 0; i < num_workers; i++) {
+        workers[i].Run([i](const std::stop_token& stop) { ZlibTaskThread(stop, i); });
+    }
     return ORBIS_OK;
 }
 
 s32 PS4_SYSV_ABI sceZlibInflate(const void* src, u32 src_len, void* dst, u32 dst_len,
                                 u64* request_id) {
     LOG_DEBUG(Lib_Zlib, "(STUBBED) called");
-    if (!task_thread.Joinable()) {
+    if (!IsInitialized()) {
         return ORBIS_ZLIB_ERROR_NOT_INITIALIZED;
     }
     if (!src || !src_len || !dst || !dst_len || !request_id || dst_len > 64_KB ||
@@ -103,6 +179,10 @@ s32 PS4_SYSV_ABI sceZlibInflate(const void* src, u32 src_len, void* dst, u32 dst
 
     {
         std::unique_lock lock(mutex);
+        if (!ReserveResult()) {
+            LOG_ERROR(Lib_Zlib, "Out of request IDs");
+            return ORBIS_ZLIB_ERROR_NOSPACE;
+        }
         *request_id = next_request_id++;
         task_queue.emplace(InflateTask{
             .request_id = *request_id,
@@ -118,7 +198,7 @@ s32 PS4_SYSV_ABI sceZlibInflate(const void* src, u32 src_len, void* dst, u32 dst
 
 s32 PS4_SYSV_ABI sceZlibWaitForDone(u64* request_id, const u32* timeout) {
     LOG_DEBUG(Lib_Zlib, "(STUBBED) called");
-    if (!task_thread.Joinable()) {
+    if (!IsInitialized()) {
         return ORBIS_ZLIB_ERROR_NOT_INITIALIZED;
     }
     if (!request_id) {
@@ -144,31 +224,31 @@ s32 PS4_SYSV_ABI sceZlibWaitForDone(u64* request_id, const u32* timeout) {
 
 s32 PS4_SYSV_ABI sceZlibGetResult(const u64 request_id, u32* dst_length, s32* status) {
     LOG_DEBUG(Lib_Zlib, "(STUBBED) called");
-    if (!task_thread.Joinable()) {
+    if (!IsInitialized()) {
         return ORBIS_ZLIB_ERROR_NOT_INITIALIZED;
     }
     if (!dst_length || !status) {
         return ORBIS_ZLIB_ERROR_INVALID;
     }
 
-    {
-        std::unique_lock lock(mutex);
-        if (!results.contains(request_id)) {
-            return ORBIS_ZLIB_ERROR_NOT_FOUND;
-        }
-        const auto result = results[request_id];
-        *dst_length = result.length;
-        *status = result.status;
+    // Unknown and still running requests are not found.
+    const auto* result = request_id != 0 ? FindResult(request_id) : nullptr;
+    if (!result || !result->done.load(std::memory_order_acquire)) {
+        return ORBIS_ZLIB_ERROR_NOT_FOUND;
     }
+    *dst_length = result->length;
+    *status = result->status;
     return ORBIS_OK;
 }
 
 s32 PS4_SYSV_ABI sceZlibFinalize() {
     LOG_INFO(Lib_Zlib, "called");
-    if (!task_thread.Joinable()) {
+    if (!IsInitialized()) {
         return ORBIS_ZLIB_ERROR_NOT_INITIALIZED;
     }
-    task_thread.Stop();
+    for (u32 i = 0; i < num_workers; i++) {
+        workers[i].Stop();
+    }
     return ORBIS_OK;
 }
 
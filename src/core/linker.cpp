@@ -13,6 +13,7 @@
 #include "core/aerolib/aerolib.h"
 #include "core/aerolib/stubs.h"
 #include "core/devtools/widget/module_list.h"
+#include "core/guest_profiler.h"
 #include "core/libraries/kernel/kernel.h"
 #include "core/libraries/kernel/memory.h"
 #include "core/libraries/kernel/threads.h"
@@ -106,6 +107,7 @@ void Linker::Execute(const std::vector<std::string>& args) {
 
     main_thread.Run([this, module, &args](std::stop_token) {
         Common::SetCurrentThreadName("GAME_MainThread");
+        Profiler::Instance()->RegisterCurrentThread("GAME_MainThread");
         if (auto& ipc = IPC::Instance()) {
             ipc.WaitForStart();
         }
@@ -136,6 +138,7 @@ void Linker::Execute(const std::vector<std::string>& args) {
         }
         params.entry_addr = module->GetEntryAddress();
         ExecuteGuest(RunMainEntry, &params);
+        Profiler::Instance()->UnregisterCurrentThread();
     });
 }
 
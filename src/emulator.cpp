@@ -29,8 +29,8 @@
 #include "core/debugger.h"
 #include "core/devtools/widget/module_list.h"
 #include "core/file_format/psf.h"
-#include "core/file_format/trp.h"
 #include "core/file_sys/fs.h"
+#include "core/guest_profiler.h"
 #include "core/libraries/disc_map/disc_map.h"
 #include "core/libraries/font/font.h"
 #include "core/libraries/font/fontft.h"
@@ -240,6 +240,7 @@ void Emulator::Run(std::filesystem::path file, std::vector<std::string> args,
     LOG_INFO(Config, "GPU shouldDumpShaders: {}", Config::dumpShaders());
     LOG_INFO(Config, "GPU vblankFrequency: {}", Config::vblankFreq());
     LOG_INFO(Config, "GPU shouldCopyGPUBuffers: {}", Config::copyGPUCmdBuffers());
+    LOG_INFO(Config, "GPU framesInFlight: {}", Config::getGpuFramesInFlight());
     LOG_INFO(Config, "Vulkan gpuId: {}", Config::getGpuId());
     LOG_INFO(Config, "Vulkan vkValidation: {}", Config::vkValidationEnabled());
     LOG_INFO(Config, "Vulkan vkValidationCore: {}", Config::vkValidationCoreEnabled());
@@ -249,6 +250,7 @@ void Emulator::Run(std::filesystem::path file, std::vector<std::string> args,
     LOG_INFO(Config, "Vulkan hostMarkers: {}", Config::getVkHostMarkersEnabled());
     LOG_INFO(Config, "Vulkan guestMarkers: {}", Config::getVkGuestMarkersEnabled());
     LOG_INFO(Config, "Vulkan rdocEnable: {}", Config::isRdocEnabled());
+    LOG_INFO(Config, "Vulkan shaderServiceSocket: {}", Config::getShaderServiceSocket());
 
     hwinfo::Memory ram;
     hwinfo::OS os;
@@ -298,10 +300,7 @@ void Emulator::Run(std::filesystem::path file, std::vector<std::string> args,
         const auto trophyDir =
             Common::FS::GetUserPath(Common::FS::PathType::MetaDataDir) / id / "TrophyFiles";
         if (!std::filesystem::exists(trophyDir)) {
-            TRP trp;
-            if (!trp.Extract(game_folder, id)) {
-                LOG_ERROR(Loader, "Couldn't extract trophies");
-            }
+            Libraries::Np::NpTrophy::ExtractTrophyFilesAsync(game_folder);
         }
     }
 
@@ -404,6 +403,7 @@ void Emulator::Run(std::filesystem::path file, std::vector<std::string> args,
     }
 
     args.insert(args.begin(), eboot_name.generic_string());
+    Core::Profiler::Instance()->Start(Config::getGuestProfilerFrequency());
     linker->Execute(args);
 
     window->InitTimers();
@@ -413,6 +413,8 @@ void Emulator::Run(std::filesystem::path file, std::vector<std::string> args,
 
     UpdatePlayTime(id);
     Storage::DataBase::Instance().Close();
+    Core::Profiler::Instance()->Stop(Common::FS::GetUserPath(Common::FS::PathType::LogDir) /
+                                     "guest_profile.folded");
 
     std::quick_exit(0);
 }
@@ -547,6 +549,11 @@ void Emulator::LoadSystemModules(const std::string& game_serial) {
         if (it != found_modules.end()) {
             LOG_INFO(Loader, "Loading {}", it->string());
             if (linker->LoadModule(*it) != -1) {
+                if (module_name == "libSceLibcInternal.sprx" && Config::getHostLibcStrings()) {
+                    // HLE symbols are resolved before the exports of loaded modules.
+                    LOG_INFO(Loader, "Using host string routines over {}", module_name);
+                    Libraries::LibcInternal::RegisterHostStringFunctions(&linker->GetHLESymbols());
+                }
                 continue;
             }
         }
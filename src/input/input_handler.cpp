@@ -61,6 +61,25 @@ std::list<std::pair<InputEvent, bool>> pressed_keys;
 std::list<InputID> toggled_keys;
 static std::vector<BindingConnection> connections;
 
+// Connections indexed by their inputs, rebuilt after every config parse.
+// A connection can only activate when each of its inputs is pressed or toggled, so every other
+// connection would produce an inactive event, which doesn't change any output. Connections with
+// an input that a key toggle can change in the middle of an update are always checked.
+struct ConnectionTable {
+    std::unordered_map<u64, std::vector<u32>> by_input;
+    std::vector<u32> always_checked;
+    std::vector<u8> num_inputs;
+    std::vector<u8> hits;
+    std::vector<u32> candidates;
+    std::vector<const std::vector<u32>*> counted;
+};
+static ConnectionTable connection_table;
+static void BuildConnectionTable();
+
+static u64 GetInputKey(InputID input) {
+    return (static_cast<u64>(input.type) << 32) | input.sdl_id;
+}
+
 auto output_array = std::array{
     // Important: these have to be the first, or else they will update in the wrong order
     ControllerOutput(LEFTJOYSTICK_HALFMODE),
@@ -432,9 +451,41 @@ void ParseInputConfig(const std::string game_id = "") {
     for (auto& c : connections) {
         LOG_DEBUG(Input, "Binding: {} : {}", c.output->ToString(), c.binding.ToString());
     }
+    BuildConnectionTable();
     LOG_DEBUG(Input, "Done parsing the input config!");
 }
 
+static void BuildConnectionTable() {
+    auto& table = connection_table;
+    table.by_input.clear();
+    table.always_checked.clear();
+    table.num_inputs.assign(connections.size(), 0);
+    table.hits.assign(connections.size(), 0);
+
+    std::unordered_set<u64> toggle_targets;
+    for (const auto& c : connections) {
+        if (c.output->button == KEY_TOGGLE) {
+            toggle_targets.insert(GetInputKey(c.toggle));
+        }
+    }
+    for (u32 index = 0; index < connections.size(); index++) {
+        const auto& keys = connections[index].binding.keys;
+        bool toggleable = false;
+        for (u32 i = 0; i < 3; i++) {
+            if (!keys[i].IsValid() || std::find(keys, keys + i, keys[i]) != keys + i) {
+                continue;
+            }
+            const u64 key = GetInputKey(keys[i]);
+            table.by_input[key].push_back(index);
+            ++table.num_inputs[index];
+            toggleable |= toggle_targets.contains(key);
+        }
+        if (toggleable) {
+            table.always_checked.push_back(index);
+        }
+    }
+}
+
 u32 GetMouseWheelEvent(const SDL_Event& event) {
     if (event.type != SDL_EVENT_MOUSE_WHEEL && event.type != SDL_EVENT_MOUSE_WHEEL_OFF) {
         LOG_WARNING(Input, "Something went wrong with wheel input parsing!");
@@ -780,8 +831,43 @@ void ActivateOutputsFromInputs() {
     // Check for input blockers
     ApplyMouseInputBlockers();
 
-    // Iterate over all inputs, and update their respecive outputs accordingly
-    for (auto& it : connections) {
+    // Find the connections whose inputs are all pressed or toggled
+    auto& table = connection_table;
+    table.candidates = table.always_checked;
+    table.counted.clear();
+    const auto CountInput = [&](InputID input) {
+        const auto it = table.by_input.find(GetInputKey(input));
+        if (it == table.by_input.end()) {
+            return;
+        }
+        table.counted.push_back(&it->second);
+        for (const u32 index : it->second) {
+            if (++table.hits[index] == table.num_inputs[index]) {
+                table.candidates.push_back(index);
+            }
+        }
+    };
+    for (const auto& [event, flag] : pressed_keys) {
+        CountInput(event.input);
+    }
+    for (const InputID& input : toggled_keys) {
+        if (std::ranges::find(pressed_keys, input, [](const auto& e) { return e.first.input; }) ==
+            pressed_keys.end()) {
+            CountInput(input);
+        }
+    }
+    for (const auto* indices : table.counted) {
+        for (const u32 index : *indices) {
+            table.hits[index] = 0;
+        }
+    }
+
+    // Update their respective outputs in the original connection order
+    std::ranges::sort(table.candidates);
+    const auto [first, last] = std::ranges::unique(table.candidates);
+    table.candidates.erase(first, last);
+    for (const u32 index : table.candidates) {
+        auto& it = connections[index];
         it.output->AddUpdate(it.ProcessBinding());
     }
 
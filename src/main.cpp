@@ -17,6 +17,7 @@
 #include "core/file_sys/fs.h"
 #include "core/game_util.h"
 #include "core/ipc/ipc.h"
+#include "core/ipc/shader_service.h"
 #include "emulator.h"
 
 #ifdef _WIN32
@@ -97,6 +98,13 @@ int main(int argc, char* argv[]) {
     Common::ArgParser parser;
     auto args = parser.Parse(argc, argv);
 
+    // Run as a shader cache service instead of an emulator instance
+    if (args.shader_service_socket.has_value()) {
+        Common::Log::Initialize("shader_service.log");
+        Common::Log::Start();
+        return ShaderService::RunServer(*args.shader_service_socket);
+    }
+
     // Validate game argument
     if (!args.has_game_argument) {
         std::cerr << "Error: Please provide a game path or ID.\n";
@@ -75,6 +75,27 @@ struct InfoPersistent {
     bool has_bitwise_xor{};
     bool uses_dma{};
 
+    /// Transfer that a trivial compute shader can be replaced with, found by HlePatternPass.
+    struct HlePattern {
+        enum class Type : u8 {
+            None,
+            FillBuffer,
+            CopyBuffer,
+        };
+
+        Type type{};
+        bool value_is_user_data{}; ///< value is the user data register holding the fill value
+        bool narrow_ids{};         ///< Thread ids go through 24-bit multiplies
+        u32 dst_buffer{};          ///< Index of the written buffer
+        u32 src_buffer{};          ///< Index of the read buffer, for copies
+        u32 dst_offset{};          ///< First dword written, relative to the buffer
+        u32 src_offset{};          ///< First dword read, relative to the buffer
+        u32 dwords_per_thread{};
+        u32 threads_per_group{};
+        u32 value{};
+    };
+    HlePattern hle_pattern{};
+
     InfoPersistent() = default;
     InfoPersistent(Stage stage_, LogicalStage l_stage_, u64 pgm_hash_)
         : stage{stage_}, l_stage{l_stage_}, pgm_hash{pgm_hash_} {}
@@ -0,0 +1,284 @@
+// SPDX-FileCopyrightText: Copyright 2025 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <bit>
+#include <optional>
+#include "shader_recompiler/ir/operand_helper.h"
+#include "shader_recompiler/ir/program.h"
+#include "shader_recompiler/runtime_info.h"
+
+namespace Shader::Optimization {
+
+namespace {
+
+/// Buffer dword index of the form workgroup_id.x * workgroup + local_id.x * local + offset.
+struct AffineIndex {
+    s64 workgroup{};
+    s64 local{};
+    s64 offset{};
+
+    bool IsConstant() const noexcept {
+        return workgroup == 0 && local == 0;
+    }
+
+    bool IsPlainId() const noexcept {
+        return offset == 0 && ((workgroup == 1 && local == 0) || (workgroup == 0 && local == 1));
+    }
+
+    bool IsInRange() const noexcept {
+        const auto fits = [](s64 value) { return value >= 0 && value <= s64{UINT32_MAX}; };
+        return fits(workgroup) && fits(local) && fits(offset);
+    }
+};
+
+std::optional<AffineIndex> EvaluateIndex(const IR::Value& value, bool& narrow_ids) {
+    if (value.IsImmediate()) {
+        if (value.Type() != IR::Type::U32) {
+            return std::nullopt;
+        }
+        return AffineIndex{.offset = value.U32()};
+    }
+    const IR::Inst* inst = value.InstRecursive();
+    switch (inst->GetOpcode()) {
+    case IR::Opcode::GetAttributeU32: {
+        if (inst->Arg(1).U32() != 0) {
+            return std::nullopt;
+        }
+        switch (inst->Arg(0).Attribute()) {
+        case IR::Attribute::WorkgroupId:
+            return AffineIndex{.workgroup = 1};
+        case IR::Attribute::LocalInvocationId:
+            return AffineIndex{.local = 1};
+        default:
+            return std::nullopt;
+        }
+    }
+    case IR::Opcode::IAdd32:
+    case IR::Opcode::ISub32: {
+        const auto lhs = EvaluateIndex(inst->Arg(0), narrow_ids);
+        const auto rhs = EvaluateIndex(inst->Arg(1), narrow_ids);
+        if (!lhs || !rhs) {
+            return std::nullopt;
+        }
+        const s64 sign = inst->GetOpcode() == IR::Opcode::IAdd32 ? 1 : -1;
+        return AffineIndex{
+            .workgroup = lhs->workgroup + sign * rhs->workgroup,
+            .local = lhs->local + sign * rhs->local,
+            .offset = lhs->offset + sign * rhs->offset,
+        };
+    }
+    case IR::Opcode::IMul32: {
+        auto lhs = EvaluateIndex(inst->Arg(0), narrow_ids);
+        auto rhs = EvaluateIndex(inst->Arg(1), narrow_ids);
+        if (!lhs || !rhs) {
+            return std::nullopt;
+        }
+        if (!lhs->IsConstant()) {
+            std::swap(lhs, rhs);
+        }
+        if (!lhs->IsConstant()) {
+            return std::nullopt;
+        }
+        const s64 scale = lhs->offset;
+        return AffineIndex{
+            .workgroup = rhs->workgroup * scale,
+            .local = rhs->local * scale,
+            .offset = rhs->offset * scale,
+        };
+    }
+    case IR::Opcode::ShiftLeftLogical32:
+    case IR::Opcode::ShiftRightLogical32: {
+        const auto base = EvaluateIndex(inst->Arg(0), narrow_ids);
+        if (!base || !inst->Arg(1).IsImmediate() || inst->Arg(1).U32() >= 32) {
+            return std::nullopt;
+        }
+        const s64 factor = s64{1} << inst->Arg(1).U32();
+        if (inst->GetOpcode() == IR::Opcode::ShiftLeftLogical32) {
+            return AffineIndex{
+                .workgroup = base->workgroup * factor,
+                .local = base->local * factor,
+                .offset = base->offset * factor,
+            };
+        }
+        // Dividing is only exact when every term is a multiple of the divisor.
+        if (base->workgroup % factor != 0 || base->local % factor != 0 ||
+            base->offset % factor != 0) {
+            return std::nullopt;
+        }
+        return AffineIndex{
+            .workgroup = base->workgroup / factor,
+            .local = base->local / factor,
+            .offset = base->offset / factor,
+        };
+    }
+    case IR::Opcode::BitFieldUExtract: {
+        // 24-bit multiplies mask their operands. Thread ids are left untouched as long as the
+        // dispatch is small enough, which is checked before the transfer is executed.
+        const auto base = EvaluateIndex(inst->Arg(0), narrow_ids);
+        if (!base || !base->IsPlainId() || !inst->Arg(1).IsImmediate() ||
+            inst->Arg(1).U32() != 0 || !inst->Arg(2).IsImmediate() || inst->Arg(2).U32() < 24) {
+            return std::nullopt;
+        }
+        narrow_ids = true;
+        return base;
+    }
+    default:
+        return std::nullopt;
+    }
+}
+
+u32 NumStoredDwords(IR::Opcode opcode) {
+    switch (opcode) {
+    case IR::Opcode::StoreBufferU32:
+    case IR::Opcode::StoreBufferF32:
+        return 1;
+    case IR::Opcode::StoreBufferU32x2:
+    case IR::Opcode::StoreBufferF32x2:
+        return 2;
+    case IR::Opcode::StoreBufferU32x3:
+    case IR::Opcode::StoreBufferF32x3:
+        return 3;
+    case IR::Opcode::StoreBufferU32x4:
+    case IR::Opcode::StoreBufferF32x4:
+        return 4;
+    default:
+        return 0;
+    }
+}
+
+u32 NumLoadedDwords(IR::Opcode opcode) {
+    switch (opcode) {
+    case IR::Opcode::LoadBufferU32:
+    case IR::Opcode::LoadBufferF32:
+        return 1;
+    case IR::Opcode::LoadBufferU32x2:
+    case IR::Opcode::LoadBufferF32x2:
+        return 2;
+    case IR::Opcode::LoadBufferU32x3:
+    case IR::Opcode::LoadBufferF32x3:
+        return 3;
+    case IR::Opcode::LoadBufferU32x4:
+    case IR::Opcode::LoadBufferF32x4:
+        return 4;
+    default:
+        return 0;
+    }
+}
+
+/// Returns the single instruction with side effects if the program runs it unconditionally.
+const IR::Inst* FindSingleStore(const IR::Program& program) {
+    for (const auto& node : program.syntax_list) {
+        if (node.type != IR::AbstractSyntaxNode::Type::Block &&
+            node.type != IR::AbstractSyntaxNode::Type::Return &&
+            node.type != IR::AbstractSyntaxNode::Type::Unreachable) {
+            return nullptr;
+        }
+    }
+    const IR::Inst* store = nullptr;
+    for (const IR::Block* block : program.blocks) {
+        for (const IR::Inst& inst : block->Instructions()) {
+            switch (inst.GetOpcode()) {
+            case IR::Opcode::Prologue:
+            case IR::Opcode::Epilogue:
+            case IR::Opcode::Reference:
+                continue;
+            default:
+                break;
+            }
+            if (!inst.MayHaveSideEffects()) {
+                continue;
+            }
+            if (store || NumStoredDwords(inst.GetOpcode()) == 0) {
+                return nullptr;
+            }
+            store = &inst;
+        }
+    }
+    return store;
+}
+
+/// Checks that every thread of a one-dimensional dispatch accesses the next dwords of a plain
+/// buffer, returning the index of the buffer.
+std::optional<u32> MatchLinearAccess(const Info& info, const IR::Inst& inst, u32 num_dwords,
+                                     u32 workgroup_size, bool& narrow_ids, u32& offset) {
+    const auto& handle = inst.Arg(IR::LoadBufferArgs::Handle);
+    if (!handle.IsImmediate() || inst.Flags<IR::BufferInstInfo>().typed) {
+        return std::nullopt;
+    }
+    const u32 buffer_index = handle.U32();
+    if (buffer_index >= info.buffers.size()) {
+        return std::nullopt;
+    }
+    const auto& desc = info.buffers[buffer_index];
+    if (desc.IsSpecial() || desc.is_formatted) {
+        return std::nullopt;
+    }
+    const auto index = EvaluateIndex(inst.Arg(IR::LoadBufferArgs::Address), narrow_ids);
+    if (!index || !index->IsInRange() || index->local != num_dwords ||
+        index->workgroup != s64{num_dwords} * workgroup_size) {
+        return std::nullopt;
+    }
+    offset = static_cast<u32>(index->offset);
+    return buffer_index;
+}
+
+} // Anonymous namespace
+
+void HlePatternPass(IR::Program& program, const RuntimeInfo& runtime_info) {
+    auto& info = program.info;
+    info.hle_pattern = {};
+    if (info.stage != Stage::Compute || info.uses_dma) {
+        return;
+    }
+    const auto& workgroup_size = runtime_info.cs_info.workgroup_size;
+    if (workgroup_size[1] != 1 || workgroup_size[2] != 1) {
+        return;
+    }
+    const IR::Inst* store = FindSingleStore(program);
+    if (!store) {
+        return;
+    }
+
+    Info::HlePattern pattern{};
+    const u32 num_dwords = NumStoredDwords(store->GetOpcode());
+    const auto dst_buffer = MatchLinearAccess(info, *store, num_dwords, workgroup_size[0],
+                                              pattern.narrow_ids, pattern.dst_offset);
+    if (!dst_buffer) {
+        return;
+    }
+    pattern.dst_buffer = *dst_buffer;
+    pattern.dwords_per_thread = num_dwords;
+    pattern.threads_per_group = workgroup_size[0];
+
+    // Fill: every thread stores the same value.
+    const IR::Value data = store->Arg(IR::StoreBufferArgs::Data).Resolve();
+    if (num_dwords == 1 && data.IsImmediate()) {
+        pattern.type = Info::HlePattern::Type::FillBuffer;
+        pattern.value = data.Type() == IR::Type::F32 ? std::bit_cast<u32>(data.F32()) : data.U32();
+        info.hle_pattern = pattern;
+        return;
+    }
+    const IR::Inst* source = data.InstRecursive();
+    if (num_dwords == 1 && source->GetOpcode() == IR::Opcode::GetUserData) {
+        pattern.type = Info::HlePattern::Type::FillBuffer;
+        pattern.value_is_user_data = true;
+        pattern.value = static_cast<u32>(source->Arg(0).ScalarReg());
+        info.hle_pattern = pattern;
+        return;
+    }
+
+    // Copy: every thread stores what it loaded from the same position in another buffer.
+    if (NumLoadedDwords(source->GetOpcode()) != num_dwords) {
+        return;
+    }
+    const auto src_buffer = MatchLinearAccess(info, *source, num_dwords, workgroup_size[0],
+                                              pattern.narrow_ids, pattern.src_offset);
+    if (!src_buffer || *src_buffer == *dst_buffer || info.buffers[*src_buffer].is_written) {
+        return;
+    }
+    pattern.type = Info::HlePattern::Type::CopyBuffer;
+    pattern.src_buffer = *src_buffer;
+    info.hle_pattern = pattern;
+}
+
+} // namespace Shader::Optimization
@@ -86,6 +86,7 @@ IR::Program TranslateProgram(const std::span<const u32>& code, Pools& pools, Inf
     Shader::Optimization::DeadCodeEliminationPass(program);
     Shader::Optimization::ConstantPropagationPass(program.post_order_blocks);
     Shader::Optimization::CollectShaderInfoPass(program, profile);
+    Shader::Optimization::HlePatternPass(program, runtime_info);
 
     Shader::IR::DumpProgram(program, info);
 
@@ -0,0 +1,56 @@
+// SPDX-FileCopyrightText: Copyright 2025 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <chrono>
+
+#include "common/types.h"
+
+namespace AmdGpu {
+
+/// Command processor counters gathered over one GNM frame. They are only written from the GPU
+/// thread and published as a whole when the frame end marker is processed.
+struct CpFrameStats {
+    u64 frame;                    ///< Fence of the frame, zero until its frame end marker ran
+    std::array<u32, 256> packets; ///< Type-3 packets by PM4ItOpcode
+    u32 num_packets;
+    u32 draws;
+    u32 dispatches;
+    u32 dma_transfers;
+    u32 yields;              ///< Coroutine yields of all queues
+    u32 wait_reg_mem_yields; ///< Yields caused by WaitRegMem conditions that were not met yet
+    u32 resumes;             ///< Queue task resumes by the scheduler loop
+    u64 busy_ns;             ///< Time spent in queue tasks
+    u64 rasterizer_ns;       ///< Part of busy_ns spent in draw, dispatch and DMA calls
+    u32 bindings_emitted;    ///< Host descriptors, push constants and vertex/index bindings
+    u32 bindings_skipped;    ///< Bindings left out because the command buffer already held them
+
+    u64 ParseNs() const {
+        return busy_ns > rasterizer_ns ? busy_ns - rasterizer_ns : 0;
+    }
+};
+
+/// Counts an event and adds the lifetime of the scope to a nanosecond counter.
+class CpStatsScope {
+public:
+    explicit CpStatsScope(u32& counter, u64& time_ns_)
+        : time_ns{time_ns_}, start{std::chrono::steady_clock::now()} {
+        ++counter;
+    }
+
+    ~CpStatsScope() {
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        time_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    }
+
+    CpStatsScope(const CpStatsScope&) = delete;
+    CpStatsScope& operator=(const CpStatsScope&) = delete;
+
+private:
+    u64& time_ns;
+    std::chrono::steady_clock::time_point start;
+};
+
+} // namespace AmdGpu
@@ -32,6 +32,7 @@ static_assert(Liverpool::NumComputeRings <= MAX_NAMES);
 static const char* acb_task_name[] = NAME_ARRAY(ACB_TASK, MAX_NAMES);
 
 #define YIELD(name)                                                                                \
+    ++cp_stats.yields;                                                                             \
     FIBER_EXIT;                                                                                    \
     co_yield {};                                                                                   \
     FIBER_ENTER(name);
@@ -97,7 +98,7 @@ void Liverpool::Process(std::stop_token stoken) {
         {
             std::unique_lock lk{submit_mutex};
             Common::CondvarWait(submit_cv, lk, stoken,
-                                [this] { return num_commands || num_submits || submit_done; });
+                                [this] { return num_commands || num_submits; });
         }
         if (stoken.stop_requested()) {
             break;
@@ -106,12 +107,33 @@ void Liverpool::Process(std::stop_token stoken) {
         VideoCore::StartCapture();
 
         curr_qid = -1;
+        bool resumed = true;
+        u32 wake_seq{};
+        u32 submits{};
 
         while (num_submits || num_commands) {
             ProcessCommands();
 
             curr_qid = (curr_qid + 1) % num_mapped_queues;
 
+            if (curr_qid == 0) {
+                if (wait_registry.HasBlocked()) {
+                    const auto deadline = wait_registry.Expire(WaitRegistry::Clock::now());
+                    // A full pass that resumed nothing means every pending queue is blocked on a
+                    // WaitRegMem condition, so sleep until one of them may make progress.
+                    if (!resumed) {
+                        WaitQueueWake(deadline, wake_seq, submits);
+                    }
+                }
+                resumed = false;
+                wake_seq = wait_registry.WakeSequence();
+                submits = num_submits;
+            }
+
+            if (wait_registry.IsBlocked(curr_qid)) {
+                continue;
+            }
+
             auto& queue = mapped_queues[curr_qid];
 
             Task::Handle task{};
@@ -122,13 +144,27 @@ void Liverpool::Process(std::stop_token stoken) {
                 }
                 task = queue.submits.front();
             }
-            task.resume();
+            queue_stalled = false;
+            {
+                const CpStatsScope stats_scope{cp_stats.resumes, cp_stats.busy_ns};
+                task.resume();
+            }
+            // Published here rather than by the frame end task, so the resume that closed the
+            // frame is still accounted to it.
+            if (cp_stats.frame != 0) {
+                DebugState.PushCpFrameStats(cp_stats);
+                cp_stats = {};
+            }
+            // A frame end waiting on the compute rings must not keep the scheduler from sleeping
+            // while those rings are blocked.
+            resumed |= !queue_stalled;
 
             if (task.done()) {
                 task.destroy();
 
                 std::scoped_lock lock{queue.m_access};
                 queue.submits.pop();
+                ++queue.num_completed;
 
                 --num_submits;
                 std::scoped_lock lock2{submit_mutex};
@@ -136,17 +172,50 @@ void Liverpool::Process(std::stop_token stoken) {
             }
         }
 
-        if (submit_done) {
-            VideoCore::EndCapture();
-            if (rasterizer) {
-                rasterizer->OnSubmit();
-                rasterizer->Flush();
-            }
-            submit_done = false;
+        Platform::IrqC::Instance()->Signal(Platform::InterruptId::GpuIdle);
+    }
+}
+
+void Liverpool::WaitQueueWake(WaitRegistry::Clock::time_point deadline, u32 wake_seq,
+                              u32 submits) {
+    {
+        std::unique_lock lk{submit_mutex};
+        submit_cv.wait_until(lk, deadline, [&] {
+            return num_commands || num_submits != submits ||
+                   wait_registry.WakeSequence() != wake_seq;
+        });
+    }
+    wait_registry.Expire(WaitRegistry::Clock::now());
+}
+
+Liverpool::Task Liverpool::ProcessFrameEnd(u64 fence, ComputeFences compute_fences) {
+    FIBER_ENTER(dcb_task_name);
+
+    // Queued on the graphics ring by SubmitDone, so it runs once every graphics submission of
+    // the frame has been consumed. Compute rings run independently, wait for the submissions
+    // they had queued when the frame was closed.
+    for (u32 i = 0; i < NumComputeRings; ++i) {
+        while (mapped_queues[i + 1].num_completed < compute_fences[i]) {
+            queue_stalled = true;
+            YIELD_GFX();
         }
+    }
 
-        Platform::IrqC::Instance()->Signal(Platform::InterruptId::GpuIdle);
+    VideoCore::EndCapture();
+    if (rasterizer) {
+        rasterizer->OnSubmit();
+        rasterizer->Flush();
+        const auto binding_stats = rasterizer->TakeBindingStats();
+        cp_stats.bindings_emitted = binding_stats.emitted_bindings;
+        cp_stats.bindings_skipped = binding_stats.skipped_bindings;
+    }
+    cp_stats.frame = fence;
+    {
+        std::scoped_lock lk{frame_mutex};
+        frames_completed.store(fence, std::memory_order_release);
     }
+    frame_cv.notify_all();
+    FIBER_EXIT;
 }
 
 Liverpool::Task Liverpool::ProcessCeUpdate(std::span<const u32> ccb) {
@@ -163,6 +232,8 @@ Liverpool::Task Liverpool::ProcessCeUpdate(std::span<const u32> ccb) {
         }
 
         const PM4ItOpcode opcode = header->type3.opcode;
+        ++cp_stats.packets[static_cast<u8>(opcode)];
+        ++cp_stats.num_packets;
         const auto* it_body = reinterpret_cast<const u32*>(header) + 1;
         switch (opcode) {
         case PM4ItOpcode::Nop: {
@@ -252,6 +323,8 @@ Liverpool::Task Liverpool::ProcessGraphics(std::span<const u32> dcb, std::span<c
         case 3:
             const u32 count = header->type3.NumWords();
             const PM4ItOpcode opcode = header->type3.opcode;
+            ++cp_stats.packets[static_cast<u8>(opcode)];
+            ++cp_stats.num_packets;
             switch (opcode) {
             case PM4ItOpcode::Nop: {
                 const auto* nop = reinterpret_cast<const PM4CmdNop*>(header);
@@ -427,6 +500,7 @@ Liverpool::Task Liverpool::ProcessGraphics(std::span<const u32> dcb, std::span<c
                 }
                 if (rasterizer) {
                     const auto cmd_address = reinterpret_cast<const void*>(header);
+                    const CpStatsScope stats_scope{cp_stats.draws, cp_stats.rasterizer_ns};
                     rasterizer->ScopeMarkerBegin(fmt::format("gfx:{}:DrawIndex2", cmd_address));
                     rasterizer->Draw(true);
                     rasterizer->ScopeMarkerEnd();
@@ -444,6 +518,7 @@ Liverpool::Task Liverpool::ProcessGraphics(std::span<const u32> dcb, std::span<c
                 }
                 if (rasterizer) {
                     const auto cmd_address = reinterpret_cast<const void*>(header);
+                    const CpStatsScope stats_scope{cp_stats.draws, cp_stats.rasterizer_ns};
                     rasterizer->ScopeMarkerBegin(
                         fmt::format("gfx:{}:DrawIndexOffset2", cmd_address));
                     rasterizer->Draw(true, draw_index_off->index_offset);
@@ -460,6 +535,7 @@ Liverpool::Task Liverpool::ProcessGraphics(std::span<const u32> dcb, std::span<c
                 }
                 if (rasterizer) {
                     const auto cmd_address = reinterpret_cast<const void*>(header);
+                    const CpStatsScope stats_scope{cp_stats.draws, cp_stats.rasterizer_ns};
                     rasterizer->ScopeMarkerBegin(fmt::format("gfx:{}:DrawIndexAuto", cmd_address));
                     rasterizer->Draw(false);
                     rasterizer->ScopeMarkerEnd();
@@ -475,6 +551,7 @@ Liverpool::Task Liverpool::ProcessGraphics(std::span<const u32> dcb, std::span<c
                 }
                 if (rasterizer) {
                     const auto cmd_address = reinterpret_cast<const void*>(header);
+                    const CpStatsScope stats_scope{cp_stats.draws, cp_stats.rasterizer_ns};
                     rasterizer->ScopeMarkerBegin(fmt::format("gfx:{}:DrawIndirect", cmd_address));
                     rasterizer->DrawIndirect(false, indirect_args_addr, offset, stride, 1, 0);
                     rasterizer->ScopeMarkerEnd();
@@ -491,6 +568,7 @@ Liverpool::Task Liverpool::ProcessGraphics(std::span<const u32> dcb, std::span<c
                 }
                 if (rasterizer) {
                     const auto cmd_address = reinterpret_cast<const void*>(header);
+                    const CpStatsScope stats_scope{cp_stats.draws, cp_stats.rasterizer_ns};
                     rasterizer->ScopeMarkerBegin(
                         fmt::format("gfx:{}:DrawIndexIndirect", cmd_address));
                     rasterizer->DrawIndirect(true, indirect_args_addr, offset, stride, 1, 0);
@@ -507,6 +585,7 @@ Liverpool::Task Liverpool::ProcessGraphics(std::span<const u32> dcb, std::span<c
                 }
                 if (rasterizer) {
                     const auto cmd_address = reinterpret_cast<const void*>(header);
+                    const CpStatsScope stats_scope{cp_stats.draws, cp_stats.rasterizer_ns};
                     rasterizer->ScopeMarkerBegin(
                         fmt::format("gfx:{}:DrawIndexIndirectMulti", cmd_address));
                     rasterizer->DrawIndirect(true, indirect_args_addr, offset,
@@ -525,6 +604,7 @@ Liverpool::Task Liverpool::ProcessGraphics(std::span<const u32> dcb, std::span<c
                 }
                 if (rasterizer) {
                     const auto cmd_address = reinterpret_cast<const void*>(header);
+                    const CpStatsScope stats_scope{cp_stats.draws, cp_stats.rasterizer_ns};
                     rasterizer->ScopeMarkerBegin(
                         fmt::format("gfx:{}:DrawIndexIndirectCountMulti", cmd_address));
                     rasterizer->DrawIndirect(true, indirect_args_addr, offset,
@@ -550,6 +630,7 @@ Liverpool::Task Liverpool::ProcessGraphics(std::span<const u32> dcb, std::span<c
                 }
                 if (rasterizer && (cs_program.dispatch_initiator & 1)) {
                     const auto cmd_address = reinterpret_cast<const void*>(header);
+                    const CpStatsScope stats_scope{cp_stats.dispatches, cp_stats.rasterizer_ns};
                     rasterizer->ScopeMarkerBegin(fmt::format("gfx:{}:DispatchDirect", cmd_address));
                     rasterizer->DispatchDirect();
                     rasterizer->ScopeMarkerEnd();
@@ -568,6 +649,7 @@ Liverpool::Task Liverpool::ProcessGraphics(std::span<const u32> dcb, std::span<c
                 }
                 if (rasterizer && (cs_program.dispatch_initiator & 1)) {
                     const auto cmd_address = reinterpret_cast<const void*>(header);
+                    const CpStatsScope stats_scope{cp_stats.dispatches, cp_stats.rasterizer_ns};
                     rasterizer->ScopeMarkerBegin(
                         fmt::format("gfx:{}:DispatchIndirect", cmd_address));
                     rasterizer->DispatchIndirect(indirect_args_addr, offset, size);
@@ -621,11 +703,12 @@ Liverpool::Task Liverpool::ProcessGraphics(std::span<const u32> dcb, std::span<c
             }
             case PM4ItOpcode::EventWriteEos: {
                 const auto* event_eos = reinterpret_cast<const PM4CmdEventWriteEos*>(header);
-                event_eos->SignalFence([](void* address, u64 data, u32 num_bytes) {
+                event_eos->SignalFence([this](void* address, u64 data, u32 num_bytes) {
                     auto* memory = Core::Memory::Instance();
                     if (!memory->TryWriteBacking(address, &data, num_bytes)) {
                         memcpy(address, &data, num_bytes);
                     }
+                    wait_registry.NotifyWrite(reinterpret_cast<VAddr>(address), num_bytes);
                 });
                 if (event_eos->command == PM4CmdEventWriteEos::Command::GdsStore) {
                     ASSERT(event_eos->size == 1);
@@ -640,11 +723,12 @@ Liverpool::Task Liverpool::ProcessGraphics(std::span<const u32> dcb, std::span<c
             case PM4ItOpcode::EventWriteEop: {
                 const auto* event_eop = reinterpret_cast<const PM4CmdEventWriteEop*>(header);
                 event_eop->SignalFence(
-                    [](void* address, u64 data, u32 num_bytes) {
+                    [this](void* address, u64 data, u32 num_bytes) {
                         auto* memory = Core::Memory::Instance();
                         if (!memory->TryWriteBacking(address, &data, num_bytes)) {
                             memcpy(address, &data, num_bytes);
                         }
+                        wait_registry.NotifyWrite(reinterpret_cast<VAddr>(address), num_bytes);
                     },
                     [] { Platform::IrqC::Instance()->Signal(Platform::InterruptId::GfxEop); });
                 break;
@@ -654,6 +738,7 @@ Liverpool::Task Liverpool::ProcessGraphics(std::span<const u32> dcb, std::span<c
                 if (dma_data->dst_addr_lo == 0x3022C || !rasterizer) {
                     break;
                 }
+                const CpStatsScope stats_scope{cp_stats.dma_transfers, cp_stats.rasterizer_ns};
                 if (dma_data->src_sel == DmaDataSrc::Data && dma_data->dst_sel == DmaDataDst::Gds) {
                     rasterizer->FillBuffer(dma_data->dst_addr_lo, dma_data->NumBytes(),
                                            dma_data->data, true);
@@ -692,6 +777,7 @@ Liverpool::Task Liverpool::ProcessGraphics(std::span<const u32> dcb, std::span<c
                 u64* address = write_data->Address<u64*>();
                 if (!write_data->wr_one_addr.Value()) {
                     std::memcpy(address, write_data->data, data_size);
+                    wait_registry.NotifyWrite(reinterpret_cast<VAddr>(address), data_size);
                 } else {
                     UNREACHABLE();
                 }
@@ -747,6 +833,8 @@ Liverpool::Task Liverpool::ProcessGraphics(std::span<const u32> dcb, std::span<c
                     break;
                 }
                 while (!wait_reg_mem->Test(regs.reg_array)) {
+                    ++cp_stats.wait_reg_mem_yields;
+                    wait_registry.Block(GfxQueueId, *wait_reg_mem);
                     YIELD_GFX();
                 }
                 break;
@@ -874,6 +962,8 @@ Liverpool::Task Liverpool::ProcessCompute(std::span<const u32> acb, u32 vqid) {
         }
 
         const PM4ItOpcode opcode = header->type3.opcode;
+        ++cp_stats.packets[static_cast<u8>(opcode)];
+        ++cp_stats.num_packets;
         const auto* it_body = reinterpret_cast<const u32*>(header) + 1;
         switch (opcode) {
         case PM4ItOpcode::Nop: {
@@ -897,6 +987,7 @@ Liverpool::Task Liverpool::ProcessCompute(std::span<const u32> acb, u32 vqid) {
             if (dma_data->dst_addr_lo == 0x3022C || !rasterizer) {
                 break;
             }
+            const CpStatsScope stats_scope{cp_stats.dma_transfers, cp_stats.rasterizer_ns};
             if (dma_data->src_sel == DmaDataSrc::Data && dma_data->dst_sel == DmaDataDst::Gds) {
                 rasterizer->FillBuffer(dma_data->dst_addr_lo, dma_data->NumBytes(), dma_data->data,
                                        true);
@@ -975,6 +1066,7 @@ Liverpool::Task Liverpool::ProcessCompute(std::span<const u32> acb, u32 vqid) {
             }
             if (rasterizer && (cs_program.dispatch_initiator & 1)) {
                 const auto cmd_address = reinterpret_cast<const void*>(header);
+                const CpStatsScope stats_scope{cp_stats.dispatches, cp_stats.rasterizer_ns};
                 rasterizer->ScopeMarkerBegin(
                     fmt::format("asc[{}]:{}:DispatchDirect", vqid, cmd_address));
                 rasterizer->DispatchDirect();
@@ -994,6 +1086,7 @@ Liverpool::Task Liverpool::ProcessCompute(std::span<const u32> acb, u32 vqid) {
             }
             if (rasterizer && (cs_program.dispatch_initiator & 1)) {
                 const auto cmd_address = reinterpret_cast<const void*>(header);
+                const CpStatsScope stats_scope{cp_stats.dispatches, cp_stats.rasterizer_ns};
                 rasterizer->ScopeMarkerBegin(
                     fmt::format("asc[{}]:{}:DispatchIndirect", vqid, cmd_address));
                 rasterizer->DispatchIndirect(ib_address, 0, size);
@@ -1007,6 +1100,7 @@ Liverpool::Task Liverpool::ProcessCompute(std::span<const u32> acb, u32 vqid) {
             const u32 data_size = (header->type3.count.Value() - 2) * 4;
             if (!write_data->wr_one_addr.Value()) {
                 std::memcpy(write_data->Address<void*>(), write_data->data, data_size);
+                wait_registry.NotifyWrite(write_data->Address<VAddr>(), data_size);
             } else {
                 UNREACHABLE();
             }
@@ -1028,6 +1122,8 @@ Liverpool::Task Liverpool::ProcessCompute(std::span<const u32> acb, u32 vqid) {
             const auto* wait_reg_mem = reinterpret_cast<const PM4CmdWaitRegMem*>(header);
             ASSERT(wait_reg_mem->engine.Value() == PM4CmdWaitRegMem::Engine::Me);
             while (!wait_reg_mem->Test(regs.reg_array)) {
+                ++cp_stats.wait_reg_mem_yields;
+                wait_registry.Block(vqid + 1, *wait_reg_mem);
                 YIELD_ASC(vqid);
             }
             break;
@@ -1037,6 +1133,8 @@ Liverpool::Task Liverpool::ProcessCompute(std::span<const u32> acb, u32 vqid) {
             release_mem->SignalFence([pipe_id = queue.pipe_id] {
                 Platform::IrqC::Instance()->Signal(static_cast<Platform::InterruptId>(pipe_id));
             });
+            wait_registry.NotifyWrite(reinterpret_cast<VAddr>(release_mem->Address<u64>()),
+                                      sizeof(u64));
             break;
         }
         case PM4ItOpcode::EventWrite: {
@@ -1061,32 +1159,29 @@ Liverpool::Task Liverpool::ProcessCompute(std::span<const u32> acb, u32 vqid) {
 
 Liverpool::CmdBuffer Liverpool::CopyCmdBuffers(std::span<const u32> dcb, std::span<const u32> ccb) {
     auto& queue = mapped_queues[GfxQueueId];
-    ASSERT_MSG(queue.dcb_buffer.capacity() >= queue.dcb_buffer_offset + dcb.size(),
+    auto& copy_buffer = queue.copy_buffers[queue.copy_buffer_index];
+    ASSERT_MSG(copy_buffer.dcb.capacity() >= copy_buffer.dcb_offset + dcb.size(),
                "dcb copy buffer out of reserved space");
-    ASSERT_MSG(queue.ccb_buffer.capacity() >= queue.ccb_buffer_offset + ccb.size(),
+    ASSERT_MSG(copy_buffer.ccb.capacity() >= copy_buffer.ccb_offset + ccb.size(),
                "ccb copy buffer out of reserved space");
 
-    queue.dcb_buffer.resize(
-        std::max(queue.dcb_buffer.size(), queue.dcb_buffer_offset + dcb.size()));
-    queue.ccb_buffer.resize(
-        std::max(queue.ccb_buffer.size(), queue.ccb_buffer_offset + ccb.size()));
+    copy_buffer.dcb.resize(std::max(copy_buffer.dcb.size(), copy_buffer.dcb_offset + dcb.size()));
+    copy_buffer.ccb.resize(std::max(copy_buffer.ccb.size(), copy_buffer.ccb_offset + ccb.size()));
 
-    const u32 prev_dcb_buffer_offset = queue.dcb_buffer_offset;
-    const u32 prev_ccb_buffer_offset = queue.ccb_buffer_offset;
+    const u32 prev_dcb_buffer_offset = copy_buffer.dcb_offset;
+    const u32 prev_ccb_buffer_offset = copy_buffer.ccb_offset;
     if (!dcb.empty()) {
-        std::memcpy(queue.dcb_buffer.data() + queue.dcb_buffer_offset, dcb.data(),
-                    dcb.size_bytes());
-        queue.dcb_buffer_offset += dcb.size();
-        dcb = std::span<const u32>{queue.dcb_buffer.begin() + prev_dcb_buffer_offset,
-                                   queue.dcb_buffer.begin() + queue.dcb_buffer_offset};
+        std::memcpy(copy_buffer.dcb.data() + copy_buffer.dcb_offset, dcb.data(), dcb.size_bytes());
+        copy_buffer.dcb_offset += dcb.size();
+        dcb = std::span<const u32>{copy_buffer.dcb.begin() + prev_dcb_buffer_offset,
+                                   copy_buffer.dcb.begin() + copy_buffer.dcb_offset};
     }
 
     if (!ccb.empty()) {
-        std::memcpy(queue.ccb_buffer.data() + queue.ccb_buffer_offset, ccb.data(),
-                    ccb.size_bytes());
-        queue.ccb_buffer_offset += ccb.size();
-        ccb = std::span<const u32>{queue.ccb_buffer.begin() + prev_ccb_buffer_offset,
-                                   queue.ccb_buffer.begin() + queue.ccb_buffer_offset};
+        std::memcpy(copy_buffer.ccb.data() + copy_buffer.ccb_offset, ccb.data(), ccb.size_bytes());
+        copy_buffer.ccb_offset += ccb.size();
+        ccb = std::span<const u32>{copy_buffer.ccb.begin() + prev_ccb_buffer_offset,
+                                   copy_buffer.ccb.begin() + copy_buffer.ccb_offset};
     }
 
     return std::make_pair(dcb, ccb);
@@ -1110,6 +1205,38 @@ void Liverpool::SubmitGfx(std::span<const u32> dcb, std::span<const u32> ccb) {
     submit_cv.notify_one();
 }
 
+u64 Liverpool::SubmitDone() noexcept {
+    auto& queue = mapped_queues[GfxQueueId];
+    const u64 fence = ++frames_queued;
+
+    ComputeFences compute_fences{};
+    for (u32 i = 0; i < NumComputeRings; ++i) {
+        auto& compute_queue = mapped_queues[i + 1];
+        std::scoped_lock lock{compute_queue.m_access};
+        compute_fences[i] = compute_queue.num_queued;
+    }
+
+    auto task = ProcessFrameEnd(fence, compute_fences);
+    {
+        std::scoped_lock lock{queue.m_access};
+        queue.submits.emplace(task.handle);
+
+        // The next frame records into its own copy buffers. The caller guarantees that the frame
+        // which previously used this slot has completed before anything is copied into it.
+        if (!queue.copy_buffers.empty()) {
+            queue.copy_buffer_index = fence % queue.copy_buffers.size();
+            auto& copy_buffer = queue.copy_buffers[queue.copy_buffer_index];
+            copy_buffer.dcb_offset = 0;
+            copy_buffer.ccb_offset = 0;
+        }
+    }
+
+    std::scoped_lock lk{submit_mutex};
+    ++num_submits;
+    submit_cv.notify_one();
+    return fence;
+}
+
 void Liverpool::SubmitAsc(u32 gnm_vqid, std::span<const u32> acb) {
     ASSERT_MSG(gnm_vqid > 0 && gnm_vqid < NumTotalQueues, "Invalid virtual ASC queue index");
     auto& queue = mapped_queues[gnm_vqid];
@@ -1119,6 +1246,7 @@ void Liverpool::SubmitAsc(u32 gnm_vqid, std::span<const u32> acb) {
     {
         std::scoped_lock lock{queue.m_access};
         queue.submits.emplace(task.handle);
+        ++queue.num_queued;
     }
 
     std::scoped_lock lk{submit_mutex};
@@ -18,7 +18,9 @@
 #include "common/types.h"
 #include "common/unique_function.h"
 #include "video_core/amdgpu/cb_db_extent.h"
+#include "video_core/amdgpu/cp_stats.h"
 #include "video_core/amdgpu/regs.h"
+#include "video_core/amdgpu/wait_registry.h"
 
 namespace Vulkan {
 class Rasterizer;
@@ -38,6 +40,7 @@ struct Liverpool {
     static constexpr u32 NumComputeRings = NumComputePipes * NumQueuesPerPipe;
     static constexpr u32 NumTotalQueues = NumGfxRings + NumComputeRings;
     static_assert(NumTotalQueues < 64u); // need to fit into u64 bitmap for ffs
+    static_assert(NumTotalQueues <= WaitRegistry::MaxQueues);
 
     enum ContextRegs : u32 {
         DbZInfo = 0xA010,
@@ -70,12 +73,18 @@ public:
     void SubmitGfx(std::span<const u32> dcb, std::span<const u32> ccb);
     void SubmitAsc(u32 gnm_vqid, std::span<const u32> acb);
 
-    void SubmitDone() noexcept {
-        std::scoped_lock lk{submit_mutex};
-        mapped_queues[GfxQueueId].ccb_buffer_offset = 0;
-        mapped_queues[GfxQueueId].dcb_buffer_offset = 0;
-        submit_done = true;
-        submit_cv.notify_one();
+    /// Closes the current frame by queueing a frame end marker behind its graphics submissions.
+    /// Returns the fence value that is reached once the GPU has consumed the frame.
+    u64 SubmitDone() noexcept;
+
+    /// Blocks until the GPU has consumed every frame up to and including the given fence.
+    void WaitFrameFence(u64 fence) noexcept {
+        std::unique_lock lk{frame_mutex};
+        frame_cv.wait(lk, [this, fence] { return frames_completed >= fence; });
+    }
+
+    [[nodiscard]] u64 CompletedFrameFence() const noexcept {
+        return frames_completed.load(std::memory_order_acquire);
     }
 
     void WaitGpuIdle() noexcept {
@@ -87,6 +96,22 @@ public:
         return num_submits == 0;
     }
 
+    /// Wakes queues blocked on a WaitRegMem condition that polls memory in the written range.
+    /// Called for writes done outside of the command processor. Must not be called from signal
+    /// context, use MarkMemoryWritten there.
+    void NotifyMemoryWrite(VAddr addr, u64 size) {
+        if (wait_registry.NotifyWrite(addr, size)) {
+            std::scoped_lock lk{submit_mutex};
+            submit_cv.notify_one();
+        }
+    }
+
+    /// Same as NotifyMemoryWrite, but only updates atomics so it is safe from the fault handler.
+    /// A sleeping command processor picks the wake up within WaitRegistry::PollTimeout.
+    void MarkMemoryWritten(VAddr addr, u64 size) {
+        wait_registry.NotifyWrite(addr, size);
+    }
+
     void SetVoPort(Libraries::VideoOut::VideoOutPort* port) {
         vo_port = port;
     }
@@ -120,12 +145,17 @@ public:
         }
     }
 
-    void ReserveCopyBufferSpace() {
+    void ReserveCopyBufferSpace(u32 num_frames) {
         GpuQueue& gfx_queue = mapped_queues[GfxQueueId];
         std::scoped_lock lk(gfx_queue.m_access);
         constexpr size_t GfxReservedSize = 2_MB >> 2;
-        gfx_queue.ccb_buffer.reserve(GfxReservedSize);
-        gfx_queue.dcb_buffer.reserve(GfxReservedSize);
+        // Every frame in flight owns a copy buffer pair, so a frame being recorded by the guest
+        // never overwrites the commands of a frame the GPU thread is still processing.
+        gfx_queue.copy_buffers.resize(num_frames);
+        for (auto& copy_buffer : gfx_queue.copy_buffers) {
+            copy_buffer.ccb.reserve(GfxReservedSize);
+            copy_buffer.dcb.reserve(GfxReservedSize);
+        }
     }
 
     inline ComputeProgram& GetCsRegs() {
@@ -180,19 +210,29 @@ private:
     CmdBuffer CopyCmdBuffers(std::span<const u32> dcb, std::span<const u32> ccb);
     Task ProcessGraphics(std::span<const u32> dcb, std::span<const u32> ccb);
     Task ProcessCeUpdate(std::span<const u32> ccb);
+    using ComputeFences = std::array<u64, NumComputeRings>;
+    Task ProcessFrameEnd(u64 fence, ComputeFences compute_fences);
     template <bool is_indirect = false>
     Task ProcessCompute(std::span<const u32> acb, u32 vqid);
 
     void ProcessCommands();
+    void WaitQueueWake(WaitRegistry::Clock::time_point deadline, u32 wake_seq, u32 submits);
     void Process(std::stop_token stoken);
 
+    struct CmdCopyBuffer {
+        u32 dcb_offset{};
+        u32 ccb_offset{};
+        std::vector<u32> dcb;
+        std::vector<u32> ccb;
+    };
+
     struct GpuQueue {
         std::mutex m_access{};
-        std::atomic<u32> dcb_buffer_offset;
-        std::atomic<u32> ccb_buffer_offset;
-        std::vector<u32> dcb_buffer;
-        std::vector<u32> ccb_buffer;
+        std::vector<CmdCopyBuffer> copy_buffers;
+        u32 copy_buffer_index{};
         std::queue<Task::Handle> submits{};
+        u64 num_queued{};    ///< Guarded by m_access
+        u64 num_completed{}; ///< Only touched by the GPU thread
         ComputeProgram cs_state{};
     };
     std::array<GpuQueue, NumTotalQueues> mapped_queues{};
@@ -225,12 +265,18 @@ private:
     std::jthread process_thread{};
     std::atomic<u32> num_submits{};
     std::atomic<u32> num_commands{};
-    std::atomic<bool> submit_done{};
     std::mutex submit_mutex;
     std::condition_variable_any submit_cv;
+    u64 frames_queued{};
+    std::atomic<u64> frames_completed{};
+    std::mutex frame_mutex;
+    std::condition_variable frame_cv;
     std::queue<Common::UniqueFunction<void>> command_queue{};
     std::thread::id gpu_id;
     s32 curr_qid{-1};
+    bool queue_stalled{}; ///< Set by a task that yielded without making progress
+    WaitRegistry wait_registry{};
+    CpFrameStats cp_stats{}; // Only touched by the GPU thread
 };
 
 } // namespace AmdGpu
@@ -0,0 +1,65 @@
+// SPDX-FileCopyrightText: Copyright 2025 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <bit>
+#include <span>
+
+#include "common/assert.h"
+#include "video_core/amdgpu/pm4_cmds.h"
+#include "video_core/amdgpu/wait_registry.h"
+
+namespace AmdGpu {
+
+void WaitRegistry::Block(u32 qid, const PM4CmdWaitRegMem& wait) {
+    ASSERT(qid < MaxQueues);
+    const bool is_memory = wait.mem_space.Value() == PM4CmdWaitRegMem::MemSpace::Memory;
+    poll_addrs[qid].store(is_memory ? wait.Address<VAddr>() : 0, std::memory_order_relaxed);
+    deadlines[qid] = Clock::now() + PollTimeout;
+    blocked_mask.fetch_or(1ULL << qid, std::memory_order_release);
+}
+
+bool WaitRegistry::NotifyWrite(VAddr addr, u64 size) {
+    u64 mask = blocked_mask.load(std::memory_order_acquire);
+    u64 woken = 0;
+    while (mask) {
+        const u32 qid = std::countr_zero(mask);
+        mask &= mask - 1;
+        const VAddr poll_addr = poll_addrs[qid].load(std::memory_order_relaxed);
+        if (poll_addr != 0 && poll_addr < addr + size && addr < poll_addr + sizeof(u32)) {
+            woken |= 1ULL << qid;
+        }
+    }
+    if (!woken) {
+        return false;
+    }
+    Wake(woken);
+    return true;
+}
+
+WaitRegistry::Clock::time_point WaitRegistry::Expire(Clock::time_point now) {
+    auto next = Clock::time_point::max();
+    u64 mask = blocked_mask.load(std::memory_order_acquire);
+    u64 expired = 0;
+    while (mask) {
+        const u32 qid = std::countr_zero(mask);
+        mask &= mask - 1;
+        if (deadlines[qid] <= now) {
+            expired |= 1ULL << qid;
+        } else {
+            next = std::min(next, deadlines[qid]);
+        }
+    }
+    if (expired) {
+        Wake(expired);
+    }
+    return next;
+}
+
+void WaitRegistry::Wake(u64 bits) {
+    if (blocked_mask.fetch_and(~bits, std::memory_order_acq_rel) & bits) {
+        wake_seq.fetch_add(1, std::memory_order_release);
+    }
+}
+
+} // namespace AmdGpu
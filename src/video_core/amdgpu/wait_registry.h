@@ -0,0 +1,62 @@
+// SPDX-FileCopyrightText: Copyright 2025 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+
+#include "common/types.h"
+
+namespace AmdGpu {
+
+struct PM4CmdWaitRegMem;
+
+/// Tracks command queues that are blocked on a WaitRegMem condition. The scheduler loop skips
+/// blocked queues until a write overlaps the polled address or the poll timeout elapses, instead
+/// of resuming them on every pass to test the condition again.
+class WaitRegistry {
+public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr u32 MaxQueues = 64;
+
+    /// Guest CPU writes are only observed on GPU tracked pages, so a blocked queue re-tests its
+    /// condition at least this often. This also bounds the latency of a lost wake up.
+    static constexpr std::chrono::microseconds PollTimeout{200};
+
+    /// Marks the queue as blocked on the packet condition. Only called from the GPU thread.
+    void Block(u32 qid, const PM4CmdWaitRegMem& wait);
+
+    /// Wakes the queues polling an address within the written range. Only uses lock-free atomics,
+    /// so it is safe from any thread and from signal handlers. Returns true if a queue was woken.
+    bool NotifyWrite(VAddr addr, u64 size);
+
+    /// Wakes the queues whose poll timeout elapsed and returns the earliest remaining deadline,
+    /// or Clock::time_point::max() if no queue is blocked. Only called from the GPU thread.
+    Clock::time_point Expire(Clock::time_point now);
+
+    [[nodiscard]] bool IsBlocked(u32 qid) const {
+        return (blocked_mask.load(std::memory_order_acquire) >> qid) & 1;
+    }
+
+    [[nodiscard]] bool HasBlocked() const {
+        return blocked_mask.load(std::memory_order_acquire) != 0;
+    }
+
+    /// Incremented whenever a blocked queue is woken, so the scheduler can tell whether anything
+    /// became runnable while it was deciding to sleep.
+    [[nodiscard]] u32 WakeSequence() const {
+        return wake_seq.load(std::memory_order_acquire);
+    }
+
+private:
+    void Wake(u64 bits);
+
+    std::array<std::atomic<VAddr>, MaxQueues> poll_addrs{}; ///< Zero for register waits
+    std::array<Clock::time_point, MaxQueues> deadlines{};
+    std::atomic<u64> blocked_mask{};
+    std::atomic<u32> wake_seq{};
+};
+
+} // namespace AmdGpu
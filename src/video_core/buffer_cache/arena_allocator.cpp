@@ -0,0 +1,184 @@
+// SPDX-FileCopyrightText: Copyright 2025 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <iterator>
+
+#include "common/alignment.h"
+#include "common/assert.h"
+#include "video_core/buffer_cache/arena_allocator.h"
+
+namespace VideoCore {
+
+ArenaAllocator::ArenaAllocator(u64 block_size_, u64 granularity_)
+    : block_size{block_size_}, granularity{granularity_} {
+    ASSERT(granularity != 0 && block_size % granularity == 0);
+}
+
+ArenaAllocator::~ArenaAllocator() = default;
+
+std::optional<ArenaAllocator::Allocation> ArenaAllocator::Allocate(u64 size) {
+    size = Common::AlignUp(size, granularity);
+    if (size == 0 || size > block_size) {
+        return std::nullopt;
+    }
+    u32 best_block = NoBlock;
+    std::map<u64, u64>::iterator best_range;
+    for (u32 index = 0; index < blocks.size(); index++) {
+        Block& block = blocks[index];
+        if (!block.live || index == draining_block || block_size - block.used < size) {
+            continue;
+        }
+        for (auto it = block.free_ranges.begin(); it != block.free_ranges.end(); ++it) {
+            if (it->second < size) {
+                continue;
+            }
+            if (best_block == NoBlock || it->second < best_range->second) {
+                best_block = index;
+                best_range = it;
+            }
+            if (it->second == size) {
+                break;
+            }
+        }
+        if (best_block != NoBlock && best_range->second == size) {
+            break;
+        }
+    }
+    if (best_block == NoBlock) {
+        return std::nullopt;
+    }
+
+    Block& block = blocks[best_block];
+    const u64 offset = best_range->first;
+    const u64 remaining = best_range->second - size;
+    block.free_ranges.erase(best_range);
+    if (remaining != 0) {
+        block.free_ranges.emplace(offset + size, remaining);
+    }
+    block.used += size;
+    ++block.num_allocations;
+    ++total_allocations;
+    return Allocation{
+        .block = best_block,
+        .offset = offset,
+        .size = size,
+    };
+}
+
+void ArenaAllocator::Free(const Allocation& allocation) {
+    ASSERT(allocation.block < blocks.size() && blocks[allocation.block].live);
+    Block& block = blocks[allocation.block];
+    u64 offset = allocation.offset;
+    u64 size = allocation.size;
+
+    // Merge with the free neighbours on both sides.
+    auto next = block.free_ranges.lower_bound(offset);
+    ASSERT_MSG(next == block.free_ranges.end() || next->first >= offset + size,
+               "Arena range {:#x}:{:#x} freed twice", offset, size);
+    if (next != block.free_ranges.begin()) {
+        const auto prev = std::prev(next);
+        ASSERT_MSG(prev->first + prev->second <= offset, "Arena range {:#x}:{:#x} freed twice",
+                   offset, size);
+        if (prev->first + prev->second == offset) {
+            offset = prev->first;
+            size += prev->second;
+            block.free_ranges.erase(prev);
+        }
+    }
+    if (next != block.free_ranges.end() && next->first == offset + size) {
+        size += next->second;
+        block.free_ranges.erase(next);
+    }
+    block.free_ranges.emplace(offset, size);
+
+    block.used -= allocation.size;
+    --block.num_allocations;
+    ++total_frees;
+}
+
+u32 ArenaAllocator::AddBlock() {
+    // Running out of room means the other blocks cannot absorb the draining one.
+    draining_block = NoBlock;
+    const auto it = std::ranges::find_if(blocks, [](const Block& block) { return !block.live; });
+    const u32 index = static_cast<u32>(std::distance(blocks.begin(), it));
+    if (it == blocks.end()) {
+        blocks.emplace_back();
+    }
+    Block& block = blocks[index];
+    block.free_ranges.clear();
+    block.free_ranges.emplace(0, block_size);
+    block.used = 0;
+    block.num_allocations = 0;
+    block.live = true;
+    ++blocks_created;
+    return index;
+}
+
+std::optional<u32> ArenaAllocator::UpdateDrainingBlock(double max_usage) {
+    if (draining_block != NoBlock) {
+        return draining_block;
+    }
+    u32 num_live = 0;
+    u32 candidate = NoBlock;
+    u64 total_used = 0;
+    for (u32 index = 0; index < blocks.size(); index++) {
+        const Block& block = blocks[index];
+        if (!block.live) {
+            continue;
+        }
+        ++num_live;
+        total_used += block.used;
+        if (block.used == 0) {
+            continue;
+        }
+        if (candidate == NoBlock || block.used < blocks[candidate].used) {
+            candidate = index;
+        }
+    }
+    if (num_live < 2 || candidate == NoBlock ||
+        static_cast<double>(blocks[candidate].used) > max_usage * static_cast<double>(block_size)) {
+        return std::nullopt;
+    }
+    // The remaining blocks need enough free space for everything in the candidate.
+    const u64 free_elsewhere = (num_live - 1) * block_size - (total_used - blocks[candidate].used);
+    if (free_elsewhere < blocks[candidate].used) {
+        return std::nullopt;
+    }
+    draining_block = candidate;
+    return draining_block;
+}
+
+ArenaAllocator::Stats ArenaAllocator::GetStats() const {
+    Stats stats{
+        .total_allocations = total_allocations,
+        .total_frees = total_frees,
+        .blocks_created = blocks_created,
+        .blocks_released = blocks_released,
+    };
+    for (const Block& block : blocks) {
+        if (!block.live) {
+            continue;
+        }
+        ++stats.num_blocks;
+        stats.reserved_bytes += block_size;
+        stats.used_bytes += block.used;
+        stats.num_allocations += block.num_allocations;
+        for (const auto& [offset, size] : block.free_ranges) {
+            stats.largest_free_range = std::max(stats.largest_free_range, size);
+        }
+    }
+    return stats;
+}
+
+void ArenaAllocator::ReleaseBlock(u32 index) {
+    Block& block = blocks[index];
+    block.free_ranges.clear();
+    block.live = false;
+    if (index == draining_block) {
+        draining_block = NoBlock;
+    }
+    ++blocks_released;
+}
+
+} // namespace VideoCore
@@ -0,0 +1,115 @@
+// SPDX-FileCopyrightText: Copyright 2025 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <map>
+#include <optional>
+#include <vector>
+
+#include "common/types.h"
+
+namespace VideoCore {
+
+/**
+ * Bookkeeping of ranges carved out of a set of equally sized blocks. It knows nothing about the
+ * device: the owner backs every block index returned by AddBlock with memory and releases it when
+ * ReleaseEmptyBlocks reports it.
+ */
+class ArenaAllocator {
+public:
+    struct Allocation {
+        u32 block;
+        u64 offset;
+        u64 size;
+    };
+
+    struct Stats {
+        u64 num_blocks;
+        u64 reserved_bytes;
+        u64 used_bytes;
+        u64 num_allocations;
+        u64 largest_free_range;
+        u64 total_allocations;
+        u64 total_frees;
+        u64 blocks_created;
+        u64 blocks_released;
+    };
+
+    explicit ArenaAllocator(u64 block_size, u64 granularity);
+    ~ArenaAllocator();
+
+    /// Returns the size of every block.
+    [[nodiscard]] u64 BlockSize() const noexcept {
+        return block_size;
+    }
+
+    /// Returns the size every range is rounded up to.
+    [[nodiscard]] u64 Granularity() const noexcept {
+        return granularity;
+    }
+
+    /// Carves a range from the live block with the tightest fit, skipping the draining block.
+    /// Returns std::nullopt when no block has room and a new one has to be added.
+    [[nodiscard]] std::optional<Allocation> Allocate(u64 size);
+
+    /// Returns a range to its block.
+    void Free(const Allocation& allocation);
+
+    /// Adds an empty block and returns its index. Indices of released blocks are reused. Stops
+    /// draining, as the other blocks are out of room.
+    u32 AddBlock();
+
+    /// Forgets every empty block but the first one, calling func with the index of each.
+    template <typename Func>
+    void ReleaseEmptyBlocks(Func&& func) {
+        bool kept_one = false;
+        for (u32 index = 0; index < blocks.size(); index++) {
+            Block& block = blocks[index];
+            if (!block.live || block.used != 0) {
+                continue;
+            }
+            if (!kept_one && index != draining_block) {
+                kept_one = true;
+                continue;
+            }
+            ReleaseBlock(index);
+            func(index);
+        }
+    }
+
+    /// Picks the least used block to be emptied when its usage is below the threshold and the
+    /// other live blocks have room for its ranges. Returns the draining block, if any.
+    std::optional<u32> UpdateDrainingBlock(double max_usage);
+
+    /// Returns true if allocations from the block should be moved elsewhere.
+    [[nodiscard]] bool IsDraining(u32 block) const noexcept {
+        return block == draining_block;
+    }
+
+    /// Returns a snapshot of the allocator statistics.
+    [[nodiscard]] Stats GetStats() const;
+
+private:
+    static constexpr u32 NoBlock = ~0U;
+
+    struct Block {
+        std::map<u64, u64> free_ranges; ///< Offset to size, coalesced
+        u64 used{};
+        u32 num_allocations{};
+        bool live{};
+    };
+
+    void ReleaseBlock(u32 index);
+
+    u64 block_size;
+    u64 granularity;
+    std::vector<Block> blocks;
+    u32 draining_block = NoBlock;
+    u64 total_allocations{};
+    u64 total_frees{};
+    u64 blocks_created{};
+    u64 blocks_released{};
+};
+
+} // namespace VideoCore
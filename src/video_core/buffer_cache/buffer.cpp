@@ -63,7 +63,10 @@ UniqueBuffer::UniqueBuffer(vk::Device device_, VmaAllocator allocator_)
     : device{device_}, allocator{allocator_} {}
 
 UniqueBuffer::~UniqueBuffer() {
-    if (buffer) {
+    if (buffer && arena) {
+        device.destroyBuffer(buffer);
+        arena->Free(arena_range);
+    } else if (buffer) {
         vmaDestroyBuffer(allocator, buffer, allocation);
     }
 }
@@ -100,6 +103,33 @@ void UniqueBuffer::Create(const vk::BufferCreateInfo& buffer_ci, MemoryUsage usa
     }
 }
 
+void UniqueBuffer::CreateInArena(const vk::BufferCreateInfo& buffer_ci, BufferArena& arena_) {
+    ASSERT_MSG(buffer_ci.usage == arena_.Flags(), "Buffer usage does not match the arena");
+    const auto range = arena_.Allocate(buffer_ci.size);
+
+    const VkBufferCreateInfo buffer_ci_unsafe = static_cast<VkBufferCreateInfo>(buffer_ci);
+    VkBuffer unsafe_buffer{};
+    VkResult result = vmaCreateAliasingBuffer2(allocator, arena_.BlockAllocation(range.block),
+                                               range.offset, &buffer_ci_unsafe, &unsafe_buffer);
+    if (result != VK_SUCCESS) {
+        arena_.Free(range);
+    }
+    ASSERT_MSG(result == VK_SUCCESS, "Failed creating arena buffer with error {}",
+               vk::to_string(vk::Result{result}));
+    buffer = vk::Buffer{unsafe_buffer};
+    arena = &arena_;
+    arena_range = range;
+
+    if (buffer_ci.usage & vk::BufferUsageFlagBits::eShaderDeviceAddress) {
+        vk::BufferDeviceAddressInfo bda_info{
+            .buffer = buffer,
+        };
+        auto bda_result = device.getBufferAddress(bda_info);
+        ASSERT_MSG(bda_result != 0, "Failed to get buffer device address");
+        bda_addr = bda_result;
+    }
+}
+
 Buffer::Buffer(const Vulkan::Instance& instance_, Vulkan::Scheduler& scheduler_, MemoryUsage usage_,
                VAddr cpu_addr_, vk::BufferUsageFlags flags, u64 size_bytes_)
     : cpu_addr{cpu_addr_}, size_bytes{size_bytes_}, instance{&instance_}, scheduler{&scheduler_},
@@ -124,6 +154,23 @@ Buffer::Buffer(const Vulkan::Instance& instance_, Vulkan::Scheduler& scheduler_,
     is_coherent = property_flags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
 }
 
+Buffer::Buffer(const Vulkan::Instance& instance_, Vulkan::Scheduler& scheduler_,
+               BufferArena& arena, VAddr cpu_addr_, vk::BufferUsageFlags flags, u64 size_bytes_)
+    : cpu_addr{cpu_addr_}, size_bytes{size_bytes_}, instance{&instance_}, scheduler{&scheduler_},
+      usage{MemoryUsage::DeviceLocal}, buffer{instance->GetDevice(), instance->GetAllocator()} {
+    const vk::BufferCreateInfo buffer_ci = {
+        .size = size_bytes,
+        .usage = flags,
+    };
+    if (BufferArena::Fits(size_bytes)) {
+        buffer.CreateInArena(buffer_ci, arena);
+    } else {
+        buffer.Create(buffer_ci, usage, nullptr);
+    }
+    Vulkan::SetObjectName(instance->GetDevice(), Handle(), "Buffer {:#x}:{:#x}", cpu_addr,
+                          size_bytes);
+}
+
 void Buffer::Fill(u64 offset, u32 num_bytes, u32 value) {
     scheduler->EndRendering();
     ASSERT_MSG(offset % 4 == 0 && num_bytes % 4 == 0,
@@ -255,4 +302,59 @@ bool StreamBuffer::WaitPendingOperations(u64 requested_upper_bound, bool allow_w
     return true;
 }
 
+BufferArena::BufferArena(const Vulkan::Instance& instance_, vk::BufferUsageFlags flags_,
+                         u64 granularity)
+    : instance{instance_}, flags{flags_}, allocator{BlockSize, granularity} {}
+
+BufferArena::~BufferArena() = default;
+
+ArenaAllocator::Allocation BufferArena::Allocate(u64 size) {
+    std::scoped_lock lk{mutex};
+    if (const auto range = allocator.Allocate(size)) {
+        return *range;
+    }
+    const u32 index = allocator.AddBlock();
+    if (index >= blocks.size()) {
+        blocks.resize(index + 1);
+    }
+    auto& block = blocks[index];
+    block = std::make_unique<UniqueBuffer>(instance.GetDevice(), instance.GetAllocator());
+    const vk::BufferCreateInfo block_ci = {
+        .size = BlockSize,
+        .usage = flags,
+    };
+    block->Create(block_ci, MemoryUsage::DeviceLocal, nullptr);
+    Vulkan::SetObjectName(instance.GetDevice(), block->buffer, "Buffer Arena Block {}", index);
+
+    // Buffers placed at granularity multiples must satisfy the alignment of the usage flags.
+    const auto requirements = instance.GetDevice().getBufferMemoryRequirements(block->buffer);
+    ASSERT_MSG(allocator.Granularity() % requirements.alignment == 0,
+               "Unsupported buffer alignment {:#x}", requirements.alignment);
+
+    const auto range = allocator.Allocate(size);
+    ASSERT_MSG(range, "Failed to sub-allocate {:#x} bytes from a new arena block", size);
+    return *range;
+}
+
+void BufferArena::Free(const ArenaAllocator::Allocation& range) {
+    std::scoped_lock lk{mutex};
+    allocator.Free(range);
+}
+
+VmaAllocation BufferArena::BlockAllocation(u32 block) {
+    std::scoped_lock lk{mutex};
+    return blocks[block]->allocation;
+}
+
+std::optional<u32> BufferArena::Collect() {
+    std::scoped_lock lk{mutex};
+    allocator.ReleaseEmptyBlocks([this](u32 index) { blocks[index].reset(); });
+    return allocator.UpdateDrainingBlock(0.25);
+}
+
+ArenaAllocator::Stats BufferArena::GetStats() {
+    std::scoped_lock lk{mutex};
+    return allocator.GetStats();
+}
+
 } // namespace VideoCore
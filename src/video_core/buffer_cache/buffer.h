@@ -4,11 +4,14 @@
 #pragma once
 
 #include <cstddef>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <utility>
 #include <vector>
 #include "common/types.h"
 #include "video_core/amdgpu/resource.h"
+#include "video_core/buffer_cache/arena_allocator.h"
 #include "video_core/renderer_vulkan/vk_common.h"
 
 namespace Vulkan {
@@ -39,6 +42,8 @@ constexpr vk::BufferUsageFlags ReadFlags =
 constexpr vk::BufferUsageFlags AllFlags =
     ReadFlags | vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eStorageBuffer;
 
+class BufferArena;
+
 struct UniqueBuffer {
     explicit UniqueBuffer(vk::Device device, VmaAllocator allocator);
     ~UniqueBuffer();
@@ -47,19 +52,28 @@ struct UniqueBuffer {
     UniqueBuffer& operator=(const UniqueBuffer&) = delete;
 
     UniqueBuffer(UniqueBuffer&& other)
-        : allocator{std::exchange(other.allocator, VK_NULL_HANDLE)},
+        : device{other.device}, allocator{std::exchange(other.allocator, VK_NULL_HANDLE)},
           allocation{std::exchange(other.allocation, VK_NULL_HANDLE)},
-          buffer{std::exchange(other.buffer, VK_NULL_HANDLE)} {}
+          buffer{std::exchange(other.buffer, VK_NULL_HANDLE)},
+          arena{std::exchange(other.arena, nullptr)}, arena_range{other.arena_range},
+          bda_addr{other.bda_addr} {}
     UniqueBuffer& operator=(UniqueBuffer&& other) {
+        device = other.device;
         buffer = std::exchange(other.buffer, VK_NULL_HANDLE);
         allocator = std::exchange(other.allocator, VK_NULL_HANDLE);
         allocation = std::exchange(other.allocation, VK_NULL_HANDLE);
+        arena = std::exchange(other.arena, nullptr);
+        arena_range = other.arena_range;
+        bda_addr = other.bda_addr;
         return *this;
     }
 
     void Create(const vk::BufferCreateInfo& image_ci, MemoryUsage usage,
                 VmaAllocationInfo* out_alloc_info);
 
+    /// Creates the buffer over a range sub-allocated from the arena.
+    void CreateInArena(const vk::BufferCreateInfo& buffer_ci, BufferArena& arena);
+
     operator vk::Buffer() const {
         return buffer;
     }
@@ -68,6 +82,8 @@ struct UniqueBuffer {
     VmaAllocator allocator;
     VmaAllocation allocation;
     vk::Buffer buffer{};
+    BufferArena* arena{};
+    ArenaAllocator::Allocation arena_range{};
     vk::DeviceAddress bda_addr = 0;
 };
 
@@ -76,6 +92,10 @@ public:
     explicit Buffer(const Vulkan::Instance& instance, Vulkan::Scheduler& scheduler,
                     MemoryUsage usage, VAddr cpu_addr_, vk::BufferUsageFlags flags,
                     u64 size_bytes_);
+    /// Creates a device local buffer sub-allocated from the arena when it fits in a block.
+    explicit Buffer(const Vulkan::Instance& instance, Vulkan::Scheduler& scheduler,
+                    BufferArena& arena, VAddr cpu_addr_, vk::BufferUsageFlags flags,
+                    u64 size_bytes_);
 
     Buffer& operator=(const Buffer&) = delete;
     Buffer(const Buffer&) = delete;
@@ -99,6 +119,14 @@ public:
         return cpu_addr;
     }
 
+    [[nodiscard]] bool IsInArena() const noexcept {
+        return buffer.arena != nullptr;
+    }
+
+    [[nodiscard]] u32 ArenaBlock() const noexcept {
+        return buffer.arena_range.block;
+    }
+
     [[nodiscard]] u64 Offset(VAddr other_cpu_addr) const noexcept {
         return other_cpu_addr - cpu_addr;
     }
@@ -115,6 +143,14 @@ public:
         return lru_id;
     }
 
+    void SetLastUseTick(u64 tick) noexcept {
+        last_use_tick = tick;
+    }
+
+    u64 LastUseTick() const noexcept {
+        return last_use_tick;
+    }
+
     vk::Buffer Handle() const noexcept {
         return buffer;
     }
@@ -157,6 +193,7 @@ public:
     int stream_score = 0;
     size_t size_bytes = 0;
     u64 lru_id = 0;
+    u64 last_use_tick = 0;
     std::span<u8> mapped_data;
     const Vulkan::Instance* instance;
     Vulkan::Scheduler* scheduler;
@@ -210,4 +247,51 @@ private:
     u64 wait_bound{};
 };
 
+/**
+ * Device local memory blocks that cache buffers are carved out of, so creating and joining
+ * buffers does not allocate device memory each time. Buffers larger than MaxArenaBufferSize get
+ * dedicated allocations.
+ */
+class BufferArena {
+public:
+    static constexpr u64 BlockSize = 64_MB;
+    static constexpr u64 MaxArenaBufferSize = 16_MB;
+
+    explicit BufferArena(const Vulkan::Instance& instance, vk::BufferUsageFlags flags,
+                         u64 granularity);
+    ~BufferArena();
+
+    /// Returns true when a buffer of this size is sub-allocated.
+    [[nodiscard]] static bool Fits(u64 size) noexcept {
+        return size <= MaxArenaBufferSize;
+    }
+
+    /// Usage flags every buffer of the arena is created with.
+    [[nodiscard]] vk::BufferUsageFlags Flags() const noexcept {
+        return flags;
+    }
+
+    /// Sub-allocates a range, adding a block if none has room.
+    ArenaAllocator::Allocation Allocate(u64 size);
+
+    /// Returns a range to the arena. The caller guarantees the GPU is done with it.
+    void Free(const ArenaAllocator::Allocation& range);
+
+    /// Returns the allocation backing a block.
+    [[nodiscard]] VmaAllocation BlockAllocation(u32 block);
+
+    /// Frees the memory of empty blocks and picks a sparse block to drain, which is returned.
+    std::optional<u32> Collect();
+
+    /// Returns a snapshot of the sub-allocation statistics.
+    [[nodiscard]] ArenaAllocator::Stats GetStats();
+
+private:
+    const Vulkan::Instance& instance;
+    vk::BufferUsageFlags flags;
+    std::mutex mutex;
+    ArenaAllocator allocator;
+    std::vector<std::unique_ptr<UniqueBuffer>> blocks;
+};
+
 } // namespace VideoCore
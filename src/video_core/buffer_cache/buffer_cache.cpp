@@ -21,6 +21,9 @@ static constexpr size_t StagingBufferSize = 512_MB;
 static constexpr size_t DownloadBufferSize = 32_MB;
 static constexpr size_t UboStreamBufferSize = 64_MB;
 static constexpr size_t DeviceBufferSize = 128_MB;
+static constexpr size_t MaxRelocatedBytes = 32_MB;
+static constexpr vk::BufferUsageFlags CacheBufferFlags =
+    AllFlags | vk::BufferUsageFlagBits::eShaderDeviceAddress;
 
 BufferCache::BufferCache(const Vulkan::Instance& instance_, Vulkan::Scheduler& scheduler_,
                          AmdGpu::Liverpool* liverpool_, TextureCache& texture_cache_,
@@ -34,7 +37,8 @@ BufferCache::BufferCache(const Vulkan::Instance& instance_, Vulkan::Scheduler& s
       device_buffer{instance, scheduler, MemoryUsage::DeviceLocal, DeviceBufferSize},
       gds_buffer{instance, scheduler, MemoryUsage::Stream, 0, AllFlags, DataShareBufferSize},
       bda_pagetable_buffer{instance, scheduler, MemoryUsage::DeviceLocal,
-                           0,        AllFlags,  BDA_PAGETABLE_SIZE} {
+                           0,        AllFlags,  BDA_PAGETABLE_SIZE},
+      buffer_arena{instance, CacheBufferFlags, CACHING_PAGESIZE} {
     Vulkan::SetObjectName(instance.GetDevice(), gds_buffer.Handle(), "GDS Buffer");
     Vulkan::SetObjectName(instance.GetDevice(), bda_pagetable_buffer.Handle(),
                           "BDA Page Table Buffer");
@@ -89,7 +93,7 @@ void BufferCache::ReadMemory(VAddr device_addr, u64 size, bool is_write) {
 }
 
 template <bool async>
-void BufferCache::DownloadBufferMemory(Buffer& buffer, VAddr device_addr, u64 size, bool is_write) {
+u64 BufferCache::DownloadBufferMemory(Buffer& buffer, VAddr device_addr, u64 size, bool is_write) {
     boost::container::small_vector<vk::BufferCopy, 1> copies;
     u64 total_size_bytes = 0;
     memory_tracker->ForEachDownloadRange<false>(
@@ -112,7 +116,7 @@ void BufferCache::DownloadBufferMemory(Buffer& buffer, VAddr device_addr, u64 si
             gpu_modified_ranges.Subtract(device_addr_out, range_size);
         });
     if (total_size_bytes == 0) {
-        return;
+        return 0;
     }
     const auto [download, offset] = download_buffer.Map(total_size_bytes);
     for (auto& copy : copies) {
@@ -123,10 +127,12 @@ void BufferCache::DownloadBufferMemory(Buffer& buffer, VAddr device_addr, u64 si
     scheduler.EndRendering();
     const auto cmdbuf = scheduler.CommandBuffer();
     cmdbuf.copyBuffer(buffer.buffer, download_buffer.Handle(), copies);
-    const auto write_data = [&]() {
+    // May run after this call returned and the buffer was deleted, so capture everything by value.
+    auto write_data = [this, copies = std::move(copies), download, offset,
+                       buffer_addr = buffer.CpuAddr(), device_addr, size, is_write]() {
         auto* memory = Core::Memory::Instance();
         for (const auto& copy : copies) {
-            const VAddr copy_device_addr = buffer.CpuAddr() + copy.srcOffset;
+            const VAddr copy_device_addr = buffer_addr + copy.srcOffset;
             const u64 dst_offset = copy.dstOffset - offset;
             memory->TryWriteBacking(std::bit_cast<u8*>(copy_device_addr), download + dst_offset,
                                     copy.size);
@@ -137,11 +143,12 @@ void BufferCache::DownloadBufferMemory(Buffer& buffer, VAddr device_addr, u64 si
         }
     };
     if constexpr (async) {
-        scheduler.DeferOperation(write_data);
+        scheduler.DeferOperation(std::move(write_data));
     } else {
         scheduler.Finish();
         write_data();
     }
+    return total_size_bytes;
 }
 
 void BufferCache::BindVertexBuffers(const Vulkan::GraphicsPipeline& pipeline) {
@@ -234,13 +241,24 @@ void BufferCache::BindVertexBuffers(const Vulkan::GraphicsPipeline& pipeline) {
         host_strides.push_back(buffer.GetStride());
     }
 
-    const auto cmdbuf = scheduler.CommandBuffer();
+    // Only rebind the span of bindings that changed since the last draw.
+    const bool dynamic_input = instance.IsVertexInputDynamicState();
     const auto num_buffers = guest_buffers.size();
-    if (instance.IsVertexInputDynamicState()) {
-        cmdbuf.bindVertexBuffers(0, num_buffers, host_buffers.data(), host_offsets.data());
+    const auto [first, last] = scheduler.GetBindingState().UpdateVertexBuffers(
+        {host_buffers.data(), num_buffers}, {host_offsets.data(), num_buffers},
+        {host_sizes.data(), dynamic_input ? 0 : num_buffers},
+        {host_strides.data(), dynamic_input ? 0 : num_buffers});
+    if (first == last) {
+        return;
+    }
+    const auto cmdbuf = scheduler.CommandBuffer();
+    if (dynamic_input) {
+        cmdbuf.bindVertexBuffers(first, last - first, host_buffers.data() + first,
+                                 host_offsets.data() + first);
     } else {
-        cmdbuf.bindVertexBuffers2(0, num_buffers, host_buffers.data(), host_offsets.data(),
-                                  host_sizes.data(), host_strides.data());
+        cmdbuf.bindVertexBuffers2(first, last - first, host_buffers.data() + first,
+                                  host_offsets.data() + first, host_sizes.data() + first,
+                                  host_strides.data() + first);
     }
 }
 
@@ -257,6 +275,9 @@ void BufferCache::BindIndexBuffer(u32 index_offset) {
     // Bind index buffer.
     const u32 index_buffer_size = regs.num_indices * index_size;
     const auto [vk_buffer, offset] = ObtainBuffer(index_address, index_buffer_size, false);
+    if (!scheduler.GetBindingState().UpdateIndexBuffer(vk_buffer->Handle(), offset, index_type)) {
+        return;
+    }
     const auto cmdbuf = scheduler.CommandBuffer();
     cmdbuf.bindIndexBuffer(vk_buffer->Handle(), offset, index_type);
 }
@@ -574,10 +595,8 @@ BufferId BufferCache::CreateBuffer(VAddr device_addr, u32 wanted_size) {
     wanted_size = static_cast<u32>(device_addr_end - device_addr);
     const OverlapResult overlap = ResolveOverlaps(device_addr, wanted_size);
     const u32 size = static_cast<u32>(overlap.end - overlap.begin);
-    const BufferId new_buffer_id =
-        slot_buffers.insert(instance, scheduler, MemoryUsage::DeviceLocal, overlap.begin,
-                            AllFlags | vk::BufferUsageFlagBits::eShaderDeviceAddress, size);
-    auto& new_buffer = slot_buffers[new_buffer_id];
+    const BufferId new_buffer_id = slot_buffers.insert(instance, scheduler, buffer_arena,
+                                                       overlap.begin, CacheBufferFlags, size);
     for (const BufferId overlap_id : overlap.ids) {
         JoinOverlap(new_buffer_id, overlap_id, !overlap.has_stream_leap);
     }
@@ -585,6 +604,41 @@ BufferId BufferCache::CreateBuffer(VAddr device_addr, u32 wanted_size) {
     return new_buffer_id;
 }
 
+void BufferCache::RelocateBuffer(BufferId buffer_id) {
+    const Buffer& buffer = slot_buffers[buffer_id];
+    const VAddr device_addr = buffer.CpuAddr();
+    const u64 size = buffer.SizeBytes();
+    const int stream_score = buffer.StreamScore();
+    const BufferId new_buffer_id =
+        slot_buffers.insert(instance, scheduler, buffer_arena, device_addr, CacheBufferFlags, size);
+    slot_buffers[new_buffer_id].IncreaseStreamScore(stream_score);
+    JoinOverlap(new_buffer_id, buffer_id, false);
+    Register(new_buffer_id);
+}
+
+void BufferCache::DefragmentArena() {
+    const auto draining_block = buffer_arena.Collect();
+    if (!draining_block) {
+        return;
+    }
+    // Move a bounded amount of buffers out of the sparse block each run. Its memory is released
+    // once the old buffers are destroyed after the GPU is done with them.
+    boost::container::small_vector<BufferId, 64> relocations;
+    u64 budget = MaxRelocatedBytes;
+    lru_cache.ForEachItemBelow(gc_tick, [&](BufferId buffer_id) {
+        const Buffer& buffer = slot_buffers[buffer_id];
+        if (!buffer.IsInArena() || buffer.ArenaBlock() != *draining_block ||
+            buffer.SizeBytes() > budget) {
+            return;
+        }
+        budget -= buffer.SizeBytes();
+        relocations.push_back(buffer_id);
+    });
+    for (const BufferId buffer_id : relocations) {
+        RelocateBuffer(buffer_id);
+    }
+}
+
 void BufferCache::ProcessFaultBuffer() {
     fault_manager.ProcessFaultBuffer();
 }
@@ -640,6 +694,7 @@ bool BufferCache::SynchronizeBuffer(Buffer& buffer, VAddr device_addr, u32 size,
     size_t total_size_bytes = 0;
     VAddr buffer_start = buffer.CpuAddr();
     vk::Buffer src_buffer = VK_NULL_HANDLE;
+    TouchBuffer(buffer);
     memory_tracker->ForEachUploadRange(
         device_addr, size, is_written,
         [&](u64 device_addr_out, u64 range_size) {
@@ -682,7 +737,6 @@ bool BufferCache::SynchronizeBuffer(Buffer& buffer, VAddr device_addr, u32 size,
             .bufferMemoryBarrierCount = 1,
             .pBufferMemoryBarriers = &post_barrier,
         });
-        TouchBuffer(buffer);
     }
     if (is_texel_buffer && !is_written) {
         return SynchronizeBufferFromImage(buffer, device_addr, size);
@@ -837,29 +891,57 @@ void BufferCache::RunGarbageCollector() {
     SCOPE_EXIT {
         ++gc_tick;
     };
+    DefragmentArena();
     if (instance.CanReportMemoryUsage()) {
         total_used_memory = instance.GetDeviceMemoryUsage();
     }
+    gc_stats.used_memory = total_used_memory;
     if (total_used_memory < trigger_gc_memory) {
         return;
     }
     const bool aggressive = total_used_memory >= critical_gc_memory;
     const u64 ticks_to_destroy = std::min<u64>(aggressive ? 80 : 160, gc_tick);
     int max_deletions = aggressive ? 64 : 32;
+    ++(aggressive ? gc_stats.aggressive_runs : gc_stats.normal_runs);
+
     const auto clean_up = [&](BufferId buffer_id) {
         if (max_deletions == 0) {
-            return;
+            return true;
         }
-        --max_deletions;
         Buffer& buffer = slot_buffers[buffer_id];
-        // InvalidateMemory(buffer.CpuAddr(), buffer.SizeBytes());
-        DownloadBufferMemory<true>(buffer, buffer.CpuAddr(), buffer.SizeBytes(), true);
+        if (!scheduler.IsFree(buffer.LastUseTick())) {
+            // Still referenced by a submission the GPU has not finished.
+            ++gc_stats.skipped_in_flight;
+            return false;
+        }
+        const VAddr device_addr = buffer.CpuAddr();
+        const u64 size = buffer.SizeBytes();
+        if (IsRegionGpuModified(device_addr, size)) {
+            // Only pay for a readback when memory is critical. The buffer is kept alive until the
+            // download has been written back, as a buffer recreated over the range before then
+            // would miss the GPU data.
+            if (aggressive) {
+                ++gc_stats.downloaded_buffers;
+                gc_stats.downloaded_bytes +=
+                    DownloadBufferMemory<true>(buffer, device_addr, size, true);
+                buffer.SetLastUseTick(scheduler.CurrentTick());
+            } else {
+                ++gc_stats.skipped_gpu_modified;
+            }
+            return false;
+        }
+        --max_deletions;
+        ++gc_stats.evicted_buffers;
+        gc_stats.evicted_bytes += Common::AlignUp(size, CACHING_PAGESIZE);
         DeleteBuffer(buffer_id);
+        return false;
     };
+    lru_cache.ForEachItemBelow(gc_tick - ticks_to_destroy, clean_up);
 }
 
-void BufferCache::TouchBuffer(const Buffer& buffer) {
+void BufferCache::TouchBuffer(Buffer& buffer) {
     lru_cache.Touch(buffer.LRUId(), gc_tick);
+    buffer.SetLastUseTick(scheduler.CurrentTick());
 }
 
 void BufferCache::DeleteBuffer(BufferId buffer_id) {
@@ -59,6 +59,18 @@ public:
     };
     using PageTable = MultiLevelPageTable<Traits>;
 
+    struct GcStats {
+        u64 used_memory = 0;
+        u64 normal_runs = 0;
+        u64 aggressive_runs = 0;
+        u64 evicted_buffers = 0;
+        u64 evicted_bytes = 0;
+        u64 downloaded_buffers = 0;
+        u64 downloaded_bytes = 0;
+        u64 skipped_in_flight = 0;
+        u64 skipped_gpu_modified = 0;
+    };
+
     struct OverlapResult {
         boost::container::small_vector<BufferId, 16> ids;
         VAddr begin;
@@ -155,6 +167,16 @@ public:
     /// Runs the garbage collector.
     void RunGarbageCollector();
 
+    /// Returns the memory pressure counters of the garbage collector.
+    [[nodiscard]] const GcStats& GetGcStats() const noexcept {
+        return gc_stats;
+    }
+
+    /// Returns the sub-allocation statistics of the cache buffer arena.
+    [[nodiscard]] ArenaAllocator::Stats GetArenaStats() {
+        return buffer_arena.GetStats();
+    }
+
 private:
     template <typename Func>
     void ForEachBufferInRange(VAddr device_addr, u64 size, Func&& func) {
@@ -170,7 +192,7 @@ private:
     }
 
     template <bool async>
-    void DownloadBufferMemory(Buffer& buffer, VAddr device_addr, u64 size, bool is_write);
+    u64 DownloadBufferMemory(Buffer& buffer, VAddr device_addr, u64 size, bool is_write);
 
     [[nodiscard]] OverlapResult ResolveOverlaps(VAddr device_addr, u32 wanted_size);
 
@@ -178,6 +200,10 @@ private:
 
     BufferId CreateBuffer(VAddr device_addr, u32 wanted_size);
 
+    void RelocateBuffer(BufferId buffer_id);
+
+    void DefragmentArena();
+
     void Register(BufferId buffer_id);
 
     void Unregister(BufferId buffer_id);
@@ -195,7 +221,7 @@ private:
 
     void WriteDataBuffer(Buffer& buffer, VAddr address, const void* value, u32 num_bytes);
 
-    void TouchBuffer(const Buffer& buffer);
+    void TouchBuffer(Buffer& buffer);
 
     void DeleteBuffer(BufferId buffer_id);
 
@@ -212,11 +238,13 @@ private:
     StreamBuffer device_buffer;
     Buffer gds_buffer;
     Buffer bda_pagetable_buffer;
+    BufferArena buffer_arena;
     Common::SlotVector<Buffer> slot_buffers;
     u64 total_used_memory = 0;
     u64 trigger_gc_memory = 0;
     u64 critical_gc_memory = 0;
     u64 gc_tick = 0;
+    GcStats gc_stats;
     Common::LeastRecentlyUsedCache<BufferId, u64> lru_cache;
     RangeSet gpu_modified_ranges;
     SplitRangeMap<BufferId> buffer_ranges;
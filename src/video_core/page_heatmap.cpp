@@ -0,0 +1,113 @@
+// SPDX-FileCopyrightText: Copyright 2025 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+
+#include "common/div_ceil.h"
+#include "common/thread.h"
+#include "video_core/page_heatmap.h"
+
+namespace VideoCore {
+
+using namespace std::chrono_literals;
+
+constexpr auto SamplerInterval = 50ms;
+
+PageHeatmap& PageHeatmap::Instance() {
+    static PageHeatmap instance;
+    return instance;
+}
+
+void PageHeatmap::Start(u32 sample_period_) {
+    if (IsRunning()) {
+        return;
+    }
+    sample_period = std::clamp(sample_period_, 1U, MaxSamplePeriod);
+    pending.reserve(MaxPendingSamples);
+    sampler_thread = std::jthread([this](std::stop_token stoken) { SamplerThread(stoken); });
+    enabled.store(true, std::memory_order_relaxed);
+}
+
+void PageHeatmap::Stop() {
+    if (!IsRunning()) {
+        return;
+    }
+    enabled.store(false, std::memory_order_relaxed);
+    sampler_thread = {};
+    Drain();
+}
+
+void PageHeatmap::Reset() {
+    std::scoped_lock lk{pending_mutex, pages_mutex};
+    pending.clear();
+    pages.clear();
+    dropped_samples = 0;
+}
+
+PageHeatmap::PageMap PageHeatmap::Snapshot() const {
+    std::scoped_lock lk{pages_mutex};
+    return pages;
+}
+
+void PageHeatmap::Push(PageEvent event, VAddr addr, u64 size) {
+    if (event_counter.fetch_add(1, std::memory_order_relaxed) % sample_period != 0) {
+        return;
+    }
+    const VAddr page_addr = addr >> PAGE_BITS;
+    const u64 num_pages = Common::DivCeil(addr + std::max<u64>(size, 1), 1ULL << PAGE_BITS) -
+                          page_addr;
+    std::scoped_lock lk{pending_mutex};
+    if (pending.size() >= MaxPendingSamples) {
+        ++dropped_samples;
+        return;
+    }
+    pending.push_back({
+        .addr = page_addr << PAGE_BITS,
+        .num_pages = static_cast<u32>(std::min<u64>(num_pages, MaxPagesPerSample)),
+        .event = event,
+    });
+}
+
+void PageHeatmap::SamplerThread(std::stop_token stoken) {
+    Common::SetCurrentThreadName("shadPS4:PageHeatmap");
+    while (!stoken.stop_requested()) {
+        std::this_thread::sleep_for(SamplerInterval);
+        Drain();
+    }
+}
+
+void PageHeatmap::Drain() {
+    // Swap the queue out so producers only wait for the swap, not for the aggregation.
+    std::vector<Sample> samples;
+    samples.reserve(MaxPendingSamples);
+    {
+        std::scoped_lock lk{pending_mutex};
+        samples.swap(pending);
+    }
+
+    // Each sample stands for `sample_period` events.
+    const u64 weight = sample_period;
+    std::scoped_lock lk{pages_mutex};
+    for (const auto& sample : samples) {
+        for (u32 i = 0; i < sample.num_pages; ++i) {
+            auto& counts = pages[sample.addr + (static_cast<VAddr>(i) << PAGE_BITS)];
+            switch (sample.event) {
+            case PageEvent::WriteFault:
+                counts.write_faults += weight;
+                break;
+            case PageEvent::ReadFault:
+                counts.read_faults += weight;
+                break;
+            case PageEvent::Invalidate:
+                counts.invalidations += weight;
+                break;
+            case PageEvent::Protect:
+                counts.protects += weight;
+                break;
+            }
+        }
+    }
+}
+
+} // namespace VideoCore
@@ -0,0 +1,110 @@
+// SPDX-FileCopyrightText: Copyright 2025 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "common/types.h"
+
+namespace VideoCore {
+
+enum class PageEvent : u8 {
+    WriteFault,
+    ReadFault,
+    Invalidate,
+    Protect,
+};
+
+/**
+ * Sampling profiler for guest page activity.
+ *
+ * The page manager reports protection faults and (un)protect calls, the rasterizer reports
+ * invalidations. While the sampler is running every `sample_period`-th event is queued and a
+ * background thread folds the queue into per page counters every few milliseconds. When it is
+ * stopped, reporting an event costs a single relaxed load.
+ */
+class PageHeatmap {
+public:
+    static constexpr size_t PAGE_BITS = 12;
+    static constexpr u32 MaxSamplePeriod = 64;
+
+    struct PageCounts {
+        u64 write_faults;
+        u64 read_faults;
+        u64 invalidations;
+        u64 protects;
+
+        u64 Total() const {
+            return write_faults + read_faults + invalidations + protects;
+        }
+
+        PageCounts& operator+=(const PageCounts& other) {
+            write_faults += other.write_faults;
+            read_faults += other.read_faults;
+            invalidations += other.invalidations;
+            protects += other.protects;
+            return *this;
+        }
+    };
+
+    /// Counters keyed by page aligned guest address.
+    using PageMap = std::map<VAddr, PageCounts>;
+
+    static PageHeatmap& Instance();
+
+    static void Record(PageEvent event, VAddr addr, u64 size = 1) {
+        if (enabled.load(std::memory_order_relaxed)) [[unlikely]] {
+            Instance().Push(event, addr, size);
+        }
+    }
+
+    void Start(u32 sample_period);
+    void Stop();
+    void Reset();
+
+    [[nodiscard]] bool IsRunning() const {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] u64 GetDroppedSamples() const {
+        return dropped_samples.load(std::memory_order_relaxed);
+    }
+
+    /// Returns a copy of the counters gathered so far.
+    PageMap Snapshot() const;
+
+private:
+    struct Sample {
+        VAddr addr;
+        u32 num_pages;
+        PageEvent event;
+    };
+
+    static constexpr size_t MaxPendingSamples = 64_KB;
+    static constexpr size_t MaxPagesPerSample = 1024;
+
+    void Push(PageEvent event, VAddr addr, u64 size);
+    void SamplerThread(std::stop_token stoken);
+    void Drain();
+
+    inline static std::atomic_bool enabled{};
+
+    std::atomic<u64> event_counter{};
+    std::atomic<u64> dropped_samples{};
+    u32 sample_period{1};
+
+    std::mutex pending_mutex;
+    std::vector<Sample> pending;
+
+    mutable std::mutex pages_mutex;
+    PageMap pages;
+
+    std::jthread sampler_thread;
+};
+
+} // namespace VideoCore
@@ -9,6 +9,7 @@
 #include "common/signal_context.h"
 #include "core/memory.h"
 #include "core/signals.h"
+#include "video_core/page_heatmap.h"
 #include "video_core/page_manager.h"
 #include "video_core/renderer_vulkan/vk_rasterizer.h"
 
@@ -123,6 +124,7 @@ struct PageManager::Impl {
     }
 
     void Protect(VAddr address, size_t size, Core::MemoryPermission perms) {
+        PageHeatmap::Record(PageEvent::Protect, address, size);
         bool allow_write = True(perms & Core::MemoryPermission::Write);
         uffdio_writeprotect wp;
         wp.range.start = address;
@@ -174,6 +176,7 @@ struct PageManager::Impl {
 
             // Notify rasterizer about the fault.
             const VAddr addr = msg.arg.pagefault.address;
+            PageHeatmap::Record(PageEvent::WriteFault, addr);
             rasterizer->InvalidateMemory(addr, 1);
         }
     }
@@ -200,6 +203,7 @@ struct PageManager::Impl {
 
     void Protect(VAddr address, size_t size, Core::MemoryPermission perms) {
         RENDERER_TRACE;
+        PageHeatmap::Record(PageEvent::Protect, address, size);
         auto* memory = Core::Memory::Instance();
         auto& impl = memory->GetAddressSpace();
         ASSERT_MSG(perms != Core::MemoryPermission::Write,
@@ -210,8 +214,10 @@ struct PageManager::Impl {
     static bool GuestFaultSignalHandler(void* context, void* fault_address) {
         const auto addr = reinterpret_cast<VAddr>(fault_address);
         if (Common::IsWriteError(context)) {
+            PageHeatmap::Record(PageEvent::WriteFault, addr);
             return rasterizer->InvalidateMemory(addr, 8);
         } else {
+            PageHeatmap::Record(PageEvent::ReadFault, addr);
             return rasterizer->ReadMemory(addr, 8);
         }
         return false;
@@ -360,6 +360,11 @@ public:
         return properties.limits.maxSamplerAnisotropy;
     }
 
+    /// Returns the maximum number of samplers that may exist at once.
+    u32 MaxSamplerAllocationCount() const {
+        return properties.limits.maxSamplerAllocationCount;
+    }
+
     /// Returns the maximum number of push descriptors.
     u32 MaxPushDescriptors() const {
         return push_descriptor_props.maxPushDescriptors;
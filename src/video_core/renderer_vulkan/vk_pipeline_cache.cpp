@@ -8,6 +8,7 @@
 #include "common/io_file.h"
 #include "common/path_util.h"
 #include "core/debug_state.h"
+#include "core/ipc/shader_service.h"
 #include "shader_recompiler/backend/spirv/emit_spirv.h"
 #include "shader_recompiler/info.h"
 #include "shader_recompiler/recompiler.h"
@@ -270,13 +271,30 @@ PipelineCache::PipelineCache(const Instance& instance_, Scheduler& scheduler_,
 
     WarmUp();
 
+    // Shader modules collected for the debugger need a real translation
+    const auto service_socket = Config::getShaderServiceSocket();
+    if (!service_socket.empty() && !Config::collectShadersForDebug()) {
+        shader_service = ShaderService::Client::Connect(service_socket);
+        if (!shader_service) {
+            LOG_WARNING(Render, "Shader service at {} is not reachable, compiling in process",
+                        service_socket);
+        }
+    }
+
     auto [cache_result, cache] = instance.GetDevice().createPipelineCacheUnique({});
     ASSERT_MSG(cache_result == vk::Result::eSuccess, "Failed to create pipeline cache: {}",
                vk::to_string(cache_result));
     pipeline_cache = std::move(cache);
 }
 
-PipelineCache::~PipelineCache() = default;
+PipelineCache::~PipelineCache() {
+    if (shader_service) {
+        const auto stats = shader_service->GetStats();
+        const auto hit_rate = stats.lookups ? stats.hits * 100.0 / stats.lookups : 0.0;
+        LOG_INFO(Render, "Shader service: {}/{} lookups hit ({:.1f}%), {} published, {} errors",
+                 stats.hits, stats.lookups, hit_rate, stats.published, stats.errors);
+    }
+}
 
 const GraphicsPipeline* PipelineCache::GetGraphicsPipeline() {
     if (!RefreshGraphicsKey()) {
@@ -531,7 +549,8 @@ bool PipelineCache::RefreshComputeKey() {
 
 vk::ShaderModule PipelineCache::CompileModule(Shader::Info& info, Shader::RuntimeInfo& runtime_info,
                                               const std::span<const u32>& code, size_t perm_idx,
-                                              Shader::Backend::Bindings& binding) {
+                                              Shader::Backend::Bindings& binding,
+                                              std::vector<u32>* spv_out) {
     LOG_INFO(Render_Vulkan, "Compiling {} shader {:#x} {}", info.stage, info.pgm_hash,
              perm_idx != 0 ? "(permutation)" : "");
     DumpShader(code, info.pgm_hash, info.stage, perm_idx, "bin");
@@ -551,6 +570,9 @@ vk::ShaderModule PipelineCache::CompileModule(Shader::Info& info, Shader::Runtim
         module = CompileSPV(spv, instance.GetDevice());
     }
 
+    if (spv_out) {
+        *spv_out = spv;
+    }
     RegisterShaderBinary(std::move(spv), info.pgm_hash, perm_idx);
 
     const auto name = GetShaderName(info.stage, info.pgm_hash, perm_idx);
@@ -562,6 +584,60 @@ vk::ShaderModule PipelineCache::CompileModule(Shader::Info& info, Shader::Runtim
     return module;
 }
 
+vk::ShaderModule PipelineCache::FetchServiceProgram(u64 program_key, Shader::Info& info,
+                                                    const Shader::RuntimeInfo& runtime_info,
+                                                    const Shader::Backend::Bindings& binding) {
+    auto blob = shader_service->Get(program_key);
+    if (!blob) {
+        return {};
+    }
+    // Only take over the metadata when the matching module is available as well
+    auto candidate = info;
+    if (!DeserializeServiceProgram(std::move(*blob), candidate)) {
+        return {};
+    }
+    candidate.pgm_base = info.pgm_base;
+    candidate.user_data = info.user_data;
+    candidate.RefreshFlatBuf();
+
+    const auto spec = Shader::StageSpecialization(candidate, runtime_info, profile, binding);
+    const auto module = FetchServiceModule(GetServiceModuleKey(program_key, spec), candidate, 0);
+    if (module) {
+        info = std::move(candidate);
+    }
+    return module;
+}
+
+vk::ShaderModule PipelineCache::FetchServiceModule(u64 module_key, const Shader::Info& info,
+                                                   size_t perm_idx) {
+    const auto blob = shader_service->Get(module_key);
+    std::vector<u32> spv{};
+    if (!blob || !DeserializeServiceModule(*blob, spv)) {
+        return {};
+    }
+    LOG_INFO(Render_Vulkan, "Loaded {} shader {:#x} {} from the shader service", info.stage,
+             info.pgm_hash, perm_idx != 0 ? "(permutation)" : "");
+
+    vk::ShaderModule module;
+    auto patch = GetShaderPatch(info.pgm_hash, info.stage, perm_idx, "spv");
+    if (patch && Config::patchShaders()) {
+        LOG_INFO(Loader, "Loaded patch for {} shader {:#x}", info.stage, info.pgm_hash);
+        module = CompileSPV(*patch, instance.GetDevice());
+    } else {
+        module = CompileSPV(spv, instance.GetDevice());
+    }
+    RegisterShaderBinary(std::move(spv), info.pgm_hash, perm_idx);
+
+    Vulkan::SetObjectName(instance.GetDevice(), module,
+                          GetShaderName(info.stage, info.pgm_hash, perm_idx));
+    return module;
+}
+
+void PipelineCache::PublishServiceModule(u64 module_key, std::span<const u32> spv) {
+    const auto blob = SerializeServiceModule(spv);
+    shader_service->Put(module_key, blob);
+}
+
 PipelineCache::Result PipelineCache::GetProgram(Stage stage, LogicalStage l_stage,
                                                 const Shader::ShaderParams& params,
                                                 Shader::Backend::Bindings& binding) {
@@ -571,9 +647,25 @@ PipelineCache::Result PipelineCache::GetProgram(Stage stage, LogicalStage l_stag
         it_pgm.value() = std::make_unique<Program>(stage, l_stage, params);
         auto& program = it_pgm.value();
         auto start = binding;
-        const auto module = CompileModule(program->info, runtime_info, params.code, 0, binding);
+        u64 program_key{};
+        vk::ShaderModule module{};
+        if (shader_service) {
+            program_key = GetServiceProgramKey(program->info, runtime_info, params.code, profile);
+            module = FetchServiceProgram(program_key, program->info, runtime_info, start);
+        }
+        std::vector<u32> spv{};
+        if (module) {
+            program->info.AddBindings(binding);
+        } else {
+            module = CompileModule(program->info, runtime_info, params.code, 0, binding,
+                                   shader_service ? &spv : nullptr);
+        }
         auto spec = Shader::StageSpecialization(program->info, runtime_info, profile, start);
         const auto perm_hash = HashCombine(params.hash, 0);
+        if (!spv.empty()) {
+            shader_service->Put(program_key, SerializeServiceProgram(program->info));
+            PublishServiceModule(GetServiceModuleKey(program_key, spec), spv);
+        }
 
         RegisterShaderMeta(program->info, spec.fetch_shader_data, spec, perm_hash, 0);
         program->AddPermut(module, std::move(spec));
@@ -595,8 +687,23 @@ PipelineCache::Result PipelineCache::GetProgram(Stage stage, LogicalStage l_stag
 
     const auto it = std::ranges::find(program->modules, spec, &Program::Module::spec);
     if (it == program->modules.end()) {
-        auto new_info = Shader::Info(stage, l_stage, params);
-        module = CompileModule(new_info, runtime_info, params.code, perm_idx, binding);
+        u64 module_key{};
+        if (shader_service) {
+            const auto program_key = GetServiceProgramKey(info, runtime_info, params.code, profile);
+            module_key = GetServiceModuleKey(program_key, spec);
+            module = FetchServiceModule(module_key, info, perm_idx);
+        }
+        if (module) {
+            info.AddBindings(binding);
+        } else {
+            auto new_info = Shader::Info(stage, l_stage, params);
+            std::vector<u32> spv{};
+            module = CompileModule(new_info, runtime_info, params.code, perm_idx, binding,
+                                   shader_service ? &spv : nullptr);
+            if (!spv.empty()) {
+                PublishServiceModule(module_key, spv);
+            }
+        }
 
         RegisterShaderMeta(info, spec.fetch_shader_data, spec, perm_hash, perm_idx);
         program->AddPermut(module, std::move(spec));
@@ -31,6 +31,10 @@ namespace Shader {
 struct Info;
 }
 
+namespace ShaderService {
+class Client;
+}
+
 namespace Vulkan {
 
 class Instance;
@@ -106,7 +110,14 @@ private:
                                                    std::string_view ext);
     vk::ShaderModule CompileModule(Shader::Info& info, Shader::RuntimeInfo& runtime_info,
                                    const std::span<const u32>& code, size_t perm_idx,
-                                   Shader::Backend::Bindings& binding);
+                                   Shader::Backend::Bindings& binding,
+                                   std::vector<u32>* spv_out = nullptr);
+    vk::ShaderModule FetchServiceProgram(u64 program_key, Shader::Info& info,
+                                         const Shader::RuntimeInfo& runtime_info,
+                                         const Shader::Backend::Bindings& binding);
+    vk::ShaderModule FetchServiceModule(u64 module_key, const Shader::Info& info,
+                                        size_t perm_idx);
+    void PublishServiceModule(u64 module_key, std::span<const u32> spv);
     const Shader::RuntimeInfo& BuildRuntimeInfo(Shader::Stage stage, Shader::LogicalStage l_stage);
 
     [[nodiscard]] bool IsPipelineCacheDirty() const {
@@ -132,6 +143,7 @@ private:
     GraphicsPipelineKey graphics_key{};
     ComputePipelineKey compute_key{};
     u32 num_new_pipelines{}; // new pipelines added to the cache since the game start
+    std::unique_ptr<ShaderService::Client> shader_service;
 
     // Only if Config::collectShadersForDebug()
     tsl::robin_map<vk::ShaderModule,
@@ -35,11 +35,19 @@ void Pipeline::BindResources(DescriptorWrites& set_writes, const BufferBarriers&
         cmdbuf.pipelineBarrier2(dependencies);
     }
 
-    const auto stage_flags = IsCompute() ? vk::ShaderStageFlagBits::eCompute : AllGraphicsStageBits;
-    cmdbuf.pushConstants(*pipeline_layout, stage_flags, 0u, sizeof(push_data), &push_data);
+    // Skip push constants and descriptors that match what the command buffer already holds.
+    auto& binding_state = scheduler.GetBindingState();
+    if (binding_state.UpdatePushConstants(
+            *pipeline_layout, {reinterpret_cast<const u8*>(&push_data), sizeof(push_data)})) {
+        const auto stage_flags =
+            IsCompute() ? vk::ShaderStageFlagBits::eCompute : AllGraphicsStageBits;
+        cmdbuf.pushConstants(*pipeline_layout, stage_flags, 0u, sizeof(push_data), &push_data);
+    }
 
     // Bind descriptor set.
-    if (set_writes.empty()) {
+    if (set_writes.empty() ||
+        !binding_state.UpdateDescriptorSet(bind_point, *pipeline_layout,
+                                           {set_writes.data(), set_writes.size()})) {
         return;
     }
 
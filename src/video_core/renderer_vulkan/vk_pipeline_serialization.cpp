@@ -1,7 +1,10 @@
 // SPDX-FileCopyrightText: Copyright 2025 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <xxhash.h>
+
 #include "common/config.h"
+#include "common/hash.h"
 #include "common/serdes.h"
 #include "shader_recompiler/frontend/fetch_shader.h"
 #include "shader_recompiler/info.h"
@@ -13,7 +16,7 @@
 namespace Serialization {
 /* You should increment versions below once corresponding serialization scheme is changed. */
 static constexpr u32 ShaderBinaryVersion = 1u;
-static constexpr u32 ShaderMetaVersion = 1u;
+static constexpr u32 ShaderMetaVersion = 2u;
 static constexpr u32 PipelineKeyVersion = 1u;
 } // namespace Serialization
 
@@ -91,6 +94,70 @@ void RegisterShaderBinary(std::vector<u32>&& spv, u64 pgm_hash, size_t perm_idx)
                                        std::move(spv));
 }
 
+u64 GetServiceProgramKey(const Shader::Info& info, const Shader::RuntimeInfo& runtime_info,
+                         std::span<const u32> code, const Shader::Profile& profile) {
+    XXH3_state_t state;
+    XXH3_64bits_reset(&state);
+    XXH3_64bits_update(&state, &Serialization::ShaderMetaVersion,
+                       sizeof(Serialization::ShaderMetaVersion));
+    XXH3_64bits_update(&state, &Serialization::ShaderBinaryVersion,
+                       sizeof(Serialization::ShaderBinaryVersion));
+    XXH3_64bits_update(&state, &info.stage, sizeof(info.stage));
+    XXH3_64bits_update(&state, &info.l_stage, sizeof(info.l_stage));
+    XXH3_64bits_update(&state, &runtime_info, sizeof(runtime_info));
+    XXH3_64bits_update(&state, &profile, sizeof(profile));
+    XXH3_64bits_update(&state, code.data(), code.size_bytes());
+    return XXH3_64bits_digest(&state);
+}
+
+u64 GetServiceModuleKey(u64 program_key, const Shader::StageSpecialization& spec) {
+    Serialization::Archive ar;
+    spec.Serialize(ar);
+    const auto data = ar.TakeOff();
+    return HashCombine(program_key, XXH3_64bits(data.data(), data.size()));
+}
+
+std::vector<u8> SerializeServiceProgram(const Shader::Info& info) {
+    Serialization::Archive ar;
+    Serialization::Writer meta{ar};
+    meta.Write(Serialization::ShaderMetaVersion);
+    info.Serialize(ar);
+    return ar.TakeOff();
+}
+
+bool DeserializeServiceProgram(std::vector<u8>&& blob, Shader::Info& info) {
+    Serialization::Archive ar{std::move(blob)};
+    Serialization::Reader meta{ar};
+    u32 version{};
+    meta.Read(version);
+    if (version != Serialization::ShaderMetaVersion) {
+        return false;
+    }
+    return info.Deserialize(ar);
+}
+
+std::vector<u8> SerializeServiceModule(std::span<const u32> spv) {
+    Serialization::Archive ar;
+    Serialization::Writer module{ar};
+    module.Write(Serialization::ShaderBinaryVersion);
+    module.Write(spv.data(), spv.size_bytes());
+    return ar.TakeOff();
+}
+
+bool DeserializeServiceModule(const std::vector<u8>& blob, std::vector<u32>& spv) {
+    u32 version{};
+    if (blob.size() <= sizeof(version) || (blob.size() - sizeof(version)) % sizeof(u32) != 0) {
+        return false;
+    }
+    std::memcpy(&version, blob.data(), sizeof(version));
+    if (version != Serialization::ShaderBinaryVersion) {
+        return false;
+    }
+    spv.resize((blob.size() - sizeof(version)) / sizeof(u32));
+    std::memcpy(spv.data(), blob.data() + sizeof(version), spv.size() * sizeof(u32));
+    return true;
+}
+
 bool LoadShaderMeta(Serialization::Archive& ar, Shader::Info& info,
                     std::optional<Shader::Gcn::FetchShaderData>& fetch_shader_data,
                     Shader::StageSpecialization& spec, size_t& perm_idx) {
@@ -18,4 +18,15 @@ void RegisterShaderMeta(const Shader::Info& info,
                         const Shader::StageSpecialization& spec, size_t perm_hash, size_t perm_idx);
 void RegisterShaderBinary(std::vector<u32>&& spv, u64 pgm_hash, size_t perm_idx);
 
+/// Shader service keys. The program key addresses the metadata of a translated program, the
+/// module key one specialization of it.
+u64 GetServiceProgramKey(const Shader::Info& info, const Shader::RuntimeInfo& runtime_info,
+                         std::span<const u32> code, const Shader::Profile& profile);
+u64 GetServiceModuleKey(u64 program_key, const Shader::StageSpecialization& spec);
+
+std::vector<u8> SerializeServiceProgram(const Shader::Info& info);
+bool DeserializeServiceProgram(std::vector<u8>&& blob, Shader::Info& info);
+std::vector<u8> SerializeServiceModule(std::span<const u32> spv);
+bool DeserializeServiceModule(const std::vector<u8>& blob, std::vector<u32>& spv);
+
 } // namespace Vulkan
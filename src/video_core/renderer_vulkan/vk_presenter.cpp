@@ -266,7 +266,7 @@ Frame* Presenter::PrepareLastFrame() {
     });
 
     // Flush frame creation commands.
-    frame->ready_semaphore = scheduler.GetMasterSemaphore()->Handle();
+    frame->ready_scheduler = &scheduler;
     frame->ready_tick = scheduler.CurrentTick();
     SubmitInfo info{};
     scheduler.Flush(info);
@@ -344,7 +344,7 @@ Frame* Presenter::PrepareFrame(const Libraries::VideoOut::BufferAttributeGroup&
     DebugState.output_resolution = {frame->width, frame->height};
 
     // Flush frame creation commands.
-    frame->ready_semaphore = draw_scheduler.GetMasterSemaphore()->Handle();
+    frame->ready_scheduler = &draw_scheduler;
     frame->ready_tick = draw_scheduler.CurrentTick();
     SubmitInfo info{};
     draw_scheduler.Flush(info);
@@ -417,7 +417,7 @@ Frame* Presenter::PrepareBlankFrame(bool present_thread) {
     });
 
     // Flush frame creation commands.
-    frame->ready_semaphore = scheduler.GetMasterSemaphore()->Handle();
+    frame->ready_scheduler = &scheduler;
     frame->ready_tick = scheduler.CurrentTick();
     SubmitInfo info{};
     scheduler.Flush(info);
@@ -600,10 +600,14 @@ void Presenter::Present(Frame* frame, bool is_reusing_frame) {
         cmdbuf.endDebugUtilsLabelEXT();
     }
 
+    // The frame may have been recorded by another scheduler, whose submit thread has to hand it
+    // to the queue before the present submission that waits on it.
+    frame->ready_scheduler->WaitSubmitted(frame->ready_tick);
+
     // Flush vulkan commands.
     SubmitInfo info{};
     info.AddWait(swapchain.GetImageAcquiredSemaphore());
-    info.AddWait(frame->ready_semaphore, frame->ready_tick);
+    info.AddWait(frame->ready_scheduler->GetMasterSemaphore()->Handle(), frame->ready_tick);
     info.AddSignal(swapchain.GetPresentReadySemaphore());
     info.AddSignal(frame->present_done);
     scheduler.Flush(info);
@@ -31,7 +31,7 @@ struct Frame {
     vk::Image image;
     vk::ImageView image_view;
     vk::Fence present_done;
-    vk::Semaphore ready_semaphore;
+    Scheduler* ready_scheduler; ///< Scheduler that recorded the frame
     u64 ready_tick;
     bool is_hdr{false};
     u8 id{};
@@ -73,6 +73,11 @@ public:
         return pipeline_cache;
     }
 
+    /// Returns the binding commands emitted and skipped since the last call.
+    BindingState::Stats TakeBindingStats() {
+        return scheduler.GetBindingState().TakeStats();
+    }
+
     template <typename Func>
     void ForEachMappedRangeInRange(VAddr addr, u64 size, Func&& func) {
         const auto range = decltype(mapped_ranges)::interval_type::right_open(addr, addr + size);
@@ -20,6 +20,7 @@ Scheduler::Scheduler(const Instance& instance)
     AllocateWorkerCommandBuffers();
     priority_pending_ops_thread =
         std::jthread(std::bind_front(&Scheduler::PriorityPendingOpsThread, this));
+    submit_thread = std::jthread(std::bind_front(&Scheduler::SubmitThread, this));
 }
 
 Scheduler::~Scheduler() {
@@ -105,8 +106,9 @@ void Scheduler::AllocateWorkerCommandBuffers() {
     current_cmdbuf = command_pool.Commit();
     Check(current_cmdbuf.begin(begin_info));
 
-    // Invalidate dynamic state so it gets applied to the new command buffer.
+    // Invalidate dynamic state and bindings so they get applied to the new command buffer.
     dynamic_state.Invalidate();
+    binding_state.Invalidate();
 
 #if TRACY_GPU_ENABLED
     auto* profiler_ctx = instance.GetProfilerContext();
@@ -119,7 +121,6 @@ void Scheduler::AllocateWorkerCommandBuffers() {
 }
 
 void Scheduler::SubmitExecution(SubmitInfo& info) {
-    std::scoped_lock lk{submit_mutex};
     const u64 signal_value = master_semaphore.NextTick();
 
 #if TRACY_GPU_ENABLED
@@ -133,6 +134,30 @@ void Scheduler::SubmitExecution(SubmitInfo& info) {
     EndRendering();
     Check(current_cmdbuf.end());
 
+    if (info.num_wait_semas == 0 && info.num_signal_semas == 0 && !info.fence) {
+        // Only the timeline semaphore observes this submission, and waiting on a timeline value
+        // before it is submitted is allowed, so let the submit thread pay for the driver call.
+        {
+            std::scoped_lock lk{submit_queue_mutex};
+            submit_queue.push({current_cmdbuf, signal_value});
+        }
+        submit_queue_cv.notify_one();
+    } else {
+        // Fences and binary semaphores may be waited on as soon as this returns, so submit here
+        // once the submissions queued before it have been made.
+        WaitSubmitted(signal_value - 1);
+        std::scoped_lock lk{submit_mutex};
+        QueueSubmit(current_cmdbuf, signal_value, info);
+    }
+
+    master_semaphore.Refresh();
+    AllocateWorkerCommandBuffers();
+
+    // Apply pending operations
+    PopPendingOperations();
+}
+
+void Scheduler::QueueSubmit(vk::CommandBuffer cmdbuf, u64 signal_value, SubmitInfo& info) {
     const vk::Semaphore timeline = master_semaphore.Handle();
     info.AddSignal(timeline, signal_value);
 
@@ -154,7 +179,7 @@ void Scheduler::SubmitExecution(SubmitInfo& info) {
         .pWaitSemaphores = info.wait_semas.data(),
         .pWaitDstStageMask = wait_stage_masks.data(),
         .commandBufferCount = 1U,
-        .pCommandBuffers = &current_cmdbuf,
+        .pCommandBuffers = &cmdbuf,
         .signalSemaphoreCount = info.num_signal_semas,
         .pSignalSemaphores = info.signal_semas.data(),
     };
@@ -163,11 +188,38 @@ void Scheduler::SubmitExecution(SubmitInfo& info) {
     auto submit_result = instance.GetGraphicsQueue().submit(submit_info, info.fence);
     ASSERT_MSG(submit_result != vk::Result::eErrorDeviceLost, "Device lost during submit");
 
-    master_semaphore.Refresh();
-    AllocateWorkerCommandBuffers();
+    submitted_tick.store(signal_value, std::memory_order_release);
+    submitted_tick.notify_all();
+}
 
-    // Apply pending operations
-    PopPendingOperations();
+void Scheduler::WaitSubmitted(u64 tick) {
+    u64 current = submitted_tick.load(std::memory_order_acquire);
+    while (current < tick) {
+        submitted_tick.wait(current, std::memory_order_acquire);
+        current = submitted_tick.load(std::memory_order_acquire);
+    }
+}
+
+void Scheduler::SubmitThread(std::stop_token stoken) {
+    Common::SetCurrentThreadName("shadPS4:GpuSchedSubmitter");
+
+    while (true) {
+        PendingSubmit submit;
+        {
+            std::unique_lock lk{submit_queue_mutex};
+            submit_queue_cv.wait(lk, stoken, [this] { return !submit_queue.empty(); });
+            // Keep draining after a stop request so no recorded work is dropped.
+            if (submit_queue.empty()) {
+                break;
+            }
+            submit = submit_queue.front();
+            submit_queue.pop();
+        }
+
+        SubmitInfo info{};
+        std::scoped_lock lk{submit_mutex};
+        QueueSubmit(submit.cmdbuf, submit.signal_value, info);
+    }
 }
 
 void Scheduler::PriorityPendingOpsThread(std::stop_token stoken) {
@@ -355,4 +407,114 @@ void DynamicState::Commit(const Instance& instance, const vk::CommandBuffer& cmd
     }
 }
 
+bool BindingState::UpdateDescriptorSet(vk::PipelineBindPoint bind_point,
+                                       vk::PipelineLayout layout,
+                                       std::span<const vk::WriteDescriptorSet> writes) {
+    scratch_descriptors.clear();
+    for (const auto& write : writes) {
+        for (u32 i = 0; i < write.descriptorCount; i++) {
+            Descriptor desc{
+                .binding = write.dstBinding,
+                .array_element = write.dstArrayElement + i,
+                .type = write.descriptorType,
+            };
+            if (write.pBufferInfo) {
+                desc.buffer = write.pBufferInfo[i].buffer;
+                desc.offset = write.pBufferInfo[i].offset;
+                desc.range = write.pBufferInfo[i].range;
+            } else if (write.pImageInfo) {
+                desc.sampler = write.pImageInfo[i].sampler;
+                desc.image_view = write.pImageInfo[i].imageView;
+                desc.image_layout = write.pImageInfo[i].imageLayout;
+            } else if (write.pTexelBufferView) {
+                desc.texel_buffer_view = write.pTexelBufferView[i];
+            }
+            scratch_descriptors.push_back(desc);
+        }
+    }
+
+    const u32 num_descriptors = static_cast<u32>(scratch_descriptors.size());
+    DescriptorSet& set = GetDescriptorSet(bind_point);
+    if (set.layout == layout && set.descriptors == scratch_descriptors) {
+        stats.skipped_bindings += num_descriptors;
+        return false;
+    }
+    set.layout = layout;
+    std::swap(set.descriptors, scratch_descriptors);
+    stats.emitted_bindings += num_descriptors;
+    return true;
+}
+
+bool BindingState::UpdatePushConstants(vk::PipelineLayout layout, std::span<const u8> data) {
+    ASSERT(data.size() <= MaxPushConstantsSize);
+    if (push_layout == layout && push_size == data.size() &&
+        std::memcmp(push_data.data(), data.data(), data.size()) == 0) {
+        ++stats.skipped_bindings;
+        return false;
+    }
+    push_layout = layout;
+    push_size = static_cast<u32>(data.size());
+    std::memcpy(push_data.data(), data.data(), data.size());
+    ++stats.emitted_bindings;
+    return true;
+}
+
+std::pair<u32, u32> BindingState::UpdateVertexBuffers(std::span<const vk::Buffer> buffers,
+                                                      std::span<const vk::DeviceSize> offsets,
+                                                      std::span<const vk::DeviceSize> sizes,
+                                                      std::span<const vk::DeviceSize> strides) {
+    const u32 num_buffers = static_cast<u32>(buffers.size());
+    if (vertex_buffers.size() < num_buffers) {
+        // New slots hold a null buffer so they never compare equal to a real binding.
+        vertex_buffers.resize(num_buffers, VertexBuffer{.offset = ~0ULL});
+    }
+    u32 first = num_buffers;
+    u32 last = 0;
+    for (u32 i = 0; i < num_buffers; i++) {
+        const VertexBuffer binding{
+            .buffer = buffers[i],
+            .offset = offsets[i],
+            .size = sizes.empty() ? 0 : sizes[i],
+            .stride = strides.empty() ? 0 : strides[i],
+        };
+        if (vertex_buffers[i] == binding) {
+            continue;
+        }
+        vertex_buffers[i] = binding;
+        first = std::min(first, i);
+        last = i + 1;
+    }
+    if (first == num_buffers) {
+        stats.skipped_bindings += num_buffers;
+        return {0, 0};
+    }
+    stats.emitted_bindings += last - first;
+    stats.skipped_bindings += num_buffers - (last - first);
+    return {first, last};
+}
+
+bool BindingState::UpdateIndexBuffer(vk::Buffer buffer, vk::DeviceSize offset,
+                                     vk::IndexType type) {
+    if (index_buffer == buffer && index_offset == offset && index_type == type) {
+        ++stats.skipped_bindings;
+        return false;
+    }
+    index_buffer = buffer;
+    index_offset = offset;
+    index_type = type;
+    ++stats.emitted_bindings;
+    return true;
+}
+
+void BindingState::Invalidate() {
+    graphics_set.layout = VK_NULL_HANDLE;
+    graphics_set.descriptors.clear();
+    compute_set.layout = VK_NULL_HANDLE;
+    compute_set.descriptors.clear();
+    push_layout = VK_NULL_HANDLE;
+    push_size = 0;
+    vertex_buffers.clear();
+    index_buffer = VK_NULL_HANDLE;
+}
+
 } // namespace Vulkan
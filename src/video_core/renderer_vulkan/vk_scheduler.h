@@ -3,10 +3,14 @@
 
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <mutex>
+#include <span>
 #include <thread>
 #include <queue>
+#include <utility>
+#include <vector>
 
 #include "common/unique_function.h"
 #include "video_core/amdgpu/regs_color.h"
@@ -339,6 +343,89 @@ struct DynamicState {
     }
 };
 
+/// Shadow copy of the resource bindings recorded into the current command buffer. Each Update
+/// method records the new bindings and tells whether the binding command has to be emitted.
+struct BindingState {
+    static constexpr u32 MaxPushConstantsSize = 128;
+
+    struct Descriptor {
+        u32 binding;
+        u32 array_element;
+        vk::DescriptorType type;
+        vk::Buffer buffer;
+        vk::DeviceSize offset;
+        vk::DeviceSize range;
+        vk::Sampler sampler;
+        vk::ImageView image_view;
+        vk::ImageLayout image_layout;
+        vk::BufferView texel_buffer_view;
+
+        bool operator==(const Descriptor& other) const = default;
+    };
+
+    struct DescriptorSet {
+        vk::PipelineLayout layout;
+        std::vector<Descriptor> descriptors;
+    };
+
+    struct VertexBuffer {
+        vk::Buffer buffer;
+        vk::DeviceSize offset;
+        vk::DeviceSize size;
+        vk::DeviceSize stride;
+
+        bool operator==(const VertexBuffer& other) const = default;
+    };
+
+    struct Stats {
+        u32 emitted_bindings;
+        u32 skipped_bindings;
+    };
+
+    /// Returns true when the descriptor writes differ from the set last bound to the bind point.
+    bool UpdateDescriptorSet(vk::PipelineBindPoint bind_point, vk::PipelineLayout layout,
+                             std::span<const vk::WriteDescriptorSet> writes);
+
+    /// Returns true when the push constants differ from the ones last pushed. Push constants
+    /// are not tracked per bind point, so the layout of every push is compared.
+    bool UpdatePushConstants(vk::PipelineLayout layout, std::span<const u8> data);
+
+    /// Returns the range of vertex buffer bindings that changed as [first, last).
+    std::pair<u32, u32> UpdateVertexBuffers(std::span<const vk::Buffer> buffers,
+                                            std::span<const vk::DeviceSize> offsets,
+                                            std::span<const vk::DeviceSize> sizes,
+                                            std::span<const vk::DeviceSize> strides);
+
+    /// Returns true when the index buffer differs from the one last bound.
+    bool UpdateIndexBuffer(vk::Buffer buffer, vk::DeviceSize offset, vk::IndexType index_type);
+
+    /// Forgets every binding, so the next updates are all emitted. Must be called after binding
+    /// commands are recorded outside of this tracker.
+    void Invalidate();
+
+    /// Returns the counters gathered since the last call and resets them.
+    Stats TakeStats() {
+        return std::exchange(stats, {});
+    }
+
+private:
+    DescriptorSet& GetDescriptorSet(vk::PipelineBindPoint bind_point) {
+        return bind_point == vk::PipelineBindPoint::eCompute ? compute_set : graphics_set;
+    }
+
+    DescriptorSet graphics_set;
+    DescriptorSet compute_set;
+    std::vector<Descriptor> scratch_descriptors;
+    vk::PipelineLayout push_layout;
+    u32 push_size{};
+    std::array<u8, MaxPushConstantsSize> push_data{};
+    std::vector<VertexBuffer> vertex_buffers;
+    vk::Buffer index_buffer;
+    vk::DeviceSize index_offset{};
+    vk::IndexType index_type{};
+    Stats stats{};
+};
+
 class Scheduler {
 public:
     explicit Scheduler(const Instance& instance);
@@ -377,6 +464,11 @@ public:
         return dynamic_state;
     }
 
+    /// Returns the shadow state of the resource bindings in the current command buffer.
+    BindingState& GetBindingState() {
+        return binding_state;
+    }
+
     /// Returns the current command buffer.
     vk::CommandBuffer CommandBuffer() const {
         return current_cmdbuf;
@@ -401,6 +493,10 @@ public:
         return &master_semaphore;
     }
 
+    /// Blocks until every tick up to the provided one has been handed to the queue. Submissions
+    /// of other schedulers that wait on one of our ticks must call this first.
+    void WaitSubmitted(u64 tick);
+
     /// Defers an operation until the gpu has reached the current cpu tick.
     /// Will be run when submitting or calling PopPendingOperations.
     void DeferOperation(Common::UniqueFunction<void>&& func) {
@@ -424,13 +520,19 @@ private:
 
     void SubmitExecution(SubmitInfo& info);
 
+    /// Submits a finished command buffer to the graphics queue. Requires submit_mutex.
+    void QueueSubmit(vk::CommandBuffer cmdbuf, u64 signal_value, SubmitInfo& info);
+
     void PriorityPendingOpsThread(std::stop_token stoken);
 
+    void SubmitThread(std::stop_token stoken);
+
 private:
     const Instance& instance;
     MasterSemaphore master_semaphore;
     CommandPool command_pool;
     DynamicState dynamic_state;
+    BindingState binding_state;
     vk::CommandBuffer current_cmdbuf;
     std::condition_variable_any event_cv;
     struct PendingOp {
@@ -445,6 +547,15 @@ private:
     RenderState render_state;
     bool is_rendering = false;
     tracy::VkCtxScope* profiler_scope{};
+    struct PendingSubmit {
+        vk::CommandBuffer cmdbuf;
+        u64 signal_value;
+    };
+    std::queue<PendingSubmit> submit_queue;
+    std::mutex submit_queue_mutex;
+    std::condition_variable_any submit_queue_cv;
+    std::atomic<u64> submitted_tick{0};
+    std::jthread submit_thread;
 };
 
 } // namespace Vulkan
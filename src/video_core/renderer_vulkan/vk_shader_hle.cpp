@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <array>
+
 #include "shader_recompiler/info.h"
 #include "video_core/renderer_vulkan/vk_rasterizer.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
@@ -12,6 +14,15 @@ namespace Vulkan {
 
 static constexpr u64 COPY_SHADER_HASH = 0xfefebf9f;
 
+static constexpr vk::MemoryBarrier READ_BARRIER{
+    .srcAccessMask = vk::AccessFlagBits::eMemoryWrite,
+    .dstAccessMask = vk::AccessFlagBits::eTransferRead | vk::AccessFlagBits::eTransferWrite,
+};
+static constexpr vk::MemoryBarrier WRITE_BARRIER{
+    .srcAccessMask = vk::AccessFlagBits::eTransferWrite,
+    .dstAccessMask = vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite,
+};
+
 static bool ExecuteCopyShaderHLE(const Shader::Info& info, const AmdGpu::ComputeProgram& cs_program,
                                  Rasterizer& rasterizer) {
     auto& scheduler = rasterizer.GetScheduler();
@@ -47,14 +58,6 @@ static bool ExecuteCopyShaderHLE(const Shader::Info& info, const AmdGpu::Compute
 
     scheduler.EndRendering();
 
-    static constexpr vk::MemoryBarrier READ_BARRIER{
-        .srcAccessMask = vk::AccessFlagBits::eMemoryWrite,
-        .dstAccessMask = vk::AccessFlagBits::eTransferRead | vk::AccessFlagBits::eTransferWrite,
-    };
-    static constexpr vk::MemoryBarrier WRITE_BARRIER{
-        .srcAccessMask = vk::AccessFlagBits::eTransferWrite,
-        .dstAccessMask = vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite,
-    };
     scheduler.CommandBuffer().pipelineBarrier(
         vk::PipelineStageFlagBits::eAllCommands, vk::PipelineStageFlagBits::eTransfer,
         vk::DependencyFlagBits::eByRegion, READ_BARRIER, {}, {});
@@ -120,13 +123,177 @@ static bool ExecuteCopyShaderHLE(const Shader::Info& info, const AmdGpu::Compute
     return true;
 }
 
+/// Returns the number of dwords the threads of a linear pattern dispatch access, or zero if the
+/// dispatch does not have the shape the pattern was matched for.
+static u64 NumLinearPatternDwords(const Shader::Info& info,
+                                  const AmdGpu::ComputeProgram& cs_program) {
+    const auto& pattern = info.hle_pattern;
+    if (cs_program.dim_y != 1 || cs_program.dim_z != 1 || cs_program.start_x != 0 ||
+        cs_program.num_thread_x.full != pattern.threads_per_group ||
+        cs_program.num_thread_x.partial != 0 || cs_program.num_thread_y.full != 1 ||
+        cs_program.num_thread_z.full != 1) {
+        return 0;
+    }
+    if (pattern.narrow_ids && cs_program.dim_x >= (1U << 24)) {
+        return 0;
+    }
+    return u64{cs_program.dim_x} * pattern.threads_per_group * pattern.dwords_per_thread;
+}
+
+static bool ExecuteFillBufferHLE(const Shader::Info& info, const AmdGpu::ComputeProgram& cs_program,
+                                 Rasterizer& rasterizer) {
+    auto& scheduler = rasterizer.GetScheduler();
+    auto& buffer_cache = rasterizer.GetBufferCache();
+    const auto& pattern = info.hle_pattern;
+
+    // Writes past the end of the buffer are dropped by bounds checking.
+    const u64 num_dwords = NumLinearPatternDwords(info, cs_program);
+    const auto dst_sharp = info.buffers[pattern.dst_buffer].GetSharp(info);
+    const u64 dst_dwords = dst_sharp.GetSize() / sizeof(u32);
+    if (num_dwords == 0 || dst_sharp.base_address == 0 || dst_sharp.base_address % 4 != 0 ||
+        dst_sharp.add_tid_enable || pattern.dst_offset >= dst_dwords) {
+        return false;
+    }
+    if (pattern.value_is_user_data && pattern.value >= info.user_data.size()) {
+        return false;
+    }
+    const u32 value = pattern.value_is_user_data ? info.user_data[pattern.value] : pattern.value;
+    const u32 size = static_cast<u32>(std::min(num_dwords, dst_dwords - pattern.dst_offset) * 4);
+    const VAddr dst_address = dst_sharp.base_address + u64{pattern.dst_offset} * 4;
+
+    scheduler.EndRendering();
+    const auto [dst_buf, dst_buf_offset] = buffer_cache.ObtainBuffer(dst_address, size, true);
+    const auto cmdbuf = scheduler.CommandBuffer();
+    cmdbuf.pipelineBarrier(vk::PipelineStageFlagBits::eAllCommands,
+                           vk::PipelineStageFlagBits::eTransfer, vk::DependencyFlagBits::eByRegion,
+                           READ_BARRIER, {}, {});
+    LOG_TRACE(Render_Vulkan, "HLE buffer fill: size = {}, value = {:#x}", size, value);
+    cmdbuf.fillBuffer(dst_buf->Handle(), dst_buf_offset, size, value);
+    cmdbuf.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
+                           vk::PipelineStageFlagBits::eAllCommands,
+                           vk::DependencyFlagBits::eByRegion, WRITE_BARRIER, {}, {});
+    return true;
+}
+
+static bool ExecuteCopyBufferHLE(const Shader::Info& info, const AmdGpu::ComputeProgram& cs_program,
+                                 Rasterizer& rasterizer) {
+    auto& scheduler = rasterizer.GetScheduler();
+    auto& buffer_cache = rasterizer.GetBufferCache();
+    const auto& pattern = info.hle_pattern;
+
+    // Writes past the end of the destination are dropped, but every dword that is written must
+    // come from inside the source, as out of bounds reads return zero instead.
+    const u64 num_dwords = NumLinearPatternDwords(info, cs_program);
+    const auto src_sharp = info.buffers[pattern.src_buffer].GetSharp(info);
+    const auto dst_sharp = info.buffers[pattern.dst_buffer].GetSharp(info);
+    const u64 src_dwords = src_sharp.GetSize() / sizeof(u32);
+    const u64 dst_dwords = dst_sharp.GetSize() / sizeof(u32);
+    if (num_dwords == 0 || src_sharp.base_address == 0 || dst_sharp.base_address == 0 ||
+        src_sharp.add_tid_enable || dst_sharp.add_tid_enable || pattern.dst_offset >= dst_dwords) {
+        return false;
+    }
+    const u64 copy_dwords = std::min(num_dwords, dst_dwords - pattern.dst_offset);
+    if (pattern.src_offset + copy_dwords > src_dwords) {
+        return false;
+    }
+    const u32 size = static_cast<u32>(copy_dwords * 4);
+    const VAddr src_address = src_sharp.base_address + u64{pattern.src_offset} * 4;
+    const VAddr dst_address = dst_sharp.base_address + u64{pattern.dst_offset} * 4;
+    if (src_address < dst_address + size && dst_address < src_address + size) {
+        // Overlapping ranges depend on the order threads run in.
+        return false;
+    }
+
+    scheduler.EndRendering();
+    const auto [src_buf, src_buf_offset] = buffer_cache.ObtainBuffer(src_address, size, false);
+    const auto [dst_buf, dst_buf_offset] = buffer_cache.ObtainBuffer(dst_address, size, true);
+    const vk::BufferCopy region{
+        .srcOffset = src_buf_offset,
+        .dstOffset = dst_buf_offset,
+        .size = size,
+    };
+    const auto cmdbuf = scheduler.CommandBuffer();
+    cmdbuf.pipelineBarrier(vk::PipelineStageFlagBits::eAllCommands,
+                           vk::PipelineStageFlagBits::eTransfer, vk::DependencyFlagBits::eByRegion,
+                           READ_BARRIER, {}, {});
+    LOG_TRACE(Render_Vulkan, "HLE linear buffer copy: size = {}", size);
+    cmdbuf.copyBuffer(src_buf->Handle(), dst_buf->Handle(), region);
+    cmdbuf.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
+                           vk::PipelineStageFlagBits::eAllCommands,
+                           vk::DependencyFlagBits::eByRegion, WRITE_BARRIER, {}, {});
+    return true;
+}
+
+struct ShaderHleHandler {
+    std::string_view name;
+    bool (*matches)(const Shader::Info& info);
+    bool (*execute)(const Shader::Info& info, const AmdGpu::ComputeProgram& cs_program,
+                    Rasterizer& rasterizer);
+};
+
+// Handlers are tried in order, the first one that matches the shader executes the dispatch.
+static constexpr std::array<ShaderHleHandler, 3> SHADER_HLE_HANDLERS{{
+    {
+        .name = "CopyShader",
+        .matches = [](const Shader::Info& info) { return info.pgm_hash == COPY_SHADER_HASH; },
+        .execute = ExecuteCopyShaderHLE,
+    },
+    {
+        .name = "FillBuffer",
+        .matches =
+            [](const Shader::Info& info) {
+                return info.hle_pattern.type == Shader::Info::HlePattern::Type::FillBuffer;
+            },
+        .execute = ExecuteFillBufferHLE,
+    },
+    {
+        .name = "CopyBuffer",
+        .matches =
+            [](const Shader::Info& info) {
+                return info.hle_pattern.type == Shader::Info::HlePattern::Type::CopyBuffer;
+            },
+        .execute = ExecuteCopyBufferHLE,
+    },
+}};
+
+static std::array<ShaderHleStats, SHADER_HLE_HANDLERS.size()> shader_hle_stats{};
+
 bool ExecuteShaderHLE(const Shader::Info& info, const AmdGpu::Regs& regs,
                       const AmdGpu::ComputeProgram& cs_program, Rasterizer& rasterizer) {
-    switch (info.pgm_hash) {
-    case COPY_SHADER_HASH:
-        return ExecuteCopyShaderHLE(info, cs_program, rasterizer);
-    default:
-        return false;
+    for (u32 i = 0; i < SHADER_HLE_HANDLERS.size(); i++) {
+        const auto& handler = SHADER_HLE_HANDLERS[i];
+        if (!handler.matches(info)) {
+            continue;
+        }
+        auto& stats = shader_hle_stats[i];
+        if (!handler.execute(info, cs_program, rasterizer)) {
+            // The shader matched but this dispatch did not meet the preconditions.
+            ++stats.fallbacks;
+            return false;
+        }
+        if (stats.hits++ == 0) {
+            LOG_INFO(Render_Vulkan, "Shader HLE {} replaced dispatch of shader {:#x}", handler.name,
+                     info.pgm_hash);
+        }
+        return true;
+    }
+    return false;
+}
+
+std::vector<ShaderHleStats> GetShaderHleStats() {
+    std::vector<ShaderHleStats> stats(shader_hle_stats.begin(), shader_hle_stats.end());
+    for (u32 i = 0; i < stats.size(); i++) {
+        stats[i].name = SHADER_HLE_HANDLERS[i].name;
+    }
+    return stats;
+}
+
+void LogShaderHleStats() {
+    for (const auto& [name, hits, fallbacks] : GetShaderHleStats()) {
+        if (hits != 0 || fallbacks != 0) {
+            LOG_INFO(Render_Vulkan, "Shader HLE {}: {} dispatches replaced, {} fell back", name,
+                     hits, fallbacks);
+        }
     }
 }
 
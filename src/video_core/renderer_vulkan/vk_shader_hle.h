@@ -3,6 +3,11 @@
 
 #pragma once
 
+#include <string_view>
+#include <vector>
+
+#include "common/types.h"
+
 namespace AmdGpu {
 struct ComputeProgram;
 union Regs;
@@ -16,8 +21,21 @@ namespace Vulkan {
 
 class Rasterizer;
 
-/// Attempts to execute a shader using HLE if possible.
+struct ShaderHleStats {
+    std::string_view name;
+    u64 hits;      ///< Dispatches replaced with transfer commands
+    u64 fallbacks; ///< Dispatches of matched shaders that still had to run
+};
+
+/// Attempts to execute a shader using HLE if possible. Handlers match either a known shader hash
+/// or the transfer pattern found by the recompiler.
 bool ExecuteShaderHLE(const Shader::Info& info, const AmdGpu::Regs& regs,
                       const AmdGpu::ComputeProgram& cs_program, Rasterizer& rasterizer);
 
+/// Returns the hit counts of every HLE handler.
+std::vector<ShaderHleStats> GetShaderHleStats();
+
+/// Logs the hit counts of the handlers that matched any shader.
+void LogShaderHleStats();
+
 } // namespace Vulkan
@@ -147,6 +147,7 @@ void BlitHelper::ReinterpretColorAsMsDepth(u32 width, u32 height, u32 num_sample
 
     scheduler.EndRendering();
     scheduler.GetDynamicState().Invalidate();
+    scheduler.GetBindingState().Invalidate();
 }
 
 void BlitHelper::CopyBetweenMsImages(u32 width, u32 height, u32 num_samples,
@@ -249,6 +250,7 @@ void BlitHelper::CopyBetweenMsImages(u32 width, u32 height, u32 num_samples,
 
     scheduler.EndRendering();
     scheduler.GetDynamicState().Invalidate();
+    scheduler.GetBindingState().Invalidate();
 }
 
 void BlitHelper::CreateShaders() {
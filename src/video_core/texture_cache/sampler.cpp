@@ -2,22 +2,66 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <xxhash.h>
 #include "video_core/renderer_vulkan/liverpool_to_vk.h"
 #include "video_core/renderer_vulkan/vk_instance.h"
 #include "video_core/texture_cache/sampler.h"
 
 namespace VideoCore {
 
-Sampler::Sampler(const Vulkan::Instance& instance, const AmdGpu::Sampler& sampler,
-                 const AmdGpu::BorderColorBuffer border_color_base) {
+SamplerKey::SamplerKey(const Vulkan::Instance& instance, const AmdGpu::Sampler& sampler,
+                       AmdGpu::BorderColorBuffer border_color_base) {
     using namespace Vulkan;
-    const bool anisotropy_enable = instance.IsAnisotropicFilteringSupported() &&
-                                   (AmdGpu::IsAnisoFilter(sampler.xy_mag_filter) ||
-                                    AmdGpu::IsAnisoFilter(sampler.xy_min_filter));
-    const float max_anisotropy =
-        anisotropy_enable ? std::clamp(sampler.MaxAniso(), 1.0f, instance.MaxSamplerAnisotropy())
-                          : 1.0f;
-    auto border_color = LiverpoolToVK::BorderColor(sampler.border_color_type);
+    // Zero the whole object first, the key is hashed and compared bytewise.
+    std::memset(this, 0, sizeof(SamplerKey));
+
+    mag_filter = LiverpoolToVK::Filter(sampler.xy_mag_filter);
+    min_filter = LiverpoolToVK::Filter(sampler.xy_min_filter);
+    mipmap_mode = LiverpoolToVK::MipFilter(sampler.mip_filter);
+    address_u = LiverpoolToVK::ClampMode(sampler.clamp_x);
+    address_v = LiverpoolToVK::ClampMode(sampler.clamp_y);
+    address_w = LiverpoolToVK::ClampMode(sampler.clamp_z);
+    lod_bias = std::min(sampler.LodBias(), instance.MaxSamplerLodBias());
+    min_lod = sampler.MinLod();
+    max_lod = sampler.MaxLod();
+
+    anisotropy_enable = instance.IsAnisotropicFilteringSupported() &&
+                        (AmdGpu::IsAnisoFilter(sampler.xy_mag_filter) ||
+                         AmdGpu::IsAnisoFilter(sampler.xy_min_filter));
+    max_anisotropy = anisotropy_enable ? std::clamp(sampler.MaxAniso(), 1.0f,
+                                                    instance.MaxSamplerAnisotropy())
+                                       : 1.0f;
+
+    compare_enable = sampler.depth_compare_func != AmdGpu::DepthCompare::Never;
+    compare_op = compare_enable ? LiverpoolToVK::DepthCompare(sampler.depth_compare_func)
+                                : vk::CompareOp::eNever;
+
+    // The border color only matters when an address mode clamps to it.
+    const auto clamps_to_border = [](vk::SamplerAddressMode mode) {
+        return mode == vk::SamplerAddressMode::eClampToBorder;
+    };
+    if (!clamps_to_border(address_u) && !clamps_to_border(address_v) &&
+        !clamps_to_border(address_w)) {
+        border_color = vk::BorderColor::eFloatTransparentBlack;
+        return;
+    }
+    border_color = LiverpoolToVK::BorderColor(sampler.border_color_type);
+    if (border_color == vk::BorderColor::eFloatCustomEXT &&
+        instance.IsCustomBorderColorSupported()) {
+        // Samplers pointing at equal colors share a host sampler.
+        const auto border_color_index = sampler.border_color_ptr.Value();
+        const auto border_color_buffer = border_color_base.Address<std::array<float, 4>*>();
+        custom_border_color = border_color_buffer[border_color_index];
+    }
+}
+
+size_t SamplerKeyHash::operator()(const SamplerKey& key) const noexcept {
+    return XXH3_64bits(&key, sizeof(key));
+}
+
+Sampler::Sampler(const Vulkan::Instance& instance, const SamplerKey& key_) : key{key_} {
+    using namespace Vulkan;
+    auto border_color = key.border_color;
     if (border_color == vk::BorderColor::eFloatCustomEXT &&
         !instance.IsCustomBorderColorSupported()) {
         LOG_WARNING(Render_Vulkan, "Custom border color is not supported, falling back to black");
@@ -26,14 +70,10 @@ Sampler::Sampler(const Vulkan::Instance& instance, const AmdGpu::Sampler& sample
 
     const auto custom_color = [&]() -> std::optional<vk::SamplerCustomBorderColorCreateInfoEXT> {
         if (border_color == vk::BorderColor::eFloatCustomEXT) {
-            const auto border_color_index = sampler.border_color_ptr.Value();
-            const auto border_color_buffer = border_color_base.Address<std::array<float, 4>*>();
-            const auto custom_border_color_array = border_color_buffer[border_color_index];
-
             const vk::SamplerCustomBorderColorCreateInfoEXT ret{
                 .customBorderColor =
                     vk::ClearColorValue{
-                        .float32 = custom_border_color_array,
+                        .float32 = key.custom_border_color,
                     },
                 .format = vk::Format::eR32G32B32A32Sfloat,
             };
@@ -45,19 +85,19 @@ Sampler::Sampler(const Vulkan::Instance& instance, const AmdGpu::Sampler& sample
 
     const vk::SamplerCreateInfo sampler_ci = {
         .pNext = custom_color ? &*custom_color : nullptr,
-        .magFilter = LiverpoolToVK::Filter(sampler.xy_mag_filter),
-        .minFilter = LiverpoolToVK::Filter(sampler.xy_min_filter),
-        .mipmapMode = LiverpoolToVK::MipFilter(sampler.mip_filter),
-        .addressModeU = LiverpoolToVK::ClampMode(sampler.clamp_x),
-        .addressModeV = LiverpoolToVK::ClampMode(sampler.clamp_y),
-        .addressModeW = LiverpoolToVK::ClampMode(sampler.clamp_z),
-        .mipLodBias = std::min(sampler.LodBias(), instance.MaxSamplerLodBias()),
-        .anisotropyEnable = anisotropy_enable,
-        .maxAnisotropy = max_anisotropy,
-        .compareEnable = sampler.depth_compare_func != AmdGpu::DepthCompare::Never,
-        .compareOp = LiverpoolToVK::DepthCompare(sampler.depth_compare_func),
-        .minLod = sampler.MinLod(),
-        .maxLod = sampler.MaxLod(),
+        .magFilter = key.mag_filter,
+        .minFilter = key.min_filter,
+        .mipmapMode = key.mipmap_mode,
+        .addressModeU = key.address_u,
+        .addressModeV = key.address_v,
+        .addressModeW = key.address_w,
+        .mipLodBias = key.lod_bias,
+        .anisotropyEnable = key.anisotropy_enable != 0,
+        .maxAnisotropy = key.max_anisotropy,
+        .compareEnable = key.compare_enable != 0,
+        .compareOp = key.compare_op,
+        .minLod = key.min_lod,
+        .maxLod = key.max_lod,
         .borderColor = border_color,
         .unnormalizedCoordinates = false, // Handled in shader due to Vulkan limitations.
     };
@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <array>
+#include <cstring>
+#include "common/slot_vector.h"
 #include "video_core/amdgpu/regs_texture.h"
 #include "video_core/amdgpu/resource.h"
 #include "video_core/renderer_vulkan/vk_common.h"
@@ -13,10 +16,44 @@ class Instance;
 
 namespace VideoCore {
 
+using SamplerId = Common::SlotId;
+
+/// Host sampler state of an S# descriptor. Guest samplers that only differ in state the host
+/// sampler does not use, such as the border color of a sampler that never clamps to the border,
+/// produce equal keys.
+struct SamplerKey {
+    vk::Filter mag_filter{};
+    vk::Filter min_filter{};
+    vk::SamplerMipmapMode mipmap_mode{};
+    vk::SamplerAddressMode address_u{};
+    vk::SamplerAddressMode address_v{};
+    vk::SamplerAddressMode address_w{};
+    vk::CompareOp compare_op{};
+    vk::BorderColor border_color{};
+    u32 anisotropy_enable{};
+    u32 compare_enable{};
+    float lod_bias{};
+    float max_anisotropy{};
+    float min_lod{};
+    float max_lod{};
+    std::array<float, 4> custom_border_color{};
+
+    explicit SamplerKey(const Vulkan::Instance& instance, const AmdGpu::Sampler& sampler,
+                        AmdGpu::BorderColorBuffer border_color_base);
+
+    bool operator==(const SamplerKey& other) const noexcept {
+        return std::memcmp(this, &other, sizeof(SamplerKey)) == 0;
+    }
+};
+static_assert(sizeof(SamplerKey) == 18 * sizeof(u32), "SamplerKey is hashed and compared bytewise");
+
+struct SamplerKeyHash {
+    size_t operator()(const SamplerKey& key) const noexcept;
+};
+
 class Sampler {
 public:
-    explicit Sampler(const Vulkan::Instance& instance, const AmdGpu::Sampler& sampler,
-                     const AmdGpu::BorderColorBuffer border_color_base);
+    explicit Sampler(const Vulkan::Instance& instance, const SamplerKey& key);
     ~Sampler();
 
     Sampler(const Sampler&) = delete;
@@ -29,6 +66,9 @@ public:
         return *handle;
     }
 
+    SamplerKey key;
+    u64 last_use_tick{};
+
 private:
     vk::UniqueSampler handle;
 };
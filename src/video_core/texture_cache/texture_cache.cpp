@@ -26,7 +26,9 @@ TextureCache::TextureCache(const Vulkan::Instance& instance_, Vulkan::Scheduler&
                            PageManager& tracker_)
     : instance{instance_}, scheduler{scheduler_}, liverpool{liverpool_},
       buffer_cache{buffer_cache_}, tracker{tracker_}, blit_helper{instance, scheduler},
-      tile_manager{instance, scheduler, buffer_cache.GetUtilityBuffer(MemoryUsage::Stream)} {
+      tile_manager{instance, scheduler, buffer_cache.GetUtilityBuffer(MemoryUsage::Stream)},
+      max_samplers{
+          std::min<size_t>(MAX_CACHED_SAMPLERS, instance.MaxSamplerAllocationCount() / 2)} {
     // Create basic null image at fixed image ID.
     const auto null_id = GetNullImage(vk::Format::eR8G8B8A8Unorm);
     ASSERT(null_id.index == NULL_IMAGE_ID.index);
@@ -704,9 +706,65 @@ void TextureCache::RefreshImage(Image& image) {
 
 vk::Sampler TextureCache::GetSampler(const AmdGpu::Sampler& sampler,
                                      AmdGpu::BorderColorBuffer border_color_base) {
-    const u64 hash = XXH3_64bits(&sampler, sizeof(sampler));
-    const auto [it, new_sampler] = samplers.try_emplace(hash, instance, sampler, border_color_base);
-    return it->second.Handle();
+    // Most draws bind the same few descriptors, so check those before building a key. Custom
+    // border colors are read from memory and may change under an identical descriptor.
+    const bool use_recent = sampler.border_color_type != AmdGpu::BorderColor::Custom;
+    SamplerId sampler_id{};
+    if (use_recent) {
+        const auto it = std::ranges::find_if(recent_samplers, [&](const RecentSampler& recent) {
+            return recent.sampler_id && recent.sampler == sampler;
+        });
+        if (it != recent_samplers.end()) {
+            ++sampler_stats.recent_hits;
+            sampler_id = it->sampler_id;
+        }
+    }
+    if (!sampler_id) {
+        const SamplerKey key{instance, sampler, border_color_base};
+        if (const auto it = samplers.find(key); it != samplers.end()) {
+            ++sampler_stats.key_hits;
+            sampler_id = it->second;
+        } else {
+            if (samplers.size() >= max_samplers) {
+                EvictSamplers();
+            }
+            sampler_id = slot_samplers.insert(instance, key);
+            samplers.emplace(key, sampler_id);
+            ++sampler_stats.created;
+        }
+        if (use_recent) {
+            recent_samplers[recent_sampler_cursor] = {sampler, sampler_id};
+            recent_sampler_cursor = (recent_sampler_cursor + 1) % recent_samplers.size();
+        }
+    }
+    Sampler& cached = slot_samplers[sampler_id];
+    cached.last_use_tick = scheduler.CurrentTick();
+    return cached.Handle();
+}
+
+void TextureCache::EvictSamplers() {
+    std::vector<std::pair<u64, SamplerId>> candidates;
+    candidates.reserve(samplers.size());
+    for (const auto& [key, sampler_id] : samplers) {
+        const u64 tick = slot_samplers[sampler_id].last_use_tick;
+        if (scheduler.IsFree(tick)) {
+            candidates.emplace_back(tick, sampler_id);
+        }
+    }
+    const size_t num_evict = std::min(candidates.size(), std::max<size_t>(max_samplers / 4, 1));
+    if (num_evict == 0) {
+        LOG_WARNING(Render_Vulkan, "Sampler cache is full with {} samplers in flight",
+                    samplers.size());
+        return;
+    }
+    std::ranges::nth_element(candidates, candidates.begin() + (num_evict - 1));
+    for (size_t i = 0; i < num_evict; i++) {
+        const SamplerId sampler_id = candidates[i].second;
+        samplers.erase(slot_samplers[sampler_id].key);
+        slot_samplers.erase(sampler_id);
+    }
+    sampler_stats.evicted += num_evict;
+    recent_samplers.fill({});
 }
 
 void TextureCache::RegisterImage(ImageId image_id) {
@@ -35,6 +35,8 @@ class TextureCache {
     static constexpr s64 DEFAULT_PRESSURE_GC_MEMORY = 1_GB + 512_MB;
     static constexpr s64 DEFAULT_CRITICAL_GC_MEMORY = 3_GB;
     static constexpr s64 TARGET_GC_THRESHOLD = 8_GB;
+    // Upper bound of cached samplers, further limited to half of the device limit
+    static constexpr size_t MAX_CACHED_SAMPLERS = 2048;
 
     using ImageIds = boost::container::small_vector<ImageId, 16>;
 
@@ -46,7 +48,19 @@ class TextureCache {
     };
     using PageTable = MultiLevelPageTable<Traits>;
 
+    struct RecentSampler {
+        AmdGpu::Sampler sampler;
+        SamplerId sampler_id;
+    };
+
 public:
+    struct SamplerStats {
+        u64 recent_hits;
+        u64 key_hits;
+        u64 created;
+        u64 evicted;
+    };
+
     enum class BindingType : u32 {
         Texture,
         Storage,
@@ -140,6 +154,11 @@ public:
     [[nodiscard]] vk::Sampler GetSampler(const AmdGpu::Sampler& sampler,
                                          AmdGpu::BorderColorBuffer border_color_base);
 
+    /// Returns the sampler cache reuse counters.
+    [[nodiscard]] const SamplerStats& GetSamplerStats() const noexcept {
+        return sampler_stats;
+    }
+
     /// Retrieves the image with the specified id.
     [[nodiscard]] Image& GetImage(ImageId id) {
         auto& image = slot_images[id];
@@ -287,6 +306,9 @@ private:
     /// Touch the image in the LRU cache.
     void TouchImage(const Image& image);
 
+    /// Destroys the least recently used samplers the GPU is done with.
+    void EvictSamplers();
+
     void FreeImage(ImageId image_id) {
         UntrackImage(image_id);
         UnregisterImage(image_id);
@@ -303,7 +325,12 @@ private:
     TileManager tile_manager;
     Common::SlotVector<Image> slot_images;
     Common::SlotVector<ImageView> slot_image_views;
-    tsl::robin_map<u64, Sampler> samplers;
+    Common::SlotVector<Sampler> slot_samplers;
+    tsl::robin_map<SamplerKey, SamplerId, SamplerKeyHash> samplers;
+    std::array<RecentSampler, 8> recent_samplers{};
+    u32 recent_sampler_cursor{};
+    size_t max_samplers{};
+    SamplerStats sampler_stats{};
     tsl::robin_map<vk::Format, ImageId> null_images;
     std::unordered_set<ImageId> download_images;
     u64 total_used_memory = 0;